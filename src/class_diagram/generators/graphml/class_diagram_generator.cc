@@ -24,6 +24,7 @@ namespace clanguml::class_diagram::generators::graphml {
 
 using clanguml::common::to_string;
 using clanguml::common::generators::display_name_adapter;
+using clanguml::common::model::element_cast;
 
 generator::generator(diagram_config &config, diagram_model &model)
     : common_generator<diagram_config, diagram_model>{config, model}
@@ -43,7 +44,7 @@ generator::node_property_names() const
 void generator::generate_top_level_elements(graphml_node_t &parent) const
 {
     for (const auto &p : model()) {
-        if (auto *pkg = dynamic_cast<package *>(p.get()); pkg) {
+        if (auto *pkg = element_cast<package>(p.get()); pkg) {
             if (!pkg->is_empty())
                 generate(*pkg, parent);
         }
@@ -76,8 +77,8 @@ void generator::generate(const package &p, graphml_node_t &parent) const
     }
 
     for (const auto &subpackage : p) {
-        if (dynamic_cast<package *>(subpackage.get()) != nullptr) {
-            const auto &sp = dynamic_cast<package &>(*subpackage);
+        if (element_cast<package>(subpackage.get()) != nullptr) {
+            const auto &sp = static_cast<const package &>(*subpackage);
             if (!sp.is_empty()) {
                 if (config().generate_packages()) {
                     generate(sp, graph_node);
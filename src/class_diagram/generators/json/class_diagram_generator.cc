@@ -175,6 +175,7 @@ void to_json(nlohmann::json &j, const concept_ &c)
 
 namespace clanguml::class_diagram::generators::json {
 using clanguml::common::generators::display_name_adapter;
+using clanguml::common::model::element_cast;
 
 generator::generator(diagram_config &config, diagram_model &model)
     : common_generator<diagram_config, diagram_model>{config, model}
@@ -202,7 +203,7 @@ void generator::generate_diagram(nlohmann::json &parent) const
 void generator::generate_top_level_elements(nlohmann::json &parent) const
 {
     for (const auto &p : model()) {
-        if (auto *pkg = dynamic_cast<package *>(p.get()); pkg) {
+        if (auto *pkg = element_cast<package>(p.get()); pkg) {
             if (!pkg->is_empty())
                 generate(*pkg, parent);
         }
@@ -233,8 +234,8 @@ void generator::generate(const package &p, nlohmann::json &parent) const
     }
 
     for (const auto &subpackage : p) {
-        if (dynamic_cast<package *>(subpackage.get()) != nullptr) {
-            const auto &sp = dynamic_cast<package &>(*subpackage);
+        if (element_cast<package>(subpackage.get()) != nullptr) {
+            const auto &sp = static_cast<const package &>(*subpackage);
             if (!sp.is_empty()) {
                 if (config().generate_packages())
                     generate(sp, package_object);
@@ -320,7 +321,7 @@ void generator::generate(const objc_interface &c, nlohmann::json &parent) const
 void generator::generate_relationships(nlohmann::json &parent) const
 {
     for (const auto &p : model()) {
-        if (auto *pkg = dynamic_cast<package *>(p.get()); pkg) {
+        if (auto *pkg = element_cast<package>(p.get()); pkg) {
             generate_relationships(*pkg, parent);
         }
         else {
@@ -335,8 +336,8 @@ void generator::generate_relationships<package>(
     const package &p, nlohmann::json &parent) const
 {
     for (const auto &subpackage : p) {
-        if (dynamic_cast<package *>(subpackage.get()) != nullptr) {
-            const auto &sp = dynamic_cast<package &>(*subpackage);
+        if (element_cast<package>(subpackage.get()) != nullptr) {
+            const auto &sp = static_cast<const package &>(*subpackage);
             if (!sp.is_empty())
                 generate_relationships(sp, parent);
         }
@@ -35,6 +35,7 @@ namespace clanguml::class_diagram::generators {
 using diagram_config = clanguml::config::class_diagram;
 using diagram_model = clanguml::class_diagram::model::diagram;
 
+using clanguml::common::model::element_cast;
 using clanguml::common::model::package;
 
 /**
@@ -56,9 +57,9 @@ public:
         generator_.start_package(p, ostr);
 
         for (const auto &subpackage : p) {
-            if (dynamic_cast<package *>(subpackage.get()) != nullptr) {
+            if (element_cast<package>(subpackage.get()) != nullptr) {
                 // TODO: add option - generate_empty_packages
-                const auto &sp = dynamic_cast<package &>(*subpackage);
+                const auto &sp = static_cast<const package &>(*subpackage);
                 if (!sp.is_empty()) {
                     together_group_stack_.enter();
 
@@ -95,7 +96,7 @@ public:
     void generate_top_level_elements(std::ostream &ostr) const
     {
         for (const auto &p : generator_.model()) {
-            if (auto *pkg = dynamic_cast<package *>(p.get()); pkg) {
+            if (auto *pkg = element_cast<package>(p.get()); pkg) {
                 if (!pkg->is_empty())
                     generate(*pkg, ostr);
             }
@@ -120,11 +121,11 @@ public:
     void generate_relationships(const package &p, std::ostream &ostr) const
     {
         for (const auto &subpackage : p) {
-            if (dynamic_cast<package *>(subpackage.get()) != nullptr) {
+            if (element_cast<package>(subpackage.get()) != nullptr) {
                 // TODO: add option - generate_empty_packages, currently
                 //       packages which do not contain anything but other
                 //       packages are skipped
-                const auto &sp = dynamic_cast<package &>(*subpackage);
+                const auto &sp = static_cast<const package &>(*subpackage);
                 if (!sp.is_empty())
                     generate_relationships(sp, ostr);
             }
@@ -142,7 +143,7 @@ public:
     void generate_relationships(std::ostream &ostr) const
     {
         for (const auto &p : generator_.model()) {
-            if (auto *pkg = dynamic_cast<package *>(p.get()); pkg) {
+            if (auto *pkg = element_cast<package>(p.get()); pkg) {
                 generate_relationships(*pkg, ostr);
             }
             else {
@@ -57,6 +57,16 @@ public:
      */
     std::string type_name() const override { return "class"; }
 
+    common::model::element_kind_t kind() const override
+    {
+        return common::model::element_kind_t::kClass;
+    }
+
+    static bool is_kind(common::model::element_kind_t kind)
+    {
+        return kind == common::model::element_kind_t::kClass;
+    }
+
     /**
      * Whether or not the class was declared in the code as 'struct'.
      *
@@ -49,6 +49,16 @@ public:
      */
     std::string type_name() const override { return "concept"; }
 
+    common::model::element_kind_t kind() const override
+    {
+        return common::model::element_kind_t::kConcept;
+    }
+
+    static bool is_kind(common::model::element_kind_t kind)
+    {
+        return kind == common::model::element_kind_t::kConcept;
+    }
+
     friend bool operator==(const concept_ &l, const concept_ &r);
 
     std::string full_name_no_ns() const override;
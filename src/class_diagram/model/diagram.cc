@@ -245,12 +245,12 @@ void diagram::remove_redundant_dependencies()
         for (const auto &el : elements_view) {
             std::set<eid_t> dependency_relationships_to_remove;
 
-            for (auto &r : el.get().relationships()) {
+            for (const auto &r : el.get().relationships()) {
                 if (r.type() != relationship_t::kDependency)
                     dependency_relationships_to_remove.emplace(r.destination());
             }
 
-            util::erase_if(el.get().relationships(),
+            el.get().remove_relationships_if(
                 [&dependency_relationships_to_remove, &el](const auto &r) {
                     if (r.type() != relationship_t::kDependency)
                         return false;
@@ -297,6 +297,90 @@ bool diagram::is_empty() const
         element_view<enum_>::is_empty() && element_view<concept_>::is_empty() &&
         element_view<objc_interface>::is_empty();
 }
+
+namespace {
+void add_parameters(common::model::memory_usage &usage,
+    const std::vector<method_parameter> &parameters)
+{
+    usage.elements += parameters.capacity() * sizeof(method_parameter);
+    for (const auto &p : parameters) {
+        usage.add_string(p.name());
+        usage.add_string(p.type());
+        usage.add_string(p.default_value());
+        usage.add_comment(p.comment());
+    }
+}
+
+template <typename T>
+void add_class_elements(
+    common::model::memory_usage &usage, const std::vector<T> &elements)
+{
+    using common::model::source_location;
+
+    usage.element_count += elements.size();
+    usage.elements +=
+        elements.capacity() * (sizeof(T) - sizeof(source_location));
+    usage.source_locations += elements.capacity() * sizeof(source_location);
+
+    for (const auto &e : elements) {
+        usage.add_string(e.name());
+        usage.add_string(e.type());
+        usage.add_comment(e.comment());
+
+        if constexpr (std::is_base_of_v<class_method_base, T>)
+            add_parameters(usage, e.parameters());
+
+        if constexpr (std::is_base_of_v<common::model::template_trait, T>)
+            usage.add_template_params(e.template_params());
+    }
+}
+
+void add_packages(common::model::memory_usage &usage,
+    const common::model::nested_trait<common::model::element,
+        common::model::namespace_> &parent)
+{
+    for (auto it = parent.cbegin(); it != parent.cend(); ++it) {
+        const auto *p = common::model::element_cast<common::model::package>(
+            it->get());
+        if (p == nullptr)
+            continue;
+
+        usage.add_element(*p, sizeof(common::model::package));
+
+        add_packages(usage, *p);
+    }
+}
+} // namespace
+
+void diagram::estimate_memory_usage(common::model::memory_usage &usage) const
+{
+    for (const auto &c : classes()) {
+        usage.add_element(c.get(), sizeof(class_));
+        usage.add_template_params(c.get().template_params());
+        add_class_elements(usage, c.get().members());
+        add_class_elements(usage, c.get().methods());
+    }
+
+    for (const auto &e : enums()) {
+        usage.add_element(e.get(), sizeof(enum_));
+        usage.add_strings(e.get().constants());
+    }
+
+    for (const auto &c : concepts()) {
+        usage.add_element(c.get(), sizeof(concept_));
+        usage.add_template_params(c.get().template_params());
+        add_parameters(usage, c.get().requires_parameters());
+        usage.add_strings(c.get().requires_statements());
+    }
+
+    for (const auto &i : objc_interfaces()) {
+        usage.add_element(i.get(), sizeof(objc_interface));
+        add_class_elements(usage, i.get().members());
+        add_class_elements(usage, i.get().methods());
+    }
+
+    add_packages(usage, *this);
+}
 } // namespace clanguml::class_diagram::model
 
 namespace clanguml::common::model {
@@ -256,6 +256,14 @@ public:
 
     void apply_filter() override;
 
+    /**
+     * @brief Estimate memory used by the diagram model
+     *
+     * @param usage Memory usage to which the diagram model is added
+     */
+    void estimate_memory_usage(
+        common::model::memory_usage &usage) const override;
+
 private:
     template <typename ElementT>
     bool add_with_namespace_path(std::unique_ptr<ElementT> &&e);
@@ -335,25 +343,43 @@ bool diagram::add_with_module_path(
     const auto element_type = e->type_name();
 
     // Make sure all parent modules are already packages in the
-    // model
+    // model, walking the parent path only once
+    nested_trait_ns *parent{this};
+    common::model::element *parent_element{nullptr};
     for (auto it = parent_path.begin(); it != parent_path.end(); it++) {
-        auto pkg = std::make_unique<common::model::package>(
-            e->using_namespace(), parent_path.type());
-        pkg->set_name(*it);
-        auto ns =
-            common::model::path(parent_path.begin(), it, parent_path.type());
-        // ns.pop_back();
-        pkg->set_namespace(ns);
-        pkg->set_id(common::to_id(pkg->full_name(false)));
-
-        add(ns, std::move(pkg));
+        auto [nested, nested_element] = parent->get_nested(*it, false);
+
+        if (nested == nullptr) {
+            auto pkg = std::make_unique<common::model::package>(
+                e->using_namespace(), parent_path.type());
+            pkg->set_name(*it);
+            auto ns = common::model::path(
+                parent_path.begin(), it, parent_path.type());
+            pkg->set_namespace(ns);
+            pkg->set_id(common::to_id(pkg->full_name(false)));
+            if (parent_element != nullptr)
+                pkg->set_parent_element_id(parent_element->id());
+
+            auto &pkg_ref = *pkg;
+            if (!parent->add_element(std::move(pkg)))
+                return false;
+
+            nested = &pkg_ref;
+            nested_element = &pkg_ref;
+        }
+
+        parent = nested;
+        parent_element = nested_element;
     }
 
     const auto base_name = e->name();
     const auto full_name = e->full_name(false);
     auto &e_ref = *e;
 
-    if (add_element(parent_path, std::move(e))) {
+    if (parent_element != nullptr)
+        e->set_parent_element_id(parent_element->id());
+
+    if (parent->add_element(std::move(e))) {
         element_view<ElementT>::add(std::ref(e_ref));
         return true;
     }
@@ -368,25 +394,43 @@ bool diagram::add_with_filesystem_path(
     const auto element_type = e->type_name();
 
     // Make sure all parent modules are already packages in the
-    // model
+    // model, walking the parent path only once
+    nested_trait_ns *parent{this};
+    common::model::element *parent_element{nullptr};
     for (auto it = parent_path.begin(); it != parent_path.end(); it++) {
-        auto pkg = std::make_unique<common::model::package>(
-            e->using_namespace(), parent_path.type());
-        pkg->set_name(*it);
-        auto ns =
-            common::model::path(parent_path.begin(), it, parent_path.type());
-        // ns.pop_back();
-        pkg->set_namespace(ns);
-        pkg->set_id(common::to_id(pkg->full_name(false)));
-
-        add(ns, std::move(pkg));
+        auto [nested, nested_element] = parent->get_nested(*it, false);
+
+        if (nested == nullptr) {
+            auto pkg = std::make_unique<common::model::package>(
+                e->using_namespace(), parent_path.type());
+            pkg->set_name(*it);
+            auto ns = common::model::path(
+                parent_path.begin(), it, parent_path.type());
+            pkg->set_namespace(ns);
+            pkg->set_id(common::to_id(pkg->full_name(false)));
+            if (parent_element != nullptr)
+                pkg->set_parent_element_id(parent_element->id());
+
+            auto &pkg_ref = *pkg;
+            if (!parent->add_element(std::move(pkg)))
+                return false;
+
+            nested = &pkg_ref;
+            nested_element = &pkg_ref;
+        }
+
+        parent = nested;
+        parent_element = nested_element;
     }
 
     const auto base_name = e->name();
     const auto full_name = e->full_name(false);
     auto &e_ref = *e;
 
-    if (add_element(parent_path, std::move(e))) {
+    if (parent_element != nullptr)
+        e->set_parent_element_id(parent_element->id());
+
+    if (parent->add_element(std::move(e))) {
         element_view<ElementT>::add(std::ref(e_ref));
         return true;
     }
@@ -39,6 +39,16 @@ public:
 
     std::string type_name() const override { return "enum"; }
 
+    common::model::element_kind_t kind() const override
+    {
+        return common::model::element_kind_t::kEnum;
+    }
+
+    static bool is_kind(common::model::element_kind_t kind)
+    {
+        return kind == common::model::element_kind_t::kEnum;
+    }
+
     friend bool operator==(const enum_ &l, const enum_ &r);
 
     /**
@@ -51,6 +51,16 @@ public:
         return "objc_interface";
     }
 
+    common::model::element_kind_t kind() const override
+    {
+        return common::model::element_kind_t::kObjCInterface;
+    }
+
+    static bool is_kind(common::model::element_kind_t kind)
+    {
+        return kind == common::model::element_kind_t::kObjCInterface;
+    }
+
     friend bool operator==(const objc_interface &l, const objc_interface &r);
 
     void add_member(objc_member &&member);
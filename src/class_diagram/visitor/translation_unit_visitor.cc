@@ -42,6 +42,14 @@ std::unique_ptr<class_> translation_unit_visitor::create_element(
     return cls;
 }
 
+bool translation_unit_visitor::TraverseDecl(clang::Decl *decl)
+{
+    if (should_skip_traversal(decl))
+        return true;
+
+    return RecursiveASTVisitor<translation_unit_visitor>::TraverseDecl(decl);
+}
+
 bool translation_unit_visitor::VisitNamespaceDecl(clang::NamespaceDecl *ns)
 {
     assert(ns != nullptr);
@@ -2479,8 +2487,11 @@ void translation_unit_visitor::resolve_local_to_global_ids()
 {
     diagram().for_all_elements([&](auto &element_view) {
         for (const auto &el : element_view) {
-            for (auto &rel : el.get().relationships()) {
-                if (!rel.destination().is_global()) {
+            el.get().resolve_relationship_destinations(
+                [this](const auto &rel) -> std::optional<eid_t> {
+                    if (rel.destination().is_global())
+                        return {};
+
                     const auto maybe_id =
                         id_mapper().get_global_id(rel.destination());
                     if (maybe_id) {
@@ -2488,11 +2499,10 @@ void translation_unit_visitor::resolve_local_to_global_ids()
                             "= Resolved instantiation destination from local "
                             "id {} to global id {}",
                             rel.destination(), *maybe_id);
-                        rel.set_destination(*maybe_id);
                     }
-                }
-            }
-            el.get().remove_duplicate_relationships();
+
+                    return maybe_id;
+                });
         }
     });
 }
@@ -99,6 +99,8 @@ public:
 
     bool shouldVisitImplicitCode() const { return false; }
 
+    virtual bool TraverseDecl(clang::Decl *decl);
+
     virtual bool VisitNamespaceDecl(clang::NamespaceDecl *ns);
 
     virtual bool VisitRecordDecl(clang::RecordDecl *D);
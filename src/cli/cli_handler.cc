@@ -17,6 +17,7 @@
  */
 #include "cli_handler.h"
 
+#include "util/trace.h"
 #include "util/util.h"
 #include "version/version.h"
 
@@ -178,6 +179,36 @@ cli_flow_t cli_handler::parse(int argc, const char **argv)
     app.add_option("--mermaid-cmd", mermaid_cmd,
         "Command template to render MermaidJS diagram, `{}` will be replaced "
         "with diagram name.");
+    app.add_option("--plantuml-batch-cmd", plantuml_batch_cmd,
+        "Command template to render multiple PlantUML diagrams at once, `{}` "
+        "will be replaced with the list of diagram file paths.");
+    app.add_option("--mermaid-batch-cmd", mermaid_batch_cmd,
+        "Command template to render multiple MermaidJS diagrams at once, `{}` "
+        "will be replaced with the list of diagram file paths.");
+    app.add_option("--render-jobs", render_jobs,
+        "Maximum number of renderer processes running in parallel (defaults "
+        "to thread count)");
+    app.add_option("--render-batch-size", render_batch_size,
+        "Maximum number of diagrams rendered by a single batch command "
+        "(0 means no limit)");
+    app.add_option("--file-cache-limit", file_cache_limit,
+        "Maximum size in MiB of source file contents cached in memory and "
+        "shared by all diagrams (0 disables caching of file contents)");
+    app.add_option("--memory-limit", memory_limit,
+        "Maximum memory usage in MiB - translation units are parsed only "
+        "while their expected memory usage fits in the limit (Linux only)");
+    app.add_option("--trace-output", trace_output,
+        "Write timeline of the run in Chrome trace event format to the "
+        "specified file");
+    app.add_flag("--memory-report", memory_report,
+        "Print estimated memory usage of each diagram model and resident set "
+        "size after each generation phase");
+    app.add_flag("--precompiled-preambles", precompiled_preambles,
+        "Share precompiled preambles between translation units with the same "
+        "compile flags and leading includes");
+    app.add_option("--preamble-dir", preamble_directory,
+        "Directory where precompiled preambles are stored (by default they "
+        "are kept in memory)");
     app.add_option(
            "--user-data",
            [this](CLI::results_t vals) {
@@ -234,6 +265,9 @@ cli_flow_t cli_handler::handle_options(int argc, const char **argv)
 
     setup_logging();
 
+    if (trace_output)
+        util::tracer::instance().enable(*trace_output);
+
     res = handle_pre_config_options();
 
     if (res != cli_flow_t::kContinue)
@@ -288,6 +322,15 @@ cli_flow_t cli_handler::handle_pre_config_options()
         }
     }
 
+#if LLVM_VERSION_MAJOR < 17
+    if (!preamble_directory.empty()) {
+        LOG_ERROR("ERROR: '--preamble-dir' requires clang-uml built with "
+                  "LLVM 17 or later");
+
+        return cli_flow_t::kError;
+    }
+#endif
+
     if (initialize) {
         return create_config_file();
     }
@@ -323,6 +366,8 @@ cli_flow_t cli_handler::handle_pre_config_options()
 
 cli_flow_t cli_handler::load_config()
 {
+    const util::trace_span span{"config", "load config"};
+
     try {
         config = clanguml::config::load(config_path, false,
             paths_relative_to_pwd, no_metadata, !no_validate);
@@ -442,6 +487,20 @@ cli_flow_t cli_handler::handle_post_config_options()
         config.mermaid().cmd = mermaid_cmd.value();
     }
 
+    if (plantuml_batch_cmd) {
+        if (!config.puml)
+            config.puml.set({});
+
+        config.puml().batch_cmd = plantuml_batch_cmd.value();
+    }
+
+    if (mermaid_batch_cmd) {
+        if (!config.mermaid)
+            config.mermaid.set({});
+
+        config.mermaid().batch_cmd = mermaid_batch_cmd.value();
+    }
+
 #if !defined(_WIN32)
     if (query_driver) {
         config.query_driver.set(*query_driver);
@@ -461,6 +520,13 @@ runtime_config cli_handler::get_runtime_config() const
     cfg.progress = progress;
     cfg.thread_count = thread_count;
     cfg.render_diagrams = render_diagrams;
+    cfg.render_jobs = render_jobs;
+    cfg.render_batch_size = render_batch_size;
+    cfg.file_cache_limit = file_cache_limit;
+    cfg.memory_limit = memory_limit;
+    cfg.memory_report = memory_report;
+    cfg.precompiled_preambles = precompiled_preambles;
+    cfg.preamble_directory = preamble_directory;
     cfg.output_directory = effective_output_directory;
 
     return cfg;
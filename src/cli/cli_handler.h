@@ -39,6 +39,13 @@ struct runtime_config {
     bool progress{};
     unsigned int thread_count{};
     bool render_diagrams{};
+    unsigned int render_jobs{};
+    unsigned int render_batch_size{};
+    std::optional<unsigned int> file_cache_limit{};
+    std::optional<unsigned int> memory_limit{};
+    bool memory_report{};
+    bool precompiled_preambles{};
+    std::string preamble_directory{};
     std::string output_directory{};
 };
 
@@ -222,6 +229,16 @@ public:
     bool render_diagrams{false};
     std::optional<std::string> plantuml_cmd;
     std::optional<std::string> mermaid_cmd;
+    std::optional<std::string> plantuml_batch_cmd;
+    std::optional<std::string> mermaid_batch_cmd;
+    unsigned int render_jobs{};
+    unsigned int render_batch_size{};
+    std::optional<unsigned int> file_cache_limit;
+    std::optional<unsigned int> memory_limit;
+    std::optional<std::string> trace_output;
+    bool memory_report{false};
+    bool precompiled_preambles{false};
+    std::string preamble_directory;
 
     clanguml::config::config config;
 
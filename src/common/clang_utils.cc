@@ -17,6 +17,7 @@
  */
 
 #include "clang_utils.h"
+#include "util/hash.h"
 
 #include <clang/Lex/Preprocessor.h>
 
@@ -102,7 +103,56 @@ model::namespace_ get_template_namespace(const clang::TemplateDecl &declaration)
     return ns;
 }
 
-std::string get_tag_name(const clang::TagDecl &declaration)
+namespace {
+thread_local printing_cache *current_printing_cache{nullptr};
+} // namespace
+
+printing_cache::scope::scope(
+    printing_cache &cache, const clang::ASTContext &ctx)
+    : cache_{cache}
+    , previous_{current_printing_cache}
+{
+    cache_.ast_context_ = &ctx;
+    current_printing_cache = &cache_;
+}
+
+printing_cache::scope::~scope()
+{
+    cache_.clear();
+    current_printing_cache = previous_;
+}
+
+printing_cache *printing_cache::current(const clang::ASTContext &ctx)
+{
+    if (current_printing_cache == nullptr ||
+        current_printing_cache->ast_context_ != &ctx)
+        return nullptr;
+
+    return current_printing_cache;
+}
+
+void printing_cache::clear()
+{
+    const auto total = hits_ + misses_;
+    LOG_TRACE("Printing cache: {} hits, {} misses ({:.1f}% hit rate)", hits_,
+        misses_,
+        total == 0 ? 0.0
+                   : 100.0 * static_cast<double>(hits_) /
+                static_cast<double>(total));
+
+    for (auto &names : type_names_)
+        names.clear();
+    qualified_names_.clear();
+    tag_qualified_names_.clear();
+    tag_names_.clear();
+
+    hits_ = 0;
+    misses_ = 0;
+    ast_context_ = nullptr;
+}
+
+namespace {
+std::string print_tag_name(const clang::TagDecl &declaration)
 {
     auto base_name = declaration.getNameAsString();
 
@@ -134,6 +184,21 @@ std::string get_tag_name(const clang::TagDecl &declaration)
     return base_name;
 }
 
+std::string print_type(const clang::QualType &type,
+    const clang::ASTContext &ctx, bool try_canonical);
+} // namespace
+
+std::string get_tag_name(const clang::TagDecl &declaration)
+{
+    if (auto *cache = printing_cache::current(declaration.getASTContext());
+        cache != nullptr) {
+        return cache->tag_name(&declaration,
+            [&declaration] { return print_tag_name(declaration); });
+    }
+
+    return print_tag_name(declaration);
+}
+
 std::string to_string(const clang::ArrayType &array_type,
     const clang::ASTContext &ctx, bool try_canonical,
     std::vector<std::string> &dimensions)
@@ -180,6 +245,18 @@ std::string to_string(
 
 std::string to_string(const clang::QualType &type, const clang::ASTContext &ctx,
     bool try_canonical)
+{
+    if (auto *cache = printing_cache::current(ctx); cache != nullptr) {
+        return cache->type_name(type, try_canonical,
+            [&] { return print_type(type, ctx, try_canonical); });
+    }
+
+    return print_type(type, ctx, try_canonical);
+}
+
+namespace {
+std::string print_type(const clang::QualType &type,
+    const clang::ASTContext &ctx, bool try_canonical)
 {
     if (type->isArrayType()) {
         std::vector<std::string> dimensions;
@@ -261,6 +338,7 @@ std::string to_string(const clang::QualType &type, const clang::ASTContext &ctx,
 
     return result;
 }
+} // namespace
 
 std::string to_string(const clang::RecordType &type,
     const clang::ASTContext &ctx, bool try_canonical)
@@ -459,8 +537,27 @@ bool is_subexpr_of(const clang::Stmt *parent_stmt, const clang::Stmt *sub_stmt)
 
 template <> eid_t to_id(const std::string &full_name)
 {
-    return static_cast<eid_t>(
-        static_cast<uint64_t>(std::hash<std::string>{}(full_name)));
+    return static_cast<eid_t>(util::hash64::of(full_name));
+}
+
+template <> eid_t to_id(const common::model::path &path)
+{
+    // Module paths are additionally normalized in to_string()
+    if (path.type() == common::model::path_type::kModule)
+        return to_id(path.to_string());
+
+    // Hash the path segments directly, the result is the same as hashing
+    // the string returned by path::to_string()
+    const std::string_view separator{path.separator()};
+
+    util::hash64 hash;
+    for (auto it = path.begin(); it != path.end(); it++) {
+        if (it != path.begin())
+            hash.update(separator);
+        hash.update(*it);
+    }
+
+    return static_cast<eid_t>(hash.digest());
 }
 
 eid_t to_id(const clang::QualType &type, const clang::ASTContext &ctx)
@@ -1074,13 +1171,83 @@ std::optional<size_t> get_array_size(const clang::ArrayType &type)
     return {};
 }
 
+namespace {
+source_paths_cache::entry resolve_source_paths(
+    const std::string &file, const std::filesystem::path &relative_to_path)
+{
+    namespace fs = std::filesystem;
+
+    // ensure the path is absolute
+    fs::path file_path{file};
+    if (!file_path.is_absolute()) {
+        file_path = fs::absolute(file_path);
+    }
+
+    file_path = file_path.lexically_normal();
+
+    source_paths_cache::entry result;
+    result.file = util::interned_string{file_path.string()};
+
+    if (util::is_relative_to(file_path, relative_to_path)) {
+        result.file_relative = util::interned_string{util::path_to_url(
+            file_path.lexically_relative(relative_to_path))};
+    }
+
+    return result;
+}
+
+/**
+ * @brief Find the file included by the unity translation unit, from which
+ *        a source location originates
+ *
+ * @return Path of the included file or the unity translation unit path, if
+ *         the location is not in any of the included files
+ */
+util::interned_string unity_translation_unit(
+    const clang::SourceManager &source_manager,
+    const clang::SourceLocation &location,
+    const std::filesystem::path &relative_to_path, source_paths_cache &cache)
+{
+    const auto main_file_id = source_manager.getMainFileID();
+
+    auto file_id =
+        source_manager.getFileID(source_manager.getExpansionLoc(location));
+    while (file_id.isValid() && file_id != main_file_id) {
+        const auto include_location = source_manager.getIncludeLoc(file_id);
+        if (include_location.isInvalid())
+            break;
+
+        const auto parent_id = source_manager.getFileID(include_location);
+        if (parent_id != main_file_id) {
+            file_id = parent_id;
+            continue;
+        }
+
+        auto [it, inserted] =
+            cache.unity_files.try_emplace(file_id.getHashValue());
+        if (inserted) {
+            auto path = std::filesystem::relative(
+                source_manager
+                    .getFilename(source_manager.getLocForStartOfFile(file_id))
+                    .str(),
+                relative_to_path);
+            path.make_preferred();
+            it->second = util::interned_string{path.string()};
+        }
+
+        return it->second;
+    }
+
+    return cache.translation_unit;
+}
+} // namespace
+
 void set_source_location(clang::SourceManager &source_manager,
     const clang::SourceLocation &location,
     clanguml::common::model::source_location &element,
-    std::filesystem::path tu_path, std::filesystem::path relative_to_path_)
+    const std::filesystem::path &tu_path,
+    const std::filesystem::path &relative_to_path_, source_paths_cache *cache)
 {
-    namespace fs = std::filesystem;
-
     std::string file;
     unsigned line{};
     unsigned column{};
@@ -1108,27 +1275,30 @@ void set_source_location(clang::SourceManager &source_manager,
         }
     }
 
-    // ensure the path is absolute
-    fs::path file_path{file};
-    if (!file_path.is_absolute()) {
-        file_path = fs::absolute(file_path);
-    }
-
-    file_path = file_path.lexically_normal();
-
-    file = file_path.string();
-
-    element.set_file(file);
+    if (cache != nullptr) {
+        auto it = cache->files.find(file);
+        if (it == cache->files.end()) {
+            it = cache->files
+                     .emplace(
+                         file, resolve_source_paths(file, relative_to_path_))
+                     .first;
+        }
 
-    if (util::is_relative_to(file_path, relative_to_path_)) {
-        element.set_file_relative(util::path_to_url(
-            fs::path{element.file()}.lexically_relative(relative_to_path_)));
+        element.set_file(it->second.file);
+        element.set_file_relative(it->second.file_relative);
+        element.set_translation_unit(cache->unity
+                ? unity_translation_unit(
+                      source_manager, location, relative_to_path_, *cache)
+                : cache->translation_unit);
     }
     else {
-        element.set_file_relative("");
+        const auto paths = resolve_source_paths(file, relative_to_path_);
+
+        element.set_file(paths.file);
+        element.set_file_relative(paths.file_relative);
+        element.set_translation_unit(tu_path.string());
     }
 
-    element.set_translation_unit(tu_path.string());
     element.set_line(line);
     element.set_column(column);
     element.set_location_id(location.getHashValue());
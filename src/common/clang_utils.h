@@ -31,12 +31,131 @@
 #include <deque>
 #include <filesystem>
 #include <string>
+#include <unordered_map>
 
 namespace clang {
 class NamespaceDecl;
 }
 
 namespace clanguml::common {
+/**
+ * @brief Cache of printed type and declaration names
+ *
+ * While a cache is attached to an AST context using @ref scope, functions
+ * printing types and declaration names, such as `to_string()` for
+ * `clang::QualType`, `get_tag_name()` or `get_qualified_name()`, reuse
+ * names already printed for the same type or declaration in this AST
+ * context. The cached names are dropped when the scope ends.
+ */
+class printing_cache {
+public:
+    /**
+     * @brief Attaches a printing cache to an AST context in the current
+     *        thread until the end of the scope
+     */
+    class scope {
+    public:
+        scope(printing_cache &cache, const clang::ASTContext &ctx);
+
+        scope(const scope &) = delete;
+        scope(scope &&) = delete;
+        scope &operator=(const scope &) = delete;
+        scope &operator=(scope &&) = delete;
+
+        ~scope();
+
+    private:
+        printing_cache &cache_;
+        printing_cache *previous_;
+    };
+
+    /**
+     * @brief Get the cache attached to an AST context in the current thread
+     *
+     * @param ctx AST context
+     * @return Pointer to the attached cache or nullptr
+     */
+    static printing_cache *current(const clang::ASTContext &ctx);
+
+    /**
+     * @brief Get cached type name or print and cache it
+     *
+     * @param type Type, including its qualifiers
+     * @param try_canonical Printing flag passed to `to_string()`
+     * @param print Function printing the type name
+     * @return Type name
+     */
+    template <typename F>
+    std::string type_name(
+        const clang::QualType &type, bool try_canonical, F &&print)
+    {
+        return get_or_print(type_names_[try_canonical ? 1 : 0],
+            type.getAsOpaquePtr(), std::forward<F>(print));
+    }
+
+    /**
+     * @brief Get cached qualified declaration name or print and cache it
+     *
+     * @param decl Declaration
+     * @param is_tag Whether the name was printed as a tag name
+     * @param print Function printing the declaration name
+     * @return Qualified declaration name
+     */
+    template <typename F>
+    std::string qualified_name(const clang::Decl *decl, bool is_tag, F &&print)
+    {
+        return get_or_print(is_tag ? tag_qualified_names_ : qualified_names_,
+            static_cast<const void *>(decl), std::forward<F>(print));
+    }
+
+    /**
+     * @brief Get cached tag name or print and cache it
+     *
+     * @param decl Tag declaration
+     * @param print Function printing the tag name
+     * @return Tag name
+     */
+    template <typename F>
+    std::string tag_name(const clang::TagDecl *decl, F &&print)
+    {
+        return get_or_print(tag_names_, static_cast<const void *>(decl),
+            std::forward<F>(print));
+    }
+
+private:
+    using names_t = std::unordered_map<const void *, std::string>;
+
+    template <typename F>
+    std::string get_or_print(names_t &names, const void *key, F &&print)
+    {
+        if (const auto it = names.find(key); it != names.end()) {
+            hits_++;
+            return it->second;
+        }
+
+        misses_++;
+
+        // The print function can use the cache recursively, so the
+        // iterator has to be obtained after printing
+        auto name = print();
+        names.emplace(key, name);
+
+        return name;
+    }
+
+    void clear();
+
+    const clang::ASTContext *ast_context_{nullptr};
+
+    names_t type_names_[2];
+    names_t qualified_names_;
+    names_t tag_qualified_names_;
+    names_t tag_names_;
+
+    uint64_t hits_{0};
+    uint64_t misses_{0};
+};
+
 /**
  * @brief Convert `clang::AccessSpecifier` to @see clanguml::model::access_t
  *
@@ -70,20 +189,30 @@ std::string get_tag_name(const clang::TagDecl &declaration);
  */
 template <typename T> std::string get_qualified_name(const T &declaration)
 {
-    auto qualified_name = declaration.getQualifiedNameAsString();
-    util::replace_all(qualified_name, "(anonymous namespace)", "");
-    util::replace_all(qualified_name, "::::", "::");
-
-    if constexpr (std::is_base_of_v<clang::TagDecl, T>) {
-        auto base_name = get_tag_name(declaration);
-        model::namespace_ ns{qualified_name};
-        ns.pop_back();
-        ns = ns | base_name;
-
-        return ns.to_string();
+    const auto print = [&declaration] {
+        auto qualified_name = declaration.getQualifiedNameAsString();
+        util::replace_all(qualified_name, "(anonymous namespace)", "");
+        util::replace_all(qualified_name, "::::", "::");
+
+        if constexpr (std::is_base_of_v<clang::TagDecl, T>) {
+            auto base_name = get_tag_name(declaration);
+            model::namespace_ ns{qualified_name};
+            ns.pop_back();
+            ns = ns | base_name;
+
+            return ns.to_string();
+        }
+
+        return qualified_name;
+    };
+
+    if (auto *cache = printing_cache::current(declaration.getASTContext());
+        cache != nullptr) {
+        return cache->qualified_name(
+            &declaration, std::is_base_of_v<clang::TagDecl, T>, print);
     }
 
-    return qualified_name;
+    return print();
 }
 
 /**
@@ -179,7 +308,9 @@ bool is_subexpr_of(const clang::Stmt *parent_stmt, const clang::Stmt *sub_stmt);
  * These methods provide the main mechanism for generating globally unique
  * identifiers for all elements in the diagrams. The identifiers must be unique
  * between different translation units in order for element relationships to
- * be properly rendered in diagrams.
+ * be properly rendered in diagrams. They are computed using a stable
+ * 64-bit hash (@see clanguml::util::hash64), so they do not change between
+ * platforms, standard library implementations or clang-uml runs.
  *
  * @{
  */
@@ -210,6 +341,8 @@ template <> eid_t to_id(const clang::EnumType &type);
 template <> eid_t to_id(const clang::TemplateSpecializationType &type);
 
 template <> eid_t to_id(const std::filesystem::path &type);
+
+template <> eid_t to_id(const common::model::path &path);
 /** @} */ // end of to_id
 
 /**
@@ -316,11 +449,51 @@ clang::RawComment *get_declaration_raw_comment(const clang::SourceManager &sm,
 clang::RawComment *get_raw_comment(const clang::SourceManager &sm,
     const clang::ASTContext &context, const clang::SourceRange &source_range);
 
+/**
+ * @brief Cache of resolved source file paths
+ *
+ * Maps file names reported by clang::SourceManager to interned absolute
+ * and `relative_to` relative paths, so that normalizing and relativizing
+ * paths is only done once per file instead of once per diagram element.
+ */
+struct source_paths_cache {
+    struct entry {
+        util::interned_string file;
+        util::interned_string file_relative;
+    };
+
+    /*! Interned path of the translation unit currently being visited */
+    util::interned_string translation_unit;
+
+    /*! Whether the translation unit is a unity translation unit */
+    bool unity{false};
+
+    std::unordered_map<std::string, entry> files;
+
+    /*! Paths of files included by a unity translation unit by FileID */
+    std::unordered_map<unsigned, util::interned_string> unity_files;
+};
+
+/**
+ * @brief Set source location of a diagram element
+ *
+ * @param source_manager Reference to clang::SourceManager
+ * @param location Clang source location
+ * @param element Diagram element, relationship or message to update
+ * @param tu_path Path to the current translation unit, ignored if `cache`
+ *                is provided. In unity translation units, the translation
+ *                unit of an element is the file included by the unity
+ *                translation unit, from which the element originates.
+ * @param relative_to_path_ Path relative to which relative paths are
+ *                          calculated
+ * @param cache Optional source paths cache
+ */
 void set_source_location(clang::SourceManager &source_manager,
     const clang::SourceLocation &location,
     clanguml::common::model::source_location &element,
-    std::filesystem::path tu_path,
-    std::filesystem::path relative_to_path_ = {});
+    const std::filesystem::path &tu_path,
+    const std::filesystem::path &relative_to_path_ = {},
+    source_paths_cache *cache = nullptr);
 
 /**
  * Check if function or method declaration is a C++20 coroutine.
@@ -18,7 +18,9 @@
 
 #include "compilation_database.h"
 #include "util/error.h"
+#include "util/logging.h"
 #include "util/query_driver_output_extractor.h"
+#include "util/trace.h"
 
 namespace clanguml::common {
 
@@ -26,6 +28,8 @@ std::unique_ptr<compilation_database>
 compilation_database::auto_detect_from_directory(
     const clanguml::config::config &cfg)
 {
+    const util::trace_span span{"config", "load compilation database"};
+
     std::string error_message;
     auto res = clang::tooling::CompilationDatabase::autoDetectFromDirectory(
         cfg.compilation_database_dir(), error_message);
@@ -54,10 +58,69 @@ compilation_database::compilation_database(
     , config_{cfg}
     , is_fixed_{is_fixed}
 {
+    if (!is_fixed_)
+        build_index();
+}
+
+void compilation_database::build_index()
+{
+    auto commands = base().getAllCompileCommands();
+
+    adjust_compilation_database(commands);
+
+    commands_.reserve(commands.size());
+    for (auto &command : commands) {
+        indexed_command ic;
+        ic.directory = util::interned_string{command.Directory};
+        ic.filename = util::interned_string{command.Filename};
+        ic.output = util::interned_string{command.Output};
+        ic.command_line.reserve(command.CommandLine.size());
+        for (const auto &arg : command.CommandLine)
+            ic.command_line.emplace_back(arg);
+
+        commands_index_[normalize_path(command.Directory, command.Filename)]
+            .push_back(commands_.size());
+        commands_.emplace_back(std::move(ic));
+
+        // Release memory of the loaded command as soon as possible
+        command = {};
+    }
+
+    all_files_ = base().getAllFiles();
+
+    LOG_DBG("Loaded {} compile commands for {} files", commands_.size(),
+        commands_index_.size());
+}
+
+clang::tooling::CompileCommand compilation_database::to_compile_command(
+    const indexed_command &command) const
+{
+    std::vector<std::string> command_line;
+    command_line.reserve(command.command_line.size());
+    for (const auto &arg : command.command_line)
+        command_line.push_back(arg.str());
+
+    return {command.directory.str(), command.filename.str(),
+        std::move(command_line), command.output.str()};
+}
+
+std::string compilation_database::normalize_path(
+    const std::string &directory, const std::string &file)
+{
+    std::filesystem::path result{file};
+    if (result.is_relative() && !directory.empty())
+        result = std::filesystem::path{directory} / result;
+
+    return result.lexically_normal().make_preferred().string();
 }
 
 bool compilation_database::is_fixed() const { return is_fixed_; }
 
+bool compilation_database::is_indexed(const std::string &file) const
+{
+    return commands_index_.count(normalize_path({}, file)) > 0;
+}
+
 const clanguml::config::config &compilation_database::config() const
 {
     return config_;
@@ -70,12 +133,30 @@ const clang::tooling::CompilationDatabase &compilation_database::base() const
 
 std::vector<std::string> compilation_database::getAllFiles() const
 {
-    return base().getAllFiles();
+    if (is_fixed())
+        return base().getAllFiles();
+
+    return all_files_;
 }
 
 std::vector<clang::tooling::CompileCommand>
 compilation_database::getCompileCommands(clang::StringRef FilePath) const
 {
+    if (!is_fixed()) {
+        const auto path = FilePath.str();
+        if (const auto it = commands_index_.find(normalize_path({}, path));
+            it != commands_index_.end()) {
+            std::vector<clang::tooling::CompileCommand> result;
+            result.reserve(it->second.size());
+            for (const auto index : it->second)
+                result.emplace_back(to_compile_command(commands_[index]));
+
+            return result;
+        }
+    }
+
+    // Fall back to the original database, e.g. for paths which are only
+    // equivalent due to symbolic links
     auto commands = base().getCompileCommands(FilePath);
 
     adjust_compilation_database(commands);
@@ -86,6 +167,15 @@ compilation_database::getCompileCommands(clang::StringRef FilePath) const
 std::vector<clang::tooling::CompileCommand>
 compilation_database::getAllCompileCommands() const
 {
+    if (!is_fixed()) {
+        std::vector<clang::tooling::CompileCommand> result;
+        result.reserve(commands_.size());
+        for (const auto &command : commands_)
+            result.emplace_back(to_compile_command(command));
+
+        return result;
+    }
+
     auto commands = base().getAllCompileCommands();
 
     adjust_compilation_database(commands);
@@ -127,26 +217,12 @@ void compilation_database::adjust_compilation_database(
                 ? compile_command.CommandLine.at(0)
                 : config().query_driver();
 
-            util::query_driver_output_extractor extractor{
-                argv0, guess_language_from_filename(compile_command.Filename)};
-
-            extractor.execute();
-
-            std::vector<std::string> system_header_args;
-            for (const auto &path : extractor.system_include_paths()) {
-                system_header_args.emplace_back("-isystem");
-                system_header_args.emplace_back(path);
-            }
+            const auto args = query_driver_arguments(
+                argv0, guess_language_from_filename(compile_command.Filename));
 
             compile_command.CommandLine.insert(
-                compile_command.CommandLine.begin() + 1,
-                system_header_args.begin(), system_header_args.end());
-
-            if (!extractor.target().empty()) {
-                compile_command.CommandLine.insert(
-                    compile_command.CommandLine.begin() + 1,
-                    fmt::format("--target={}", extractor.target()));
-            }
+                compile_command.CommandLine.begin() + 1, args.begin(),
+                args.end());
         }
     }
 #endif
@@ -172,6 +248,34 @@ void compilation_database::adjust_compilation_database(
     }
 }
 
+std::vector<std::string> compilation_database::query_driver_arguments(
+    const std::string &driver, const std::string &language) const
+{
+    std::lock_guard<std::mutex> l(query_driver_mutex_);
+
+    const auto key = std::make_pair(driver, language);
+    if (auto it = query_driver_arguments_.find(key);
+        it != query_driver_arguments_.end())
+        return it->second;
+
+    util::query_driver_output_extractor extractor{driver, language};
+
+    extractor.execute();
+
+    std::vector<std::string> result;
+    if (!extractor.target().empty())
+        result.emplace_back(fmt::format("--target={}", extractor.target()));
+
+    for (const auto &path : extractor.system_include_paths()) {
+        result.emplace_back("-isystem");
+        result.emplace_back(path);
+    }
+
+    query_driver_arguments_.emplace(key, result);
+
+    return result;
+}
+
 bool compilation_database::match_filename(
     const clang::tooling::CompileCommand &command,
     const std::string &file) const
@@ -23,6 +23,7 @@
 #include "config/config.h"
 #include "types.h"
 #include "util/error.h"
+#include "util/string_pool.h"
 #include "util/util.h"
 
 #include <clang/Frontend/CompilerInstance.h>
@@ -31,7 +32,12 @@
 
 #include <deque>
 #include <filesystem>
+#include <map>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace clanguml::common {
 
@@ -43,6 +49,11 @@ namespace clanguml::common {
  * which provides the possibility of adjusting the compilation flags after
  * they have been loaded from the `compile_commands.json` file.
  *
+ * Unless the database is fixed, all compile commands are adjusted once when
+ * the database is created, and stored in a compact table indexed by the
+ * normalized absolute path of the source file. The database is read-only
+ * afterwards, so it can be shared by all diagrams generated in parallel.
+ *
  * @embed{compilation_database_context_class.svg}
  */
 class compilation_database : public clang::tooling::CompilationDatabase {
@@ -116,13 +127,67 @@ public:
      */
     bool is_fixed() const;
 
+    /**
+     * @brief Check whether compile commands for a file are in the command
+     *        table, i.e. can be returned without querying the original
+     *        database
+     *
+     * @param file Source file path
+     * @return True, if the file has indexed compile commands
+     */
+    bool is_indexed(const std::string &file) const;
+
 private:
+    /**
+     * @brief Compile command stored in the compact command table
+     *
+     * All strings are stored in the global string pool, so arguments
+     * repeated across compile commands are only stored once.
+     */
+    struct indexed_command {
+        util::interned_string directory;
+        util::interned_string filename;
+        util::interned_string output;
+        std::vector<util::interned_string> command_line;
+    };
+
     bool match_filename(const clang::tooling::CompileCommand &command,
         const std::string &file) const;
 
     void adjust_compilation_database(
         std::vector<clang::tooling::CompileCommand> &commands) const;
 
+    /**
+     * @brief Get compiler arguments with system include paths and target
+     *        reported by the compiler driver
+     *
+     * Each compiler driver is only executed once for each language.
+     *
+     * @param driver Compiler driver command
+     * @param language Language name (c or c++)
+     * @return Arguments to be inserted after argv[0]
+     */
+    std::vector<std::string> query_driver_arguments(
+        const std::string &driver, const std::string &language) const;
+
+    /**
+     * @brief Load and adjust all compile commands into the command table
+     */
+    void build_index();
+
+    clang::tooling::CompileCommand to_compile_command(
+        const indexed_command &command) const;
+
+    /**
+     * @brief Normalize source file path for lookups in the command table
+     *
+     * @param directory Compile command directory for relative paths
+     * @param file Source file path
+     * @return Normalized absolute path
+     */
+    static std::string normalize_path(
+        const std::string &directory, const std::string &file);
+
     /*!
      * Pointer to the Clang's original compilation database.
      *
@@ -141,6 +206,16 @@ private:
      * compile_flags.txt
      */
     bool is_fixed_;
+
+    // Compact table of adjusted compile commands
+    std::vector<indexed_command> commands_;
+    std::unordered_map<std::string, std::vector<std::size_t>> commands_index_;
+    std::vector<std::string> all_files_;
+
+    mutable std::mutex query_driver_mutex_;
+    mutable std::map<std::pair<std::string, std::string>,
+        std::vector<std::string>>
+        query_driver_arguments_;
 };
 
 using compilation_database_ptr = std::unique_ptr<compilation_database>;
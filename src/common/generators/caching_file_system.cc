@@ -0,0 +1,252 @@
+/**
+ * @file src/common/generators/caching_file_system.cc
+ *
+ * Copyright (c) 2021-2025 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "caching_file_system.h"
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/Path.h>
+
+#include <mutex>
+
+namespace clanguml::generators {
+
+namespace {
+/**
+ * @brief File backed by contents stored in the file system cache
+ */
+class cached_file : public llvm::vfs::File {
+public:
+    cached_file(llvm::vfs::Status status, const llvm::MemoryBuffer &buffer)
+        : status_{std::move(status)}
+        , buffer_{buffer}
+    {
+    }
+
+    llvm::ErrorOr<llvm::vfs::Status> status() override { return status_; }
+
+    llvm::ErrorOr<std::string> getName() override
+    {
+        return status_.getName().str();
+    }
+
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> getBuffer(
+        const llvm::Twine &name, int64_t /*file_size*/,
+        bool requires_null_terminator, bool /*is_volatile*/) override
+    {
+        // The returned buffer only references the cached contents, which
+        // are kept until the process exits
+        return llvm::MemoryBuffer::getMemBuffer(
+            buffer_.getBuffer(), name.str(), requires_null_terminator);
+    }
+
+    std::error_code close() override { return {}; }
+
+private:
+    llvm::vfs::Status status_;
+    const llvm::MemoryBuffer &buffer_;
+};
+} // namespace
+
+file_system_cache &file_system_cache::instance()
+{
+    static file_system_cache cache;
+    return cache;
+}
+
+void file_system_cache::set_size_limit(uint64_t bytes) { size_limit_ = bytes; }
+
+bool file_system_cache::reserve_contents(uint64_t size)
+{
+    std::unique_lock<std::shared_mutex> l(mutex_);
+
+    const uint64_t limit = size_limit_;
+    const uint64_t current = contents_size_;
+
+    if (size > limit || current > limit - size)
+        return false;
+
+    contents_size_ += size;
+
+    return true;
+}
+
+void file_system_cache::release_contents(uint64_t size)
+{
+    std::unique_lock<std::shared_mutex> l(mutex_);
+
+    contents_size_ -= size;
+}
+
+std::optional<llvm::ErrorOr<llvm::vfs::Status>> file_system_cache::find_status(
+    const std::string &path)
+{
+    std::shared_lock<std::shared_mutex> l(mutex_);
+
+    if (auto it = statuses_.find(path); it != statuses_.end()) {
+        status_hits_++;
+        return it->second;
+    }
+
+    status_misses_++;
+    return {};
+}
+
+void file_system_cache::add_status(
+    const std::string &path, const llvm::ErrorOr<llvm::vfs::Status> &status)
+{
+    std::unique_lock<std::shared_mutex> l(mutex_);
+
+    statuses_.emplace(path, status);
+}
+
+const file_system_cache::contents_entry *file_system_cache::find_contents(
+    const std::string &path)
+{
+    std::shared_lock<std::shared_mutex> l(mutex_);
+
+    if (auto it = contents_.find(path); it != contents_.end()) {
+        contents_hits_++;
+        return it->second.get();
+    }
+
+    contents_misses_++;
+    return nullptr;
+}
+
+const file_system_cache::contents_entry &file_system_cache::add_contents(
+    const std::string &path, const llvm::vfs::Status &status,
+    std::unique_ptr<llvm::MemoryBuffer> buffer, uint64_t reserved)
+{
+    std::unique_lock<std::shared_mutex> l(mutex_);
+
+    contents_size_ -= reserved;
+
+    auto [it, inserted] = contents_.try_emplace(path);
+    if (inserted) {
+        contents_size_ += buffer->getBufferSize();
+        it->second = std::make_unique<contents_entry>(
+            contents_entry{status, std::move(buffer)});
+        statuses_.emplace(path, status);
+    }
+
+    return *it->second;
+}
+
+file_system_cache::statistics file_system_cache::stats() const
+{
+    statistics result;
+    result.status_hits = status_hits_;
+    result.status_misses = status_misses_;
+    result.contents_hits = contents_hits_;
+    result.contents_misses = contents_misses_;
+    result.contents_size = contents_size_;
+
+    std::shared_lock<std::shared_mutex> l(mutex_);
+    result.contents_count = contents_.size();
+
+    return result;
+}
+
+caching_file_system::caching_file_system(
+    llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fs,
+    file_system_cache &cache)
+    : llvm::vfs::ProxyFileSystem{std::move(fs)}
+    , cache_{cache}
+{
+}
+
+llvm::ErrorOr<llvm::vfs::Status> caching_file_system::status(
+    const llvm::Twine &path)
+{
+    const auto key = cache_key(path);
+    if (!key)
+        return ProxyFileSystem::status(path);
+
+    if (auto cached = cache_.find_status(*key); cached) {
+        if (!*cached)
+            return cached->getError();
+
+        return llvm::vfs::Status::copyWithNewName(**cached, path);
+    }
+
+    auto result = ProxyFileSystem::status(path);
+
+    // Only cache definite results, other errors (e.g. permission denied)
+    // can be transient
+    if (result ||
+        result.getError() ==
+            std::make_error_code(std::errc::no_such_file_or_directory))
+        cache_.add_status(*key, result);
+
+    return result;
+}
+
+llvm::ErrorOr<std::unique_ptr<llvm::vfs::File>>
+caching_file_system::openFileForRead(const llvm::Twine &path)
+{
+    const auto key = cache_key(path);
+    if (!key)
+        return ProxyFileSystem::openFileForRead(path);
+
+    if (const auto *entry = cache_.find_contents(*key); entry != nullptr) {
+        return std::make_unique<cached_file>(
+            llvm::vfs::Status::copyWithNewName(entry->status, path),
+            *entry->buffer);
+    }
+
+    auto file = ProxyFileSystem::openFileForRead(path);
+    if (!file)
+        return file;
+
+    auto status = (*file)->status();
+    if (!status || !status->isRegularFile())
+        return file;
+
+    const auto size = status->getSize();
+    if (!cache_.reserve_contents(size))
+        return file;
+
+    auto buffer = (*file)->getBuffer(path, static_cast<int64_t>(size),
+        /*RequiresNullTerminator=*/true, /*IsVolatile=*/false);
+    if (!buffer) {
+        cache_.release_contents(size);
+        return buffer.getError();
+    }
+
+    const auto &entry =
+        cache_.add_contents(*key, *status, std::move(*buffer), size);
+
+    return std::make_unique<cached_file>(
+        llvm::vfs::Status::copyWithNewName(entry.status, path), *entry.buffer);
+}
+
+std::optional<std::string> caching_file_system::cache_key(
+    const llvm::Twine &path)
+{
+    llvm::SmallString<256> result; // NOLINT
+    path.toVector(result);
+
+    if (makeAbsolute(result))
+        return {};
+
+    llvm::sys::path::remove_dots(result);
+
+    return std::string{result.str()};
+}
+
+} // namespace clanguml::generators
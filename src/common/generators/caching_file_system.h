@@ -0,0 +1,199 @@
+/**
+ * @file src/common/generators/caching_file_system.h
+ *
+ * Copyright (c) 2021-2025 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/VirtualFileSystem.h>
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+namespace clanguml::generators {
+
+/**
+ * @brief Process-wide, thread-safe cache of file statuses and contents
+ *
+ * The cache is shared by all `clang_tool` instances, so that source files
+ * included by translation units of several diagrams generated in parallel
+ * are only stat'ed and read from disk once. Source files are assumed not to
+ * change while clang-uml is running.
+ *
+ * Cached file contents are never evicted, as Clang source managers keep
+ * references to them. Instead, once the total size of cached contents
+ * reaches the size limit, new files are read directly from the underlying
+ * file system.
+ */
+class file_system_cache {
+public:
+    static constexpr uint64_t kNoLimit{std::numeric_limits<uint64_t>::max()};
+
+    /**
+     * @brief Cached contents of a regular file
+     */
+    struct contents_entry {
+        llvm::vfs::Status status;
+        std::unique_ptr<llvm::MemoryBuffer> buffer;
+    };
+
+    /**
+     * @brief Cache usage statistics
+     */
+    struct statistics {
+        uint64_t status_hits{0};
+        uint64_t status_misses{0};
+        uint64_t contents_hits{0};
+        uint64_t contents_misses{0};
+        uint64_t contents_count{0};
+        uint64_t contents_size{0};
+    };
+
+    /**
+     * @brief Get the process-wide cache instance
+     *
+     * @return Reference to the file system cache
+     */
+    static file_system_cache &instance();
+
+    /**
+     * @brief Set the maximum total size of cached file contents
+     *
+     * @param bytes Size limit in bytes, 0 disables caching of file contents
+     */
+    void set_size_limit(uint64_t bytes);
+
+    /**
+     * @brief Reserve space for contents of a file of specific size
+     *
+     * The space is reserved atomically, so that concurrent readers cannot
+     * exceed the size limit together. A successful reservation has to be
+     * passed to @ref add_contents or returned with @ref release_contents.
+     *
+     * @param size File size in bytes
+     * @return True, if the file fits in the cache size limit
+     */
+    bool reserve_contents(uint64_t size);
+
+    /**
+     * @brief Return space reserved with @ref reserve_contents
+     *
+     * @param size Reserved size in bytes
+     */
+    void release_contents(uint64_t size);
+
+    /**
+     * @brief Find cached status of a file
+     *
+     * @param path Absolute file path
+     * @return Cached status or error, if path was already stat'ed
+     */
+    std::optional<llvm::ErrorOr<llvm::vfs::Status>> find_status(
+        const std::string &path);
+
+    /**
+     * @brief Add status of a file to the cache
+     *
+     * @param path Absolute file path
+     * @param status File status or error
+     */
+    void add_status(const std::string &path,
+        const llvm::ErrorOr<llvm::vfs::Status> &status);
+
+    /**
+     * @brief Find cached contents of a file
+     *
+     * @param path Absolute file path
+     * @return Pointer to cached entry or nullptr
+     */
+    const contents_entry *find_contents(const std::string &path);
+
+    /**
+     * @brief Add contents of a file to the cache
+     *
+     * If another thread already added the same file, the existing entry
+     * is returned and the reserved space is released.
+     *
+     * @param path Absolute file path
+     * @param status File status
+     * @param buffer File contents
+     * @param reserved Size reserved with @ref reserve_contents
+     * @return Reference to the cached entry
+     */
+    const contents_entry &add_contents(const std::string &path,
+        const llvm::vfs::Status &status,
+        std::unique_ptr<llvm::MemoryBuffer> buffer, uint64_t reserved);
+
+    /**
+     * @brief Get cache usage statistics
+     *
+     * @return Cache statistics
+     */
+    statistics stats() const;
+
+private:
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<std::string, llvm::ErrorOr<llvm::vfs::Status>>
+        statuses_;
+    std::unordered_map<std::string, std::unique_ptr<contents_entry>>
+        contents_;
+
+    std::atomic<uint64_t> size_limit_{kNoLimit};
+    // Size of cached contents, including reserved space
+    std::atomic<uint64_t> contents_size_{0};
+
+    std::atomic<uint64_t> status_hits_{0};
+    std::atomic<uint64_t> status_misses_{0};
+    std::atomic<uint64_t> contents_hits_{0};
+    std::atomic<uint64_t> contents_misses_{0};
+};
+
+/**
+ * @brief File system layer, which serves file statuses and contents from
+ *        a shared @ref file_system_cache
+ *
+ * All other operations, including changing working directory, are forwarded
+ * to the underlying file system.
+ */
+class caching_file_system : public llvm::vfs::ProxyFileSystem {
+public:
+    caching_file_system(llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fs,
+        file_system_cache &cache);
+
+    llvm::ErrorOr<llvm::vfs::Status> status(const llvm::Twine &path) override;
+
+    llvm::ErrorOr<std::unique_ptr<llvm::vfs::File>> openFileForRead(
+        const llvm::Twine &path) override;
+
+private:
+    /**
+     * @brief Get normalized absolute path used as the cache key
+     *
+     * @param path File path
+     * @return Absolute path or empty optional if it could not be resolved
+     */
+    std::optional<std::string> cache_key(const llvm::Twine &path);
+
+    file_system_cache &cache_;
+};
+
+} // namespace clanguml::generators
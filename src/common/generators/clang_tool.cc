@@ -17,13 +17,26 @@
  */
 
 #include "clang_tool.h"
+#include "caching_file_system.h"
+#include "preamble_cache.h"
 
 #include <clang/Frontend/CompilerInstance.h>
 #include <clang/Frontend/CompilerInvocation.h>
 #include <clang/Tooling/CompilationDatabase.h>
 
+#include "util/hash.h"
+#include "util/memory_budget.h"
+#include "util/trace.h"
 #include "util/util.h"
 
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <filesystem>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+
 namespace clanguml::generators {
 
 namespace {
@@ -41,8 +54,209 @@ void inject_resource_dir(
         clang::CompilerInvocation::GetResourcesPath(argv_0, main_addr))
                                                          .c_str())(args, "");
 }
+
+/**
+ * Translation units compiled with the same command, except for the source
+ * file name, can share a precompiled preamble or a unity translation unit.
+ */
+std::string make_command_group_key(
+    const CompileCommand &command, const CommandLineArguments &args)
+{
+    const std::filesystem::path directory{command.Directory};
+    const auto source_file = (directory / command.Filename).lexically_normal();
+
+    std::string result{command.Directory};
+    for (const auto &arg : args) {
+        if ((directory / arg).lexically_normal() == source_file)
+            continue;
+
+        result.append(1, '\0').append(arg);
+    }
+
+    return result;
+}
+
+/**
+ * Flags, which only affect diagnostics reported by the compiler. Output
+ * and dependency file flags are already removed by the arguments adjusters.
+ */
+bool is_diagnostic_flag(const std::string &arg)
+{
+    using util::starts_with;
+
+    // -Wp,<arg> passes options to the preprocessor
+    if (starts_with(arg, std::string{"-W"}))
+        return !starts_with(arg, std::string{"-Wp,"});
+
+    return arg == "-w" || arg == "-pedantic" || arg == "-pedantic-errors" ||
+        starts_with(arg, std::string{"-fdiagnostics-"}) ||
+        starts_with(arg, std::string{"-fcolor-diagnostics"}) ||
+        starts_with(arg, std::string{"-fno-color-diagnostics"}) ||
+        starts_with(arg, std::string{"-fmessage-length"});
+}
+
+/**
+ * Include path and macro definition options of a command line, with their
+ * values, in the order in which they appear.
+ */
+std::vector<std::pair<std::string, std::string>> get_include_and_define_options(
+    const CommandLineArguments &command_line)
+{
+    // Longer options have to be checked before their prefixes
+    static const std::array<std::string, 5> kOptions{
+        "-isystem", "-iquote", "-idirafter", "-I", "-D"};
+
+    std::vector<std::pair<std::string, std::string>> result;
+    for (std::size_t i = 0; i < command_line.size(); i++) {
+        const auto &arg = command_line[i];
+        if (arg == "--")
+            break;
+
+        for (const auto &option : kOptions) {
+            if (!util::starts_with(arg, option))
+                continue;
+
+            if (arg.size() > option.size())
+                result.emplace_back(option, arg.substr(option.size()));
+            else if (i + 1 < command_line.size())
+                result.emplace_back(option, command_line[++i]);
+
+            break;
+        }
+    }
+
+    return result;
+}
 } // namespace
 
+uint64_t compile_command_hash(const std::string &directory,
+    const CommandLineArguments &command_line, bool semantic)
+{
+    util::hash64 hash;
+    hash.update(directory);
+
+    for (const auto &arg : command_line) {
+        if (semantic && is_diagnostic_flag(arg))
+            continue;
+
+        hash.update({"\0", 1}).update(arg);
+    }
+
+    return hash.digest();
+}
+
+CommandLineArguments merge_compile_commands(
+    const std::vector<CompileCommand> &commands)
+{
+    assert(!commands.empty());
+
+    const auto &first = commands.front();
+    auto result = first.CommandLine;
+
+    const auto macro_name = [](const std::string &definition) {
+        return definition.substr(0, definition.find('='));
+    };
+
+    const auto absolute_path = [](const std::string &directory,
+                                   const std::string &path) {
+        return (std::filesystem::path{directory} / path)
+            .lexically_normal()
+            .string();
+    };
+
+    std::set<std::string> macros;
+    std::set<std::pair<std::string, std::string>> include_paths;
+    for (const auto &[option, value] :
+        get_include_and_define_options(first.CommandLine)) {
+        if (option == "-D")
+            macros.emplace(macro_name(value));
+        else
+            include_paths.emplace(
+                option, absolute_path(first.Directory, value));
+    }
+
+    // Add include paths and macros missing from the first command, the
+    // first definition of a macro takes precedence
+    CommandLineArguments merged;
+    for (auto it = std::next(commands.begin()); it != commands.end(); ++it) {
+        for (const auto &[option, value] :
+            get_include_and_define_options(it->CommandLine)) {
+            if (option == "-D") {
+                if (macros.emplace(macro_name(value)).second)
+                    merged.emplace_back(option + value);
+                continue;
+            }
+
+            auto path = absolute_path(it->Directory, value);
+            if (include_paths.emplace(option, path).second) {
+                merged.emplace_back(option);
+                merged.emplace_back(std::move(path));
+            }
+        }
+    }
+
+    result.insert(std::find(result.begin(), result.end(), "--"),
+        merged.begin(), merged.end());
+
+    return result;
+}
+
+std::vector<std::vector<std::string>> make_unity_batches(
+    const std::vector<std::string> &tu_paths,
+    const std::unordered_map<std::string, std::string> &group_keys,
+    unsigned batch_size)
+{
+    // Group translation units by their compile commands, translation units
+    // which cannot be batched form their own groups
+    std::vector<std::vector<std::string>> groups;
+    std::unordered_map<std::string, std::size_t> group_index;
+    for (const auto &file : tu_paths) {
+        const auto group_key = group_keys.find(file);
+        if (batch_size < 2 || group_key == group_keys.end()) {
+            groups.push_back({file});
+            continue;
+        }
+
+        auto [it, inserted] =
+            group_index.emplace(group_key->second, groups.size());
+        if (inserted)
+            groups.emplace_back();
+
+        groups[it->second].push_back(file);
+    }
+
+    std::vector<std::vector<std::string>> result;
+    for (const auto &group : groups) {
+        for (auto batch_begin = group.begin(); batch_begin != group.end();) {
+            const auto batch_end = batch_begin +
+                std::min<std::ptrdiff_t>(std::max(batch_size, 1U),
+                    std::distance(batch_begin, group.end()));
+
+            result.emplace_back(batch_begin, batch_end);
+
+            batch_begin = batch_end;
+        }
+    }
+
+    // Keep the original order of translation units, as far as possible
+    std::unordered_map<std::string, std::size_t> position;
+    for (std::size_t i = 0; i < tu_paths.size(); i++)
+        position.emplace(tu_paths[i], i);
+
+    std::stable_sort(result.begin(), result.end(),
+        [&position](const auto &l, const auto &r) {
+            return position.at(l.front()) < position.at(r.front());
+        });
+
+    return result;
+}
+
+bool is_unity_translation_unit(const std::string &path)
+{
+    return util::starts_with(std::filesystem::path{path}.filename().string(),
+        std::string{kUnityTranslationUnitPrefix});
+}
+
 std::string to_string(const clanguml::generators::diagnostic &d)
 {
     if (!d.location) {
@@ -117,7 +331,8 @@ clang_tool::clang_tool(common::model::diagram_t diagram_type,
     , quiet_{quiet}
     , pch_container_ops_{std::make_shared<PCHContainerOperations>()}
     , overlay_fs_{new llvm::vfs::OverlayFileSystem(
-          llvm::vfs::getRealFileSystem())}
+          new caching_file_system(llvm::vfs::getRealFileSystem(),
+              file_system_cache::instance()))}
     , inmemory_fs_{new llvm::vfs::InMemoryFileSystem}
     , files_{new FileManager(FileSystemOptions(), overlay_fs_)}
     , diag_consumer_{std::make_unique<diagnostic_consumer>(relative_to)}
@@ -138,9 +353,20 @@ void clang_tool::append_arguments_adjuster(ArgumentsAdjuster Adjuster)
         combineAdjusters(std::move(args_adjuster_), std::move(Adjuster));
 }
 
+void clang_tool::disable_precompiled_preambles()
+{
+    precompiled_preambles_ = false;
+}
+
+void clang_tool::set_unity_batch_size(unsigned batch_size)
+{
+    unity_batch_size_ = batch_size;
+}
+
 void clang_tool::run(ToolAction *Action)
 {
-    static int static_symbol;
+    const util::trace_span span{
+        "diagram", "clang tool", {{"diagram", diagram_name_}}};
 
     std::vector<std::string> absolute_tu_paths;
     absolute_tu_paths.reserve(source_paths_.size());
@@ -171,101 +397,270 @@ void clang_tool::run(ToolAction *Action)
                 diagram_name_, current_workdir.getError().message());
     }
 
-    for (const auto &file : absolute_tu_paths) {
-        if (!quiet_)
-            LOG_INFO("Processing diagram '{}' translation unit: {}",
-                diagram_name_, file);
+    // Files of a unity batch are processed together, at the position of
+    // the first file of the batch
+    const auto batches = make_unity_batches(absolute_tu_paths,
+        unity_batch_size_ > 1 ? make_unity_group_keys(absolute_tu_paths)
+                              : std::unordered_map<std::string, std::string>{},
+        unity_batch_size_);
 
-        auto compile_commands_for_file = compilations_.getCompileCommands(file);
+    for (const auto &batch : batches) {
+        if (batch.size() > 1 && run_unity_batch(Action, batch))
+            continue;
 
-        if (compile_commands_for_file.empty()) {
+        // Files from a failed batch are parsed separately, e.g. due to
+        // conflicting declarations in anonymous namespaces
+        for (const auto &file : batch)
+            run_translation_unit(Action, file, initial_workdir);
+    }
+
+    if (!initial_workdir.empty()) {
+        if (const auto ec =
+                overlay_fs_->setCurrentWorkingDirectory(initial_workdir))
             if (!quiet_)
-                LOG_WARN(
-                    "Skipping file {} for diagram '{}'. Compilation command "
-                    "not found.",
-                    file, diagram_name_);
+                LOG_ERROR("Error when trying to restore working dir: {}",
+                    ec.message());
+    }
+}
+
+void clang_tool::run_translation_unit(ToolAction *action,
+    const std::string &file, const std::string &initial_workdir)
+{
+    // Include diagrams rely on preprocessor callbacks for all includes,
+    // which are not emitted for the includes in precompiled preambles
+    auto &preambles = preamble_cache::instance();
+    const bool use_preambles = precompiled_preambles_ && preambles.enabled() &&
+        diagram_type_ != common::model::diagram_t::kInclude;
+    preamble_tool_action preamble_action{action, preambles};
+
+    using config::compile_commands_dedup_t;
+    const auto dedup = compilations_.config().compile_commands_dedup();
+
+    if (!quiet_)
+        LOG_INFO("Processing diagram '{}' translation unit: {}",
+            diagram_name_, file);
+
+    auto compile_commands_for_file = compilations_.getCompileCommands(file);
+
+    if (compile_commands_for_file.empty()) {
+        if (!quiet_)
+            LOG_WARN(
+                "Skipping file {} for diagram '{}'. Compilation command "
+                "not found.",
+                file, diagram_name_);
+        return;
+    }
+
+    if (compile_commands_for_file.size() > 1 &&
+        diagram_type_ == common::model::diagram_t::kSequence) {
+        LOG_WARN("Multiple compile commands detected for file '{}' in "
+                 "diagram '{}' - using only the first one...",
+            file, diagram_name_);
+    }
+    else if (compile_commands_for_file.size() > 1 &&
+        dedup == compile_commands_dedup_t::kUnion) {
+        LOG_DBG("Merging {} compile commands for file '{}' in diagram '{}'",
+            compile_commands_for_file.size(), file, diagram_name_);
+
+        compile_commands_for_file.front().CommandLine =
+            merge_compile_commands(compile_commands_for_file);
+        compile_commands_for_file.resize(1);
+    }
+
+    std::unordered_set<uint64_t> visited_commands;
+
+    for (auto &compile_command : compile_commands_for_file) {
+        auto command_line = adjust_command_line(compile_command);
+
+        const auto command_hash =
+            compile_command_hash(compile_command.Directory, command_line,
+                dedup == compile_commands_dedup_t::kSemantic);
+        if (!visited_commands.emplace(command_hash).second) {
+            LOG_DBG("Skipping duplicate compile command for file '{}' in "
+                    "diagram '{}'",
+                file, diagram_name_);
             continue;
         }
 
-        if (compile_commands_for_file.size() > 1 &&
-            diagram_type_ == common::model::diagram_t::kSequence) {
-            LOG_WARN("Multiple compile commands detected for file '{}' in "
-                     "diagram '{}' - using only the first one...",
-                file, diagram_name_);
+        if (use_preambles) {
+            preamble_action.set_group_key(
+                make_command_group_key(compile_command, command_line));
         }
 
-        for (auto &compile_command : compile_commands_for_file) {
-            if (overlay_fs_->setCurrentWorkingDirectory(
-                    compile_command.Directory))
-                llvm::report_fatal_error("Cannot chdir into \"" +
-                    Twine(compile_command.Directory) + "\"!");
-
-            // Now fill the in-memory VFS with the relative file mappings so it
-            // will have the correct relative paths. We never remove mappings
-            // but that should be fine.
-            if (visited_working_directories_.insert(compile_command.Directory)
-                    .second) {
-                for (const auto &[file_name, file_content] :
-                    memory_mapped_files_)
-                    if (!llvm::sys::path::is_absolute(file_name))
-                        inmemory_fs_->addFile(file_name, 0,
-                            llvm::MemoryBuffer::getMemBuffer(file_content));
+        if (!run_invocation(compile_command.Directory, std::move(command_line),
+                use_preambles ? &preamble_action : action, file)) {
+            if (!initial_workdir.empty()) {
+                if (const auto ec = overlay_fs_->setCurrentWorkingDirectory(
+                        initial_workdir);
+                    ec)
+                    if (!quiet_)
+                        LOG_ERROR("Error when trying to restore working "
+                                  "directory: {}",
+                            ec.message());
             }
 
-            auto command_line = compile_command.CommandLine;
-            if (args_adjuster_)
-                command_line =
-                    args_adjuster_(command_line, compile_command.Filename);
+            if (diag_consumer_ && diag_consumer_->failed) {
+                if (!(diag_consumer_->diagnostics.empty())) {
+                    throw clang_tool_exception(diagram_type_, diagram_name_,
+                        diag_consumer_->diagnostics,
+                        to_string(diag_consumer_->diagnostics.back()));
+                }
+
+                throw clang_tool_exception(diagram_type_, diagram_name_,
+                    diag_consumer_->diagnostics);
+            }
+
+            throw std::runtime_error(
+                fmt::format("Unknown error while processing {}", file));
+        }
+
+        if (diagram_type_ == common::model::diagram_t::kSequence ||
+            dedup == compile_commands_dedup_t::kFirst)
+            break;
+    }
+}
+
+CommandLineArguments clang_tool::adjust_command_line(
+    const CompileCommand &compile_command) const
+{
+    static int static_symbol;
+
+    auto command_line = compile_command.CommandLine;
+    if (args_adjuster_)
+        command_line = args_adjuster_(command_line, compile_command.Filename);
+
+    assert(!command_line.empty());
+
+    inject_resource_dir(command_line, "clang_tool", &static_symbol);
+
+    return command_line;
+}
 
-            assert(!command_line.empty());
+bool clang_tool::run_invocation(const std::string &directory,
+    CommandLineArguments command_line, ToolAction *action,
+    const std::string &task_key)
+{
+    if (overlay_fs_->setCurrentWorkingDirectory(directory))
+        llvm::report_fatal_error("Cannot chdir into \"" + Twine(directory) +
+            "\"!");
+
+    // Now fill the in-memory VFS with the relative file mappings so it
+    // will have the correct relative paths. We never remove mappings
+    // but that should be fine.
+    if (visited_working_directories_.insert(directory).second) {
+        for (const auto &[file_name, file_content] : memory_mapped_files_)
+            if (!llvm::sys::path::is_absolute(file_name))
+                inmemory_fs_->addFile(file_name, 0,
+                    llvm::MemoryBuffer::getMemBuffer(file_content));
+    }
 
-            inject_resource_dir(command_line, "clang_tool", &static_symbol);
+    // Wait until the translation unit fits in the memory limit
+    const auto memory_ticket = util::memory_budget::instance().admit(task_key);
 
-            ToolInvocation invocation(std::move(command_line), Action,
-                files_.get(), pch_container_ops_);
-            invocation.setDiagnosticConsumer(diag_consumer_.get());
+    const util::trace_span span{"translation unit", "parse",
+        {{"diagram", diagram_name_}, {"file", task_key}}};
+
+    ToolInvocation invocation(
+        std::move(command_line), action, files_.get(), pch_container_ops_);
+    invocation.setDiagnosticConsumer(diag_consumer_.get());
 #if LLVM_VERSION_MAJOR > 13
-            invocation.setDiagnosticOptions(diag_opts_.get());
+    invocation.setDiagnosticOptions(diag_opts_.get());
 #endif
 
-            if (!invocation.run() || diag_consumer_->failed) {
-                if (!initial_workdir.empty()) {
-                    if (const auto ec = overlay_fs_->setCurrentWorkingDirectory(
-                            initial_workdir);
-                        ec)
-                        if (!quiet_)
-                            LOG_ERROR("Error when trying to restore working "
-                                      "directory: {}",
-                                ec.message());
-                }
+    return invocation.run() && !diag_consumer_->failed;
+}
 
-                if (diag_consumer_ && diag_consumer_->failed) {
-                    if (!(diag_consumer_->diagnostics.empty())) {
-                        throw clang_tool_exception(diagram_type_, diagram_name_,
-                            diag_consumer_->diagnostics,
-                            to_string(diag_consumer_->diagnostics.back()));
-                    }
+std::unordered_map<std::string, std::string>
+clang_tool::make_unity_group_keys(
+    const std::vector<std::string> &tu_paths) const
+{
+    // Group translation units by their compile commands, without the
+    // translation unit file name. Files with several compile commands are
+    // always processed separately.
+    std::unordered_map<std::string, std::string> group_keys;
+    for (const auto &file : tu_paths) {
+        const auto compile_commands_for_file =
+            compilations_.getCompileCommands(file);
+        if (compile_commands_for_file.size() != 1)
+            continue;
 
-                    throw clang_tool_exception(diagram_type_, diagram_name_,
-                        diag_consumer_->diagnostics);
-                }
+        const auto &compile_command = compile_commands_for_file.front();
+        group_keys.emplace(file,
+            make_command_group_key(
+                compile_command, adjust_command_line(compile_command)));
+    }
 
-                throw std::runtime_error(
-                    fmt::format("Unknown error while processing {}", file));
-            }
+    return group_keys;
+}
 
-            if (diagram_type_ == common::model::diagram_t::kSequence)
-                break;
-        }
+bool clang_tool::run_unity_batch(
+    ToolAction *action, const std::vector<std::string> &batch)
+{
+    // All files in the batch have the same compile command, except for the
+    // file name
+    const auto compile_command =
+        compilations_.getCompileCommands(batch.front()).front();
+
+    // The unity translation unit is named after the files in the batch, so
+    // that its path identifies the batch in the memory budget across
+    // diagrams and runs
+    auto sorted_batch = batch;
+    std::sort(sorted_batch.begin(), sorted_batch.end());
+
+    util::hash64 batch_hash;
+    for (const auto &file : sorted_batch)
+        batch_hash.update(file).update({"\0", 1});
+
+    // Unity translation unit is created in the compile command directory,
+    // so that relative include paths resolve the same way
+    const auto extension =
+        std::filesystem::path{batch.front()}.extension().string();
+    const auto unity_tu_path =
+        (std::filesystem::path{compile_command.Directory} /
+            fmt::format("{}{:016x}{}", kUnityTranslationUnitPrefix,
+                batch_hash.digest(), extension))
+            .string();
+
+    std::string unity_tu_contents;
+    for (const auto &file : batch)
+        unity_tu_contents += fmt::format("#include \"{}\"\n", file);
+
+    inmemory_fs_->addFile(unity_tu_path, 0,
+        llvm::MemoryBuffer::getMemBufferCopy(unity_tu_contents, unity_tu_path));
+
+    const std::filesystem::path directory{compile_command.Directory};
+    const auto source_file =
+        (directory / compile_command.Filename).lexically_normal();
+
+    auto command_line = adjust_command_line(compile_command);
+    for (auto &arg : command_line) {
+        if ((directory / arg).lexically_normal() == source_file)
+            arg = unity_tu_path;
     }
 
-    if (!initial_workdir.empty()) {
-        if (const auto ec =
-                overlay_fs_->setCurrentWorkingDirectory(initial_workdir))
-            if (!quiet_)
-                LOG_ERROR("Error when trying to restore working dir: {}",
-                    ec.message());
-    }
+    if (!quiet_)
+        LOG_INFO("Processing diagram '{}' unity translation unit {} with {} "
+                 "files: {}",
+            diagram_name_, unity_tu_path, batch.size(),
+            fmt::join(batch, ", "));
+
+    const auto diagnostics_count = diag_consumer_->diagnostics.size();
+
+    if (run_invocation(compile_command.Directory, std::move(command_line),
+            action, unity_tu_path))
+        return true;
+
+    LOG_DBG("Failed to process unity translation unit {} in diagram '{}' - "
+            "falling back to separate translation units: {}",
+        unity_tu_path, diagram_name_,
+        diag_consumer_->diagnostics.size() > diagnostics_count
+            ? to_string(diag_consumer_->diagnostics.back())
+            : "unknown error");
+
+    diag_consumer_->failed = false;
+    diag_consumer_->diagnostics.resize(diagnostics_count);
+
+    return false;
 }
 } // namespace clanguml::generators
 
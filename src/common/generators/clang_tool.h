@@ -23,6 +23,11 @@
 #include "common/compilation_database.h"
 #include "common/model/source_location.h"
 
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
 namespace clanguml::generators {
 
 using namespace clang;
@@ -37,6 +42,69 @@ struct diagnostic {
 
 std::string to_string(const diagnostic &d);
 
+/**
+ * @brief Compute hash of an adjusted compile command
+ *
+ * Compile commands of a translation unit with equal hashes produce the
+ * same AST, so only one of them has to be parsed.
+ *
+ * @param directory Working directory of the compile command
+ * @param command_line Adjusted command line
+ * @param semantic If true, warning and diagnostic output flags are ignored
+ * @return Compile command hash
+ */
+uint64_t compile_command_hash(const std::string &directory,
+    const CommandLineArguments &command_line, bool semantic);
+
+/**
+ * @brief Merge compile commands of a translation unit into a single command
+ *
+ * Include paths and macro definitions from the other compile commands,
+ * which are missing from the first one, are added to the first command.
+ * Relative include paths of the other commands are made absolute. If the
+ * commands define a macro differently, the definition from the first
+ * command which defines it is used.
+ *
+ * @param commands Compile commands of a single translation unit
+ * @return Command line of the first command with merged options
+ */
+CommandLineArguments merge_compile_commands(
+    const std::vector<CompileCommand> &commands);
+
+/**
+ * @brief Prefix of the file names of unity translation units
+ */
+constexpr std::string_view kUnityTranslationUnitPrefix{"clang-uml-unity-"};
+
+/**
+ * @brief Split translation units into unity batches
+ *
+ * Translation units with the same compile command group key are split, in
+ * their original order, into batches of at most `batch_size` files.
+ * Translation units missing from `group_keys` form batches with a single
+ * translation unit, which have to be processed separately.
+ *
+ * @param tu_paths List of translation units
+ * @param group_keys Map of translation units, which can be batched, to
+ *                   their compile commands without the file name
+ * @param batch_size Maximum number of files in a batch
+ * @return Batches of translation units, ordered by the position of their
+ *         first translation unit in `tu_paths`
+ */
+std::vector<std::vector<std::string>> make_unity_batches(
+    const std::vector<std::string> &tu_paths,
+    const std::unordered_map<std::string, std::string> &group_keys,
+    unsigned batch_size);
+
+/**
+ * @brief Check if the path refers to a unity translation unit
+ *
+ * @param path Path of the translation unit
+ * @return True, if the translation unit was generated by @ref clang_tool
+ *         for a unity batch
+ */
+bool is_unity_translation_unit(const std::string &path);
+
 void to_json(nlohmann::json &j, const diagnostic &a);
 
 class clang_tool_exception : public error::diagram_generation_error {
@@ -79,14 +147,92 @@ public:
 
     void append_arguments_adjuster(clang::tooling::ArgumentsAdjuster Adjuster);
 
+    /**
+     * @brief Do not use precompiled preambles, even if they are enabled
+     *
+     * This is necessary for actions, which rely on preprocessor callbacks
+     * for all includes in the translation unit.
+     */
+    void disable_precompiled_preambles();
+
+    /**
+     * @brief Set the number of source files parsed as a single translation
+     *        unit
+     *
+     * If larger than 1, source files with the same compile command are
+     * included in batches by in-memory unity translation units. Files from
+     * batches, which fail to compile, are parsed separately.
+     *
+     * @param batch_size Maximum number of source files in a unity
+     *                   translation unit
+     */
+    void set_unity_batch_size(unsigned batch_size);
+
     void run(ToolAction *Action);
 
 private:
+    /**
+     * @brief Apply arguments adjusters to a compile command
+     *
+     * @param compile_command Compile command
+     * @return Adjusted command line
+     */
+    CommandLineArguments adjust_command_line(
+        const CompileCommand &compile_command) const;
+
+    /**
+     * @brief Run the action for a single compiler invocation
+     *
+     * @param directory Working directory of the compile command
+     * @param command_line Adjusted command line
+     * @param action Tool action
+     * @param task_key Key identifying the invocation in the memory budget
+     * @return True, if the invocation succeeded without errors
+     */
+    bool run_invocation(const std::string &directory,
+        CommandLineArguments command_line, ToolAction *action,
+        const std::string &task_key);
+
+    /**
+     * @brief Run the action for all compile commands of a translation unit
+     *
+     * @param action Tool action
+     * @param file Absolute path of the translation unit
+     * @param initial_workdir Working directory restored on error
+     */
+    void run_translation_unit(ToolAction *action, const std::string &file,
+        const std::string &initial_workdir);
+
+    /**
+     * @brief Group translation units, which can be batched in unity
+     *        translation units, by their compile commands
+     *
+     * @param tu_paths Absolute paths of translation units
+     * @return Map of translation units to their compile command group keys
+     */
+    std::unordered_map<std::string, std::string> make_unity_group_keys(
+        const std::vector<std::string> &tu_paths) const;
+
+    /**
+     * @brief Run the action for source files batched in a unity
+     *        translation unit
+     *
+     * @param action Tool action
+     * @param batch Absolute paths of translation units with the same
+     *              compile command
+     * @return True, if the unity translation unit was processed without
+     *         errors
+     */
+    bool run_unity_batch(
+        ToolAction *action, const std::vector<std::string> &batch);
+
     const common::model::diagram_t diagram_type_;
     const std::string diagram_name_;
     const clanguml::common::compilation_database &compilations_;
     std::vector<std::string> source_paths_;
     bool quiet_;
+    bool precompiled_preambles_{true};
+    unsigned unity_batch_size_{0};
 
     std::shared_ptr<PCHContainerOperations> pch_container_ops_;
 
@@ -0,0 +1,222 @@
+/**
+ * @file src/common/generators/diagram_renderer.cc
+ *
+ * Copyright (c) 2021-2025 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "diagram_renderer.h"
+
+#include "util/logging.h"
+#include "util/trace.h"
+#include "util/util.h"
+
+#include <algorithm>
+
+namespace clanguml::common::generators {
+
+diagram_renderer::diagram_renderer(unsigned int jobs, unsigned int batch_size,
+    std::chrono::milliseconds batch_delay)
+    : batch_size_{batch_size}
+    , batch_delay_{batch_delay}
+{
+    if (jobs == 0U)
+        jobs = std::thread::hardware_concurrency();
+
+    if (jobs == 0U)
+        jobs = 1U;
+
+    for (auto i = 0U; i < jobs; i++) {
+        threads_.emplace_back(&diagram_renderer::worker, this);
+    }
+}
+
+diagram_renderer::~diagram_renderer() { wait(); }
+
+void diagram_renderer::add(render_task &&task)
+{
+    std::unique_lock<std::mutex> l(mutex_);
+
+    if (done_)
+        throw std::runtime_error(
+            fmt::format("Cannot render diagram '{}' - renderer already stopped",
+                task.diagram_name));
+
+    tasks_.push_back({std::move(task), clock::now()});
+
+    l.unlock();
+    cond_.notify_all();
+}
+
+std::vector<std::exception_ptr> diagram_renderer::wait()
+{
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        done_ = true;
+    }
+    cond_.notify_all();
+
+    for (auto &thread : threads_) {
+        if (thread.joinable())
+            thread.join();
+    }
+
+    std::lock_guard<std::mutex> l(mutex_);
+    return std::move(errors_);
+}
+
+size_t diagram_renderer::invocation_count() const
+{
+    std::lock_guard<std::mutex> l(mutex_);
+    return invocation_count_;
+}
+
+std::string diagram_renderer::make_batch_command(
+    std::string batch_cmd, const std::vector<render_task> &batch)
+{
+    std::vector<std::string> paths;
+    paths.reserve(batch.size());
+    for (const auto &task : batch) {
+        paths.emplace_back(fmt::format("\"{}\"", task.path.string()));
+    }
+
+    util::replace_all(batch_cmd, "{}", util::join(paths, " "));
+
+    return batch_cmd;
+}
+
+void diagram_renderer::worker()
+{
+    while (true) {
+        auto batch = next_batch();
+
+        if (batch.empty())
+            return;
+
+        try {
+            render(batch);
+        }
+        catch (std::exception &) {
+            std::lock_guard<std::mutex> l(mutex_);
+            errors_.emplace_back(std::current_exception());
+        }
+    }
+}
+
+std::vector<render_task> diagram_renderer::next_batch()
+{
+    std::unique_lock<std::mutex> l(mutex_);
+
+    std::vector<render_task> batch;
+
+    while (true) {
+        cond_.wait(l, [this] { return done_ || !tasks_.empty(); });
+
+        if (tasks_.empty())
+            return batch;
+
+        if (tasks_.front().task.batch_cmd.empty() || done_)
+            break;
+
+        // Wait for more files rendered by the same batch command, until the
+        // batch is full or the oldest pending task has waited long enough
+        const auto deadline = tasks_.front().added + batch_delay_;
+        const auto ready = [this] {
+            return done_ || tasks_.empty() ||
+                tasks_.front().task.batch_cmd.empty() ||
+                (batch_size_ > 0 &&
+                    pending_batch_size(tasks_.front().task) >= batch_size_);
+        };
+
+        cond_.wait_until(l, deadline, ready);
+
+        // Another worker could have taken the tasks in the meantime
+        if (!tasks_.empty())
+            break;
+    }
+
+    batch.emplace_back(std::move(tasks_.front().task));
+    tasks_.pop_front();
+
+    if (batch.front().batch_cmd.empty())
+        return batch;
+
+    // Collect all pending tasks which can be rendered with the same batch
+    // command (copied, as adding tasks to the batch invalidates its front)
+    const auto generator_type = batch.front().generator_type;
+    const auto batch_cmd = batch.front().batch_cmd;
+    for (auto it = tasks_.begin(); it != tasks_.end();) {
+        if (batch_size_ > 0 && batch.size() >= batch_size_)
+            break;
+
+        if (it->task.generator_type == generator_type &&
+            it->task.batch_cmd == batch_cmd) {
+            batch.emplace_back(std::move(it->task));
+            it = tasks_.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+
+    return batch;
+}
+
+size_t diagram_renderer::pending_batch_size(const render_task &task) const
+{
+    return std::count_if(tasks_.begin(), tasks_.end(), [&task](const auto &t) {
+        return t.task.generator_type == task.generator_type &&
+            t.task.batch_cmd == task.batch_cmd;
+    });
+}
+
+void diagram_renderer::render(const std::vector<render_task> &batch)
+{
+    assert(!batch.empty());
+
+    const auto &first = batch.front();
+
+    const util::trace_span span{"renderer", "render",
+        {{"diagram", first.diagram_name},
+            {"format", to_string(first.generator_type)}}};
+
+    std::string cmd;
+    if (first.batch_cmd.empty()) {
+        cmd = first.cmd;
+        util::replace_all(cmd, "{}", first.diagram_name);
+
+        LOG_INFO("Rendering diagram {} using {}", first.diagram_name,
+            to_string(first.generator_type));
+    }
+    else {
+        cmd = make_batch_command(first.batch_cmd, batch);
+
+        std::vector<std::string> names;
+        names.reserve(batch.size());
+        for (const auto &task : batch)
+            names.emplace_back(task.diagram_name);
+
+        LOG_INFO("Rendering {} diagrams [{}] using {}", batch.size(),
+            fmt::join(names, ", "), to_string(first.generator_type));
+    }
+
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        invocation_count_++;
+    }
+
+    util::check_process_output(cmd);
+}
+
+} // namespace clanguml::common::generators
@@ -0,0 +1,160 @@
+/**
+ * @file src/common/generators/diagram_renderer.h
+ *
+ * Copyright (c) 2021-2025 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "common/types.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace clanguml::common::generators {
+
+/**
+ * @brief Single diagram file scheduled for rendering
+ */
+struct render_task {
+    /*! Generator which produced the diagram source file */
+    generator_type_t generator_type;
+    /*! Name of the diagram */
+    std::string diagram_name;
+    /*! Per-diagram command template, `{}` is replaced with diagram name */
+    std::string cmd;
+    /*! Batch command template, `{}` is replaced with quoted file paths */
+    std::string batch_cmd;
+    /*! Path to the generated diagram source file */
+    std::filesystem::path path;
+};
+
+/**
+ * @brief Renders generated diagram sources to images using external tools
+ *
+ * Diagram tasks add generated `.puml` or `.mmd` files to the renderer as
+ * soon as they are written, and a bounded pool of worker threads renders
+ * them in parallel with the remaining diagram generation.
+ *
+ * Tasks with a `batch_cmd` are grouped, so that all pending files rendered
+ * by the same batch command are passed to a single renderer process (e.g.
+ * to avoid starting a new JVM for each PlantUML diagram). A batch is only
+ * started when it is full, when the oldest of its tasks has been waiting for
+ * the batch delay or when the renderer is stopped, otherwise idle workers
+ * would start a new process for each file as soon as it is added. Tasks
+ * without a `batch_cmd` are rendered one by one using their `cmd` template.
+ */
+class diagram_renderer {
+public:
+    /** Default time a batchable task waits for other tasks to join it */
+    static constexpr std::chrono::milliseconds kDefaultBatchDelay{500};
+
+    /**
+     * @brief Constructor
+     *
+     * @param jobs Maximum number of renderer processes running in parallel
+     * @param batch_size Maximum number of files in a single batch, 0 means
+     *                   no limit
+     * @param batch_delay Maximum time a batchable task waits for other tasks
+     *                    before its batch is rendered
+     */
+    diagram_renderer(unsigned int jobs, unsigned int batch_size,
+        std::chrono::milliseconds batch_delay = kDefaultBatchDelay);
+
+    diagram_renderer(const diagram_renderer &) = delete;
+    diagram_renderer(diagram_renderer &&) = delete;
+    diagram_renderer &operator=(const diagram_renderer &) = delete;
+    diagram_renderer &operator=(diagram_renderer &&) = delete;
+
+    ~diagram_renderer();
+
+    /**
+     * @brief Schedule diagram file for rendering
+     *
+     * @param task Render task
+     */
+    void add(render_task &&task);
+
+    /**
+     * @brief Wait until all scheduled diagrams are rendered
+     *
+     * After this method returns no more tasks can be added.
+     *
+     * @return List of errors reported by the renderer processes
+     */
+    std::vector<std::exception_ptr> wait();
+
+    /**
+     * @brief Number of renderer processes executed so far
+     *
+     * @return Number of invocations
+     */
+    size_t invocation_count() const;
+
+    /**
+     * @brief Create batch render command for a list of tasks
+     *
+     * @param batch_cmd Batch command template
+     * @param batch List of tasks to render
+     * @return Command to execute
+     */
+    static std::string make_batch_command(
+        std::string batch_cmd, const std::vector<render_task> &batch);
+
+private:
+    using clock = std::chrono::steady_clock;
+
+    struct pending_task {
+        render_task task;
+        clock::time_point added;
+    };
+
+    void worker();
+
+    /**
+     * @brief Take next set of tasks which can be rendered together
+     *
+     * @return Tasks to render, empty if renderer has been stopped
+     */
+    std::vector<render_task> next_batch();
+
+    /**
+     * @brief Number of pending tasks rendered by the same command as task
+     *
+     * @param task Render task with a batch command
+     * @return Number of pending tasks
+     */
+    size_t pending_batch_size(const render_task &task) const;
+
+    void render(const std::vector<render_task> &batch);
+
+    unsigned int batch_size_;
+    std::chrono::milliseconds batch_delay_;
+    bool done_{false};
+    size_t invocation_count_{0};
+    std::deque<pending_task> tasks_;
+    std::vector<std::exception_ptr> errors_;
+    mutable std::mutex mutex_;
+    std::condition_variable cond_;
+    std::vector<std::thread> threads_;
+};
+
+} // namespace clanguml::common::generators
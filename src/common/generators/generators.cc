@@ -18,7 +18,11 @@
 
 #include "generators.h"
 
+#include "caching_file_system.h"
+#include "preamble_cache.h"
 #include "progress_indicator.h"
+#include "util/memory_budget.h"
+#include "util/trace.h"
 
 namespace clanguml::common::generators {
 void make_context_source_relative(
@@ -49,15 +53,19 @@ void find_translation_units_for_diagrams(
     const compilation_database &compilation_database,
     std::map<std::string, std::vector<std::string>> &translation_units_map)
 {
+    const util::trace_span span{"config", "resolve globs"};
+
+    // Glob expansions and file system lookups are shared by all diagrams
+    config::translation_unit_index index{compilation_database.getAllFiles()};
+
     for (const auto &[name, diagram] : config.diagrams) {
         // If there are any specific diagram names provided on the command line,
         // and this diagram is not in that list - skip it
         if (!diagram_names.empty() && !util::contains(diagram_names, name))
             continue;
 
-        translation_units_map[name] =
-            diagram->glob_translation_units(compilation_database.getAllFiles(),
-                compilation_database.is_fixed());
+        translation_units_map[name] = diagram->glob_translation_units(
+            index, compilation_database.is_fixed());
 
         LOG_DBG("Found {} translation units for diagram '{}'",
             translation_units_map.at(name).size(), name);
@@ -65,31 +73,48 @@ void find_translation_units_for_diagrams(
 }
 
 void render_diagram(const clanguml::common::generator_type_t generator_type,
-    std::shared_ptr<config::diagram> diagram_config)
+    std::shared_ptr<config::diagram> diagram_config,
+    const std::string &output_directory, diagram_renderer *renderer)
 {
-    std::string cmd;
+    render_task task;
+    task.generator_type = generator_type;
+    task.diagram_name = diagram_config->name;
+
+    std::string extension;
     switch (generator_type) {
     case clanguml::common::generator_type_t::plantuml:
-        cmd = diagram_config->puml().cmd;
+        task.cmd = diagram_config->puml().cmd;
+        task.batch_cmd = diagram_config->puml().batch_cmd;
+        extension = plantuml_generator_tag::extension;
         break;
     case clanguml::common::generator_type_t::mermaid:
-        cmd = diagram_config->mermaid().cmd;
+        task.cmd = diagram_config->mermaid().cmd;
+        task.batch_cmd = diagram_config->mermaid().batch_cmd;
+        extension = mermaid_generator_tag::extension;
         break;
     default:
         return;
     };
 
-    if (cmd.empty())
+    if (task.cmd.empty() && task.batch_cmd.empty())
         throw std::runtime_error(
             fmt::format("No render command template provided for {} diagrams",
                 to_string(diagram_config->type())));
 
-    util::replace_all(cmd, "{}", diagram_config->name);
+    task.path = std::filesystem::path{output_directory} /
+        fmt::format("{}.{}", diagram_config->name, extension);
 
-    LOG_INFO("Rendering diagram {} using {}", diagram_config->name,
-        to_string(generator_type));
+    if (renderer != nullptr) {
+        renderer->add(std::move(task));
+        return;
+    }
 
-    util::check_process_output(cmd);
+    // Without a shared renderer, render the diagram synchronously
+    diagram_renderer local_renderer{1, 0};
+    local_renderer.add(std::move(task));
+    auto errors = local_renderer.wait();
+    if (!errors.empty())
+        std::rethrow_exception(errors.front());
 }
 
 namespace detail {
@@ -103,6 +128,8 @@ void generate_diagram_select_generator(const std::string &od,
         typename diagram_generator_t<DiagramConfig, GeneratorTag>::type;
 
     if constexpr (!std::is_same_v<diagram_generator, not_supported>) {
+        const util::trace_span span{"generator", "generate output",
+            {{"diagram", name}, {"format", GeneratorTag::extension}}};
 
         std::stringstream buffer;
         buffer << diagram_generator(
@@ -131,16 +158,28 @@ void generate_diagram_impl(const std::string &name,
     std::shared_ptr<clanguml::config::diagram> diagram,
     const common::compilation_database &db,
     const std::vector<std::string> &translation_units,
-    const cli::runtime_config &runtime_config, std::function<void()> &&progress)
+    const cli::runtime_config &runtime_config, std::function<void()> &&progress,
+    diagram_renderer *renderer)
 {
     using diagram_config = DiagramConfig;
     using diagram_model = typename diagram_model_t<DiagramConfig>::type;
     using diagram_visitor = typename diagram_visitor_t<DiagramConfig>::type;
 
+    const util::trace_span span{"diagram", "diagram", {{"diagram", name}}};
+
+    std::optional<memory_report> report;
+    if (runtime_config.memory_report) {
+        report.emplace();
+        report->diagram_name = name;
+        report->diagram_type = common::model::to_string(diagram->type());
+        report->sample("start");
+    }
+
     auto model = clanguml::common::generators::generate<diagram_model,
         diagram_config, diagram_visitor>(db, diagram->name,
         dynamic_cast<diagram_config &>(*diagram), translation_units,
-        runtime_config.verbose, std::move(progress));
+        runtime_config.verbose, std::move(progress),
+        report ? &*report : nullptr);
 
     if constexpr (std::is_same_v<DiagramConfig, config::sequence_diagram>) {
         if (runtime_config.print_from) {
@@ -201,12 +240,22 @@ void generate_diagram_impl(const std::string &name,
                 runtime_config.output_directory, name, diagram, model);
         }
 
+        if (report)
+            report->sample(
+                fmt::format("generate {}", to_string(generator_type)));
+
         // Convert plantuml or mermaid to an image using command provided
         // in the command line arguments
         if (runtime_config.render_diagrams) {
-            render_diagram(generator_type, diagram);
+            render_diagram(generator_type, diagram,
+                runtime_config.output_directory, renderer);
         }
     }
+
+    if (report) {
+        model->estimate_memory_usage(report->model_usage);
+        memory_report_registry::instance().add(std::move(*report));
+    }
 }
 } // namespace detail
 
@@ -214,7 +263,8 @@ void generate_diagram(const std::string &name,
     std::shared_ptr<clanguml::config::diagram> diagram,
     const common::compilation_database &db,
     const std::vector<std::string> &translation_units,
-    const cli::runtime_config &runtime_config, std::function<void()> &&progress)
+    const cli::runtime_config &runtime_config, std::function<void()> &&progress,
+    diagram_renderer *renderer)
 {
     using clanguml::common::generator_type_t;
     using clanguml::common::model::diagram_t;
@@ -226,19 +276,19 @@ void generate_diagram(const std::string &name,
 
     if (diagram->type() == diagram_t::kClass) {
         detail::generate_diagram_impl<class_diagram>(name, diagram, db,
-            translation_units, runtime_config, std::move(progress));
+            translation_units, runtime_config, std::move(progress), renderer);
     }
     else if (diagram->type() == diagram_t::kSequence) {
         detail::generate_diagram_impl<sequence_diagram>(name, diagram, db,
-            translation_units, runtime_config, std::move(progress));
+            translation_units, runtime_config, std::move(progress), renderer);
     }
     else if (diagram->type() == diagram_t::kPackage) {
         detail::generate_diagram_impl<package_diagram>(name, diagram, db,
-            translation_units, runtime_config, std::move(progress));
+            translation_units, runtime_config, std::move(progress), renderer);
     }
     else if (diagram->type() == diagram_t::kInclude) {
         detail::generate_diagram_impl<include_diagram>(name, diagram, db,
-            translation_units, runtime_config, std::move(progress));
+            translation_units, runtime_config, std::move(progress), renderer);
     }
 }
 
@@ -251,6 +301,31 @@ int generate_diagrams(const std::vector<std::string> &diagram_names,
     util::thread_pool_executor generator_executor{runtime_config.thread_count};
     std::vector<std::future<void>> futs;
 
+    constexpr uint64_t kMiB{1024ULL * 1024ULL};
+
+    auto &file_cache = clanguml::generators::file_system_cache::instance();
+    if (runtime_config.file_cache_limit)
+        file_cache.set_size_limit(*runtime_config.file_cache_limit * kMiB);
+
+    if (runtime_config.memory_limit) {
+        util::memory_budget::instance().set_limit(
+            *runtime_config.memory_limit * kMiB);
+    }
+
+    auto &preambles = clanguml::generators::preamble_cache::instance();
+    if (runtime_config.precompiled_preambles)
+        preambles.enable(runtime_config.preamble_directory);
+
+    // Diagrams are rendered by a separate pool of renderer processes,
+    // overlapping with generation of the remaining diagrams
+    std::unique_ptr<diagram_renderer> renderer;
+    if (runtime_config.render_diagrams) {
+        renderer = std::make_unique<diagram_renderer>(
+            runtime_config.render_jobs > 0 ? runtime_config.render_jobs
+                                           : runtime_config.thread_count,
+            runtime_config.render_batch_size);
+    }
+
     std::unique_ptr<progress_indicator_base> indicator;
 
     if (runtime_config.progress) {
@@ -344,24 +419,27 @@ int generate_diagrams(const std::vector<std::string> &diagram_names,
         auto generator = [&name = name, &diagram = diagram, &indicator,
                              db = std::ref(*db), matching_commands_count,
                              translation_units = valid_translation_units,
-                             runtime_config]() mutable -> void {
+                             runtime_config,
+                             renderer = renderer.get()]() mutable -> void {
             try {
                 if (indicator) {
                     indicator->add_progress_bar(name, matching_commands_count,
                         diagram_type_to_color(diagram->type()));
 
-                    generate_diagram(name, diagram, db, translation_units,
-                        runtime_config, [&indicator, &name]() {
+                    generate_diagram(
+                        name, diagram, db, translation_units, runtime_config,
+                        [&indicator, &name]() {
                             if (indicator)
                                 indicator->increment(name);
-                        });
+                        },
+                        renderer);
 
                     if (indicator)
                         indicator->complete(name);
                 }
                 else {
                     generate_diagram(name, diagram, db, translation_units,
-                        runtime_config, {});
+                        runtime_config, {}, renderer);
                 }
             }
             catch (clanguml::generators::clang_tool_exception &e) {
@@ -393,6 +471,26 @@ int generate_diagrams(const std::vector<std::string> &diagram_names,
         }
     }
 
+    if (renderer) {
+        auto render_errors = renderer->wait();
+        std::move(render_errors.begin(), render_errors.end(),
+            std::back_inserter(errors));
+    }
+
+    const auto file_cache_stats = file_cache.stats();
+    LOG_DBG("File system cache: {} status hits, {} status misses, {} content "
+            "hits, {} content misses, {} files cached ({} bytes)",
+        file_cache_stats.status_hits, file_cache_stats.status_misses,
+        file_cache_stats.contents_hits, file_cache_stats.contents_misses,
+        file_cache_stats.contents_count, file_cache_stats.contents_size);
+
+    if (preambles.enabled()) {
+        const auto preamble_stats = preambles.stats();
+        LOG_DBG("Precompiled preambles: {} built, {} failed, {} reused",
+            preamble_stats.built, preamble_stats.failed,
+            preamble_stats.reused);
+    }
+
     if (runtime_config.progress &&
         clanguml::logging::logger_type() == logging::logger_type_t::text) {
         indicator->stop();
@@ -405,6 +503,14 @@ int generate_diagrams(const std::vector<std::string> &diagram_names,
         std::cout << termcolor::reset;
     }
 
+    if (runtime_config.memory_report) {
+        const auto &reports = memory_report_registry::instance();
+        if (clanguml::logging::logger_type() == logging::logger_type_t::text)
+            std::cout << reports.to_string();
+        else
+            std::cout << reports.to_json().dump();
+    }
+
     if (errors.empty())
         return 0;
 
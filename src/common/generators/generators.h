@@ -24,6 +24,9 @@
 #include "cli/cli_handler.h"
 #include "common/compilation_database.h"
 #include "common/generators/clang_tool.h"
+#include "common/generators/diagram_renderer.h"
+#include "common/generators/memory_report.h"
+#include "common/generators/translation_unit_cover.h"
 #include "common/model/filters/diagram_filter_factory.h"
 #include "config/config.h"
 #include "include_diagram/generators/graphml/include_diagram_generator.h"
@@ -38,6 +41,8 @@
 #include "sequence_diagram/generators/json/sequence_diagram_generator.h"
 #include "sequence_diagram/generators/mermaid/sequence_diagram_generator.h"
 #include "sequence_diagram/generators/plantuml/sequence_diagram_generator.h"
+#include "util/memory_budget.h"
+#include "util/trace.h"
 #include "util/util.h"
 
 #include <clang/Frontend/CompilerInstance.h>
@@ -283,18 +288,89 @@ class diagram_ast_consumer : public clang::ASTConsumer {
 
 public:
     explicit diagram_ast_consumer(clang::CompilerInstance &ci,
-        DiagramModel &diagram, const DiagramConfig &config)
+        DiagramModel &diagram, const DiagramConfig &config,
+        uint64_t &skipped_declarations)
         : visitor_{ci.getSourceManager(), diagram, config}
+        , source_manager_{ci.getSourceManager()}
+        , skipped_declarations_{skipped_declarations}
+        , skip_function_bodies_{config.function_bodies_to_skip()}
     {
     }
 
     TranslationUnitVisitor &visitor() { return visitor_; }
 
+    /**
+     * @brief Decide whether the parser can skip a function body
+     *
+     * This is only called when skipping of function bodies is enabled in the
+     * frontend options (Sema never skips bodies of constexpr functions or
+     * functions with deduced return types).
+     *
+     * @param decl Function declaration
+     * @return True, if the function body can be skipped
+     */
+    bool shouldSkipFunctionBody(clang::Decl *decl) override
+    {
+        using clanguml::config::skip_function_bodies_t;
+
+        if (skip_function_bodies_ == skip_function_bodies_t::outside_main_file)
+            return !source_manager_.isInMainFile(
+                source_manager_.getExpansionLoc(decl->getLocation()));
+
+        return skip_function_bodies_ == skip_function_bodies_t::always;
+    }
+
     void HandleTranslationUnit(clang::ASTContext &ast_context) override
     {
-        visitor_.TraverseDecl(ast_context.getTranslationUnitDecl());
-        visitor_.finalize();
+        // Memory usage is usually the highest right after parsing
+        util::memory_budget::instance().sample();
+
+        // Translation units with errors fail the diagram generation, except
+        // for unity translation units, whose files are then parsed again
+        // separately, so they must not be added to the diagram
+        if (ast_context.getDiagnostics().hasErrorOccurred()) {
+            LOG_DBG("Skipping translation unit with errors");
+            return;
+        }
+
+        if constexpr (std::is_same_v<DiagramModel,
+                          clanguml::include_diagram::model::diagram>) {
+            {
+                const util::trace_span span{"translation unit", "visit"};
+                visitor_.TraverseDecl(ast_context.getTranslationUnitDecl());
+            }
+
+            const util::trace_span span{"translation unit", "finalize"};
+            visitor_.finalize();
+        }
+        else {
+            // Cache printed type and declaration names until the end of
+            // the translation unit
+            common::printing_cache::scope printing_cache_scope{
+                visitor_.printing_cache(), ast_context};
+
+            {
+                const util::trace_span span{"translation unit", "visit"};
+                visitor_.TraverseDecl(ast_context.getTranslationUnitDecl());
+            }
+
+            {
+                const util::trace_span span{"translation unit", "finalize"};
+                visitor_.finalize();
+            }
+
+            LOG_TRACE("Skipped traversal of {} declarations excluded by "
+                      "diagram filters",
+                visitor_.skipped_declarations());
+
+            skipped_declarations_ += visitor_.skipped_declarations();
+        }
     }
+
+private:
+    const clang::SourceManager &source_manager_;
+    uint64_t &skipped_declarations_;
+    const clanguml::config::skip_function_bodies_t skip_function_bodies_;
 };
 
 /**
@@ -313,10 +389,12 @@ template <typename DiagramModel, typename DiagramConfig,
 class diagram_fronted_action : public clang::ASTFrontendAction {
 public:
     explicit diagram_fronted_action(DiagramModel &diagram,
-        const DiagramConfig &config, std::function<void()> progress)
+        const DiagramConfig &config, std::function<void()> progress,
+        uint64_t &skipped_declarations)
         : diagram_{diagram}
         , config_{config}
         , progress_{std::move(progress)}
+        , skipped_declarations_{skipped_declarations}
     {
     }
 
@@ -325,11 +403,14 @@ public:
     {
         auto ast_consumer = std::make_unique<
             diagram_ast_consumer<DiagramModel, DiagramConfig, DiagramVisitor>>(
-            CI, diagram_, config_);
+            CI, diagram_, config_, skipped_declarations_);
 
         if constexpr (!std::is_same_v<DiagramModel,
                           clanguml::include_diagram::model::diagram>) {
             ast_consumer->visitor().set_tu_path(getCurrentFile().str());
+            ast_consumer->visitor().set_unity_translation_unit(
+                clanguml::generators::is_unity_translation_unit(
+                    getCurrentFile().str()));
         }
 
         return ast_consumer;
@@ -345,6 +426,10 @@ protected:
         if (progress_)
             progress_();
 
+        if (config_.function_bodies_to_skip() !=
+            clanguml::config::skip_function_bodies_t::never)
+            ci.getFrontendOpts().SkipFunctionBodies = true;
+
         if constexpr (std::is_same_v<DiagramModel,
                           clanguml::include_diagram::model::diagram>) {
             auto find_includes_callback =
@@ -363,6 +448,7 @@ private:
     DiagramModel &diagram_;
     const DiagramConfig &config_;
     std::function<void()> progress_;
+    uint64_t &skipped_declarations_;
 };
 
 /**
@@ -392,13 +478,22 @@ public:
     std::unique_ptr<clang::FrontendAction> create() override
     {
         return std::make_unique<diagram_fronted_action<DiagramModel,
-            DiagramConfig, DiagramVisitor>>(diagram_, config_, progress_);
+            DiagramConfig, DiagramVisitor>>(
+            diagram_, config_, progress_, skipped_declarations_);
     }
 
+    /**
+     * @brief Get number of declarations skipped by traversal pruning
+     *
+     * @return Total number of skipped declarations in all translation units
+     */
+    uint64_t skipped_declarations() const { return skipped_declarations_; }
+
 private:
     DiagramModel &diagram_;
     const DiagramConfig &config_;
     std::function<void()> progress_;
+    uint64_t skipped_declarations_{0};
 };
 
 /**
@@ -413,16 +508,22 @@ private:
  * @tparam DiagramModel Type of diagram_model
  * @tparam DiagramConfig Type of diagram_config
  * @tparam TranslationUnitVisitor Type of translation_unit_visitor
+ *
+ * @param report Memory report sampled after parsing and finalizing the
+ *               diagram model, if not null
  */
 template <typename DiagramModel, typename DiagramConfig,
     typename DiagramVisitor>
 std::unique_ptr<DiagramModel> generate(const common::compilation_database &db,
     const std::string &name, DiagramConfig &config,
     const std::vector<std::string> &translation_units, bool /*verbose*/ = false,
-    std::function<void()> progress = {})
+    std::function<void()> progress = {}, memory_report *report = nullptr)
 {
     LOG_INFO("Generating diagram {}", name);
 
+    const util::trace_span span{
+        "diagram", "generate model", {{"diagram", name}}};
+
     auto diagram = std::make_unique<DiagramModel>();
     diagram->set_name(name);
     diagram->set_filter(
@@ -431,10 +532,29 @@ std::unique_ptr<DiagramModel> generate(const common::compilation_database &db,
     LOG_DBG("Found translation units for diagram {}: {}", name,
         fmt::join(translation_units, ", "));
 
+    // Only parse translation units needed to cover all files accepted by
+    // the diagram filters
+    std::vector<std::string> covering_translation_units;
+    const bool use_covering_translation_units =
+        config.minimal_translation_units() &&
+        (diagram->type() == model::diagram_t::kClass ||
+            diagram->type() == model::diagram_t::kPackage);
+    if (use_covering_translation_units) {
+        covering_translation_units =
+            clanguml::generators::find_covering_translation_units(
+                db, config, *diagram, translation_units);
+    }
+
     const bool quiet_clang_tool = !!progress;
 
     clanguml::generators::clang_tool clang_tool(diagram->type(), name, db,
-        translation_units, config.get_relative_to()(), quiet_clang_tool);
+        use_covering_translation_units ? covering_translation_units
+                                       : translation_units,
+        config.get_relative_to()(), quiet_clang_tool);
+
+    if (diagram->type() == model::diagram_t::kClass ||
+        diagram->type() == model::diagram_t::kPackage)
+        clang_tool.set_unity_batch_size(config.unity_batch_size());
 
     auto action_factory =
         std::make_unique<diagram_action_visitor_factory<DiagramModel,
@@ -443,9 +563,26 @@ std::unique_ptr<DiagramModel> generate(const common::compilation_database &db,
 
     clang_tool.run(action_factory.get());
 
+    if (report != nullptr)
+        report->sample("parse");
+
+    if constexpr (!std::is_same_v<DiagramModel,
+                      clanguml::include_diagram::model::diagram>) {
+        LOG_DBG("Skipped traversal of {} declarations excluded by filters "
+                "in diagram {}",
+            action_factory->skipped_declarations(), name);
+    }
+
     diagram->set_complete(true);
 
-    diagram->finalize();
+    {
+        const util::trace_span finalize_span{
+            "diagram", "finalize", {{"diagram", name}}};
+        diagram->finalize();
+    }
+
+    if (report != nullptr)
+        report->sample("finalize");
 
     return diagram;
 }
@@ -460,13 +597,15 @@ std::unique_ptr<DiagramModel> generate(const common::compilation_database &db,
  * @param generators List of generator types to be used for the diagram
  * @param verbose Log level
  * @param progress Function to report translation unit progress
+ * @param renderer Shared diagram renderer, if null diagrams are rendered
+ *                 synchronously
  */
 void generate_diagram(const std::string &name,
     std::shared_ptr<clanguml::config::diagram> diagram,
     const common::compilation_database &db,
     const std::vector<std::string> &translation_units,
-    const cli::runtime_config &runtime_config,
-    std::function<void()> &&progress);
+    const cli::runtime_config &runtime_config, std::function<void()> &&progress,
+    diagram_renderer *renderer = nullptr);
 
 /**
  * @brief Generate diagrams
@@ -0,0 +1,144 @@
+/**
+ * @file src/common/generators/memory_report.cc
+ *
+ * Copyright (c) 2021-2025 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "memory_report.h"
+
+#include "util/memory_budget.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <iterator>
+
+namespace clanguml::common::generators {
+
+namespace {
+constexpr uint64_t kKiB{1024ULL};
+constexpr uint64_t kMiB{1024ULL * 1024ULL};
+
+std::string format_size(uint64_t bytes)
+{
+    if (bytes < kMiB)
+        return fmt::format("{:.1f} KiB", static_cast<double>(bytes) / kKiB);
+
+    return fmt::format("{:.1f} MiB", static_cast<double>(bytes) / kMiB);
+}
+} // namespace
+
+void memory_report::sample(std::string name)
+{
+    phases.push_back({std::move(name), util::memory_budget::resident_set_size(),
+        util::memory_budget::peak_resident_set_size()});
+}
+
+memory_report_registry &memory_report_registry::instance()
+{
+    static memory_report_registry registry;
+    return registry;
+}
+
+void memory_report_registry::add(memory_report report)
+{
+    std::lock_guard<std::mutex> l(mutex_);
+
+    reports_.emplace_back(std::move(report));
+}
+
+std::vector<memory_report> memory_report_registry::reports() const
+{
+    std::vector<memory_report> result;
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        result = reports_;
+    }
+
+    std::sort(result.begin(), result.end(), [](const auto &a, const auto &b) {
+        return a.diagram_name < b.diagram_name;
+    });
+
+    return result;
+}
+
+nlohmann::json memory_report_registry::to_json() const
+{
+    auto result = nlohmann::json::array();
+
+    for (const auto &r : reports()) {
+        auto phases = nlohmann::json::array();
+        for (const auto &p : r.phases) {
+            phases.push_back(
+                {{"name", p.name}, {"rss", p.rss}, {"peak_rss", p.peak_rss}});
+        }
+
+        const auto &u = r.model_usage;
+        nlohmann::json model{{"total", u.total()}, {"elements", u.elements},
+            {"relationships", u.relationships},
+            {"template_params", u.template_params}, {"messages", u.messages},
+            {"comments", u.comments}, {"source_locations", u.source_locations},
+            {"strings", u.strings}};
+        model["counts"] = {{"elements", u.element_count},
+            {"relationships", u.relationship_count},
+            {"template_params", u.template_param_count},
+            {"messages", u.message_count}};
+
+        result.push_back({{"diagram", r.diagram_name},
+            {"type", r.diagram_type}, {"phases", std::move(phases)},
+            {"model", std::move(model)}});
+    }
+
+    return result;
+}
+
+std::string memory_report_registry::to_string() const
+{
+    std::string result;
+    auto out = std::back_inserter(result);
+
+    for (const auto &r : reports()) {
+        fmt::format_to(out, "Memory usage of {} diagram '{}'\n",
+            r.diagram_type, r.diagram_name);
+        fmt::format_to(out, "  {:<20}{:>14}{:>14}\n", "phase", "RSS",
+            "peak RSS");
+        for (const auto &p : r.phases) {
+            fmt::format_to(out, "  {:<20}{:>14}{:>14}\n", p.name,
+                format_size(p.rss), format_size(p.peak_rss));
+        }
+
+        const auto &u = r.model_usage;
+        fmt::format_to(
+            out, "  {:<20}{:>14}\n", "model estimate", format_size(u.total()));
+        fmt::format_to(out, "    {:<18}{:>14}{:>14}\n", "elements",
+            format_size(u.elements), u.element_count);
+        fmt::format_to(out, "    {:<18}{:>14}{:>14}\n", "relationships",
+            format_size(u.relationships), u.relationship_count);
+        fmt::format_to(out, "    {:<18}{:>14}{:>14}\n", "template params",
+            format_size(u.template_params), u.template_param_count);
+        fmt::format_to(out, "    {:<18}{:>14}{:>14}\n", "messages",
+            format_size(u.messages), u.message_count);
+        fmt::format_to(out, "    {:<18}{:>14}\n", "comments",
+            format_size(u.comments));
+        fmt::format_to(out, "    {:<18}{:>14}\n", "source locations",
+            format_size(u.source_locations));
+        fmt::format_to(
+            out, "    {:<18}{:>14}\n", "strings", format_size(u.strings));
+    }
+
+    return result;
+}
+
+} // namespace clanguml::common::generators
@@ -0,0 +1,108 @@
+/**
+ * @file src/common/generators/memory_report.h
+ *
+ * Copyright (c) 2021-2025 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "common/model/memory_usage.h"
+
+#include <nlohmann/json.hpp>
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace clanguml::common::generators {
+
+/**
+ * @brief Memory usage of a single diagram generation
+ *
+ * Resident set size is sampled at the end of each generation phase. Since
+ * diagrams can be generated in parallel, the sizes are process-wide and
+ * include memory used by other diagrams generated at the same time.
+ */
+struct memory_report {
+    /**
+     * @brief Resident set size at the end of a generation phase
+     */
+    struct phase {
+        std::string name;
+        /** Resident set size in bytes */
+        uint64_t rss{0};
+        /** Peak resident set size of the process until now in bytes */
+        uint64_t peak_rss{0};
+    };
+
+    /**
+     * @brief Record resident set size at the end of a phase
+     *
+     * @param name Name of the phase
+     */
+    void sample(std::string name);
+
+    std::string diagram_name;
+    std::string diagram_type;
+    std::vector<phase> phases;
+    model::memory_usage model_usage;
+};
+
+/**
+ * @brief Collects memory reports of all generated diagrams
+ */
+class memory_report_registry {
+public:
+    /**
+     * @brief Get the process-wide memory report registry
+     *
+     * @return Reference to the registry
+     */
+    static memory_report_registry &instance();
+
+    /**
+     * @brief Add report of a generated diagram
+     *
+     * @param report Memory report
+     */
+    void add(memory_report report);
+
+    /**
+     * @brief Get all reports ordered by diagram name
+     *
+     * @return List of memory reports
+     */
+    std::vector<memory_report> reports() const;
+
+    /**
+     * @brief Convert all reports to JSON, with sizes in bytes
+     *
+     * @return JSON array with one object per diagram
+     */
+    nlohmann::json to_json() const;
+
+    /**
+     * @brief Format all reports as human readable tables
+     *
+     * @return Formatted reports
+     */
+    std::string to_string() const;
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<memory_report> reports_;
+};
+
+} // namespace clanguml::common::generators
@@ -0,0 +1,242 @@
+/**
+ * @file src/common/generators/preamble_cache.cc
+ *
+ * Copyright (c) 2021-2025 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "preamble_cache.h"
+
+#include "util/hash.h"
+#include "util/logging.h"
+
+#include <clang/Frontend/CompilerInstance.h>
+#include <clang/Frontend/CompilerInvocation.h>
+
+namespace clanguml::generators {
+
+namespace {
+const clang::LangOptions &lang_options(
+    const clang::CompilerInvocation &invocation)
+{
+#if LLVM_VERSION_MAJOR > 17
+    return invocation.getLangOpts();
+#else
+    return *invocation.getLangOpts();
+#endif
+}
+} // namespace
+
+preamble_cache &preamble_cache::instance()
+{
+    static preamble_cache cache;
+    return cache;
+}
+
+void preamble_cache::enable(std::filesystem::path storage_directory)
+{
+    if (!storage_directory.empty())
+        std::filesystem::create_directories(storage_directory);
+
+    storage_directory_ = std::move(storage_directory);
+    enabled_ = true;
+}
+
+void preamble_cache::disable()
+{
+    enabled_ = false;
+
+    std::lock_guard<std::mutex> l(mutex_);
+    entries_.clear();
+}
+
+bool preamble_cache::enabled() const { return enabled_; }
+
+uint64_t preamble_cache::make_key(
+    const std::string &group_key, llvm::StringRef preamble)
+{
+    return util::hash64{}
+        .update(group_key)
+        .update({"\0", 1})
+        .update(preamble)
+        .digest();
+}
+
+std::shared_ptr<const clang::PrecompiledPreamble> preamble_cache::get(
+    const std::string &group_key, const clang::CompilerInvocation &invocation,
+    const llvm::MemoryBuffer &main_file_buffer,
+    const clang::PreambleBounds &bounds,
+    llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> vfs,
+    std::shared_ptr<clang::PCHContainerOperations> pch_container_ops)
+{
+    const auto key = make_key(
+        group_key, main_file_buffer.getBuffer().substr(0, bounds.Size));
+
+    std::shared_ptr<entry> e;
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        auto &result = entries_[key];
+        if (!result)
+            result = std::make_shared<entry>();
+        e = result;
+    }
+
+    // Other translation units from the same group wait until the preamble
+    // is built
+    std::lock_guard<std::mutex> l(e->mutex);
+    if (!e->done) {
+        e->preamble = build(invocation, main_file_buffer, bounds, vfs,
+            std::move(pch_container_ops));
+        e->done = true;
+        return e->preamble;
+    }
+
+    if (!e->preamble)
+        return {};
+
+    if (!e->preamble->CanReuse(
+            invocation, main_file_buffer.getMemBufferRef(), bounds, *vfs))
+        return {};
+
+    reused_++;
+
+    return e->preamble;
+}
+
+preamble_cache::statistics preamble_cache::stats() const
+{
+    statistics result;
+    result.built = built_;
+    result.failed = failed_;
+    result.reused = reused_;
+    return result;
+}
+
+std::shared_ptr<const clang::PrecompiledPreamble> preamble_cache::build(
+    const clang::CompilerInvocation &invocation,
+    const llvm::MemoryBuffer &main_file_buffer,
+    const clang::PreambleBounds &bounds,
+    llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> vfs,
+    std::shared_ptr<clang::PCHContainerOperations> pch_container_ops)
+{
+    const auto &main_file =
+        invocation.getFrontendOpts().Inputs.front().getFile();
+
+    LOG_DBG("Building precompiled preamble for {}", main_file.str());
+
+    // Diagnostics are reported when the translation unit itself is parsed,
+    // preambles with errors are not used
+    llvm::IntrusiveRefCntPtr<clang::DiagnosticOptions> diag_opts{
+        new clang::DiagnosticOptions};
+#if LLVM_VERSION_MAJOR > 19
+    auto diagnostics = clang::CompilerInstance::createDiagnostics(
+        *vfs, diag_opts.get(), new clang::IgnoringDiagConsumer, true);
+#else
+    auto diagnostics = clang::CompilerInstance::createDiagnostics(
+        diag_opts.get(), new clang::IgnoringDiagConsumer, true);
+#endif
+
+    clang::PreambleCallbacks callbacks;
+
+    const bool store_in_memory = storage_directory_.empty();
+
+#if LLVM_VERSION_MAJOR > 16
+    auto preamble = clang::PrecompiledPreamble::Build(invocation,
+        &main_file_buffer, bounds, *diagnostics, vfs,
+        std::move(pch_container_ops), store_in_memory,
+        storage_directory_.string(), callbacks);
+#else
+    auto preamble = clang::PrecompiledPreamble::Build(invocation,
+        &main_file_buffer, bounds, *diagnostics, vfs,
+        std::move(pch_container_ops), store_in_memory, callbacks);
+#endif
+
+    if (!preamble || diagnostics->hasErrorOccurred()) {
+        LOG_DBG("Failed to build precompiled preamble for {}: {}",
+            main_file.str(),
+            preamble ? "errors in preamble" : preamble.getError().message());
+        failed_++;
+        return {};
+    }
+
+    built_++;
+
+    return std::make_shared<const clang::PrecompiledPreamble>(
+        std::move(*preamble));
+}
+
+preamble_tool_action::preamble_tool_action(
+    clang::tooling::ToolAction *action, preamble_cache &cache)
+    : action_{action}
+    , cache_{cache}
+{
+}
+
+void preamble_tool_action::set_group_key(std::string group_key)
+{
+    group_key_ = std::move(group_key);
+}
+
+bool preamble_tool_action::runInvocation(
+    std::shared_ptr<clang::CompilerInvocation> invocation,
+    clang::FileManager *files,
+    std::shared_ptr<clang::PCHContainerOperations> pch_container_ops,
+    clang::DiagnosticConsumer *diag_consumer)
+{
+    const auto &inputs = invocation->getFrontendOpts().Inputs;
+    if (inputs.size() != 1 || !inputs.front().isFile()) {
+        return action_->runInvocation(std::move(invocation), files,
+            std::move(pch_container_ops), diag_consumer);
+    }
+
+    auto main_file_buffer = files->getBufferForFile(inputs.front().getFile());
+    if (!main_file_buffer) {
+        return action_->runInvocation(std::move(invocation), files,
+            std::move(pch_container_ops), diag_consumer);
+    }
+
+    const auto bounds = clang::ComputePreambleBounds(lang_options(*invocation),
+        (*main_file_buffer)->getMemBufferRef(), /*MaxLines=*/0);
+
+    llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> vfs{
+        &files->getVirtualFileSystem()};
+
+    auto preamble = bounds.Size == 0
+        ? nullptr
+        : cache_.get(group_key_, *invocation, **main_file_buffer, bounds, vfs,
+              pch_container_ops);
+
+    if (!preamble) {
+        return action_->runInvocation(std::move(invocation), files,
+            std::move(pch_container_ops), diag_consumer);
+    }
+
+    // This remaps the main file to main_file_buffer, which has to outlive
+    // the invocation, and for in-memory preambles overlays the file system
+    // with the preamble contents
+    preamble->AddImplicitPreamble(*invocation, vfs, main_file_buffer->get());
+
+    if (vfs.get() == &files->getVirtualFileSystem()) {
+        return action_->runInvocation(std::move(invocation), files,
+            std::move(pch_container_ops), diag_consumer);
+    }
+
+    llvm::IntrusiveRefCntPtr<clang::FileManager> preamble_files{
+        new clang::FileManager(files->getFileSystemOpts(), vfs)};
+
+    return action_->runInvocation(std::move(invocation), preamble_files.get(),
+        std::move(pch_container_ops), diag_consumer);
+}
+
+} // namespace clanguml::generators
@@ -0,0 +1,172 @@
+/**
+ * @file src/common/generators/preamble_cache.h
+ *
+ * Copyright (c) 2021-2025 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <clang/Frontend/PrecompiledPreamble.h>
+#include <clang/Tooling/Tooling.h>
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace clanguml::generators {
+
+/**
+ * @brief Process-wide cache of precompiled preambles
+ *
+ * Translation units, which are compiled with the same command line
+ * (except for the source file name) and which start with the same
+ * sequence of preprocessor directives (e.g. the same list of includes)
+ * share a single precompiled preamble. The preamble is built when the
+ * first translation unit from such group is parsed, and then reused by all
+ * other translation units in the group, in all diagrams.
+ */
+class preamble_cache {
+public:
+    /**
+     * @brief Cache usage statistics
+     */
+    struct statistics {
+        uint64_t built{0};
+        uint64_t failed{0};
+        uint64_t reused{0};
+    };
+
+    /**
+     * @brief Get the process-wide preamble cache instance
+     *
+     * @return Reference to the preamble cache
+     */
+    static preamble_cache &instance();
+
+    /**
+     * @brief Enable building and reusing precompiled preambles
+     *
+     * @param storage_directory Directory where preambles should be stored,
+     *                          if empty the preambles are kept in memory
+     */
+    void enable(std::filesystem::path storage_directory = {});
+
+    /**
+     * @brief Disable precompiled preambles and release all cached preambles
+     */
+    void disable();
+
+    /**
+     * @brief Whether precompiled preambles are enabled
+     *
+     * @return True, if preambles should be used
+     */
+    bool enabled() const;
+
+    /**
+     * @brief Compute the key of a preamble in the cache
+     *
+     * @param group_key Key identifying the compile command (without the
+     *                  translation unit file name)
+     * @param preamble Contents of the preamble
+     * @return Key of the preamble
+     */
+    static uint64_t make_key(
+        const std::string &group_key, llvm::StringRef preamble);
+
+    /**
+     * @brief Get preamble for a translation unit, building it if necessary
+     *
+     * @param group_key Key identifying the compile command (without the
+     *                  translation unit file name)
+     * @param invocation Compiler invocation for the translation unit
+     * @param main_file_buffer Contents of the translation unit source file
+     * @param bounds Bounds of the preamble in main_file_buffer
+     * @param vfs File system used to read the sources
+     * @param pch_container_ops PCH container operations
+     * @return Preamble which can be used for the translation unit or nullptr
+     */
+    std::shared_ptr<const clang::PrecompiledPreamble> get(
+        const std::string &group_key,
+        const clang::CompilerInvocation &invocation,
+        const llvm::MemoryBuffer &main_file_buffer,
+        const clang::PreambleBounds &bounds,
+        llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> vfs,
+        std::shared_ptr<clang::PCHContainerOperations> pch_container_ops);
+
+    /**
+     * @brief Get cache usage statistics
+     *
+     * @return Cache statistics
+     */
+    statistics stats() const;
+
+private:
+    struct entry {
+        std::mutex mutex;
+        bool done{false};
+        std::shared_ptr<const clang::PrecompiledPreamble> preamble;
+    };
+
+    std::shared_ptr<const clang::PrecompiledPreamble> build(
+        const clang::CompilerInvocation &invocation,
+        const llvm::MemoryBuffer &main_file_buffer,
+        const clang::PreambleBounds &bounds,
+        llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> vfs,
+        std::shared_ptr<clang::PCHContainerOperations> pch_container_ops);
+
+    std::atomic<bool> enabled_{false};
+    std::filesystem::path storage_directory_;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<uint64_t, std::shared_ptr<entry>> entries_;
+
+    std::atomic<uint64_t> built_{0};
+    std::atomic<uint64_t> failed_{0};
+    std::atomic<uint64_t> reused_{0};
+};
+
+/**
+ * @brief Tool action wrapper, which adds a precompiled preamble from
+ *        @ref preamble_cache to each compiler invocation
+ */
+class preamble_tool_action : public clang::tooling::ToolAction {
+public:
+    preamble_tool_action(
+        clang::tooling::ToolAction *action, preamble_cache &cache);
+
+    /**
+     * @brief Set the group key for the next invocation
+     *
+     * @param group_key Compile command of the next translation unit
+     *                  without the translation unit file name
+     */
+    void set_group_key(std::string group_key);
+
+    bool runInvocation(std::shared_ptr<clang::CompilerInvocation> invocation,
+        clang::FileManager *files,
+        std::shared_ptr<clang::PCHContainerOperations> pch_container_ops,
+        clang::DiagnosticConsumer *diag_consumer) override;
+
+private:
+    clang::tooling::ToolAction *action_;
+    preamble_cache &cache_;
+    std::string group_key_;
+};
+
+} // namespace clanguml::generators
@@ -0,0 +1,282 @@
+/**
+ * @file src/common/generators/translation_unit_cover.cc
+ *
+ * Copyright (c) 2021-2025 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "translation_unit_cover.h"
+
+#include "common/generators/clang_tool.h"
+#include "util/logging.h"
+
+#include <clang/Frontend/CompilerInstance.h>
+#include <clang/Frontend/FrontendActions.h>
+#include <clang/Lex/PPCallbacks.h>
+#include <clang/Lex/Preprocessor.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <queue>
+#include <set>
+#include <unordered_map>
+
+namespace clanguml::generators {
+
+namespace {
+using included_files_t = std::map<std::string, std::set<std::string>>;
+
+std::string normalize_path(const std::string &path)
+{
+    std::error_code ec;
+    auto result = std::filesystem::weakly_canonical(path, ec);
+    if (ec)
+        return path;
+
+    return result.string();
+}
+
+/**
+ * @brief Preprocessor callback collecting all files entered by the
+ *        preprocessor
+ */
+class include_scanner : public clang::PPCallbacks {
+public:
+    include_scanner(const clang::SourceManager &sm, bool skip_system_headers,
+        std::set<std::string> &files)
+        : source_manager_{sm}
+        , skip_system_headers_{skip_system_headers}
+        , files_{files}
+    {
+    }
+
+    void FileChanged(clang::SourceLocation loc, FileChangeReason reason,
+        clang::SrcMgr::CharacteristicKind file_type,
+        clang::FileID /*prev_fid*/) override
+    {
+        if (reason != EnterFile)
+            return;
+
+        if (skip_system_headers_ && clang::SrcMgr::isSystem(file_type))
+            return;
+
+        auto file = source_manager_.getFileEntryRefForID(
+            source_manager_.getFileID(loc));
+        if (!file)
+            return;
+
+        const auto path = file->getFileEntry().tryGetRealPathName();
+        if (path.empty())
+            return;
+
+        files_.emplace(path.str());
+    }
+
+private:
+    const clang::SourceManager &source_manager_;
+    const bool skip_system_headers_;
+    std::set<std::string> &files_;
+};
+
+/**
+ * @brief Frontend action, which only preprocesses the translation unit
+ *        in order to find all files it includes
+ */
+class include_scan_action : public clang::PreprocessOnlyAction {
+public:
+    include_scan_action(bool skip_system_headers, included_files_t &result)
+        : skip_system_headers_{skip_system_headers}
+        , result_{result}
+    {
+    }
+
+protected:
+    bool BeginSourceFileAction(clang::CompilerInstance &ci) override
+    {
+        const auto &sm = ci.getSourceManager();
+
+        auto main_file = sm.getFileEntryRefForID(sm.getMainFileID());
+        if (!main_file)
+            return true;
+
+        auto &files = result_[normalize_path(
+            main_file->getFileEntry().tryGetRealPathName().str())];
+
+        ci.getPreprocessor().addPPCallbacks(
+            std::make_unique<include_scanner>(sm, skip_system_headers_, files));
+
+        return true;
+    }
+
+private:
+    const bool skip_system_headers_;
+    included_files_t &result_;
+};
+
+class include_scan_action_factory
+    : public clang::tooling::FrontendActionFactory {
+public:
+    include_scan_action_factory(bool skip_system_headers)
+        : skip_system_headers_{skip_system_headers}
+    {
+    }
+
+    std::unique_ptr<clang::FrontendAction> create() override
+    {
+        return std::make_unique<include_scan_action>(
+            skip_system_headers_, result_);
+    }
+
+    const included_files_t &result() const { return result_; }
+
+private:
+    const bool skip_system_headers_;
+    included_files_t result_;
+};
+} // namespace
+
+std::vector<std::string> select_covering_translation_units(
+    const std::vector<std::string> &translation_units,
+    const std::map<std::string, std::vector<std::string>> &covered_files)
+{
+    std::vector<bool> selected(translation_units.size(), false);
+
+    // Assign consecutive ids to all covered files
+    std::unordered_map<std::string, std::size_t> file_ids;
+    std::vector<std::vector<std::size_t>> tu_files(translation_units.size());
+    for (std::size_t i = 0; i < translation_units.size(); i++) {
+        const auto it = covered_files.find(translation_units[i]);
+        if (it == covered_files.end()) {
+            selected[i] = true;
+            continue;
+        }
+
+        for (const auto &file : it->second) {
+            auto [file_id, _] = file_ids.emplace(file, file_ids.size());
+            tu_files[i].push_back(file_id->second);
+        }
+    }
+
+    std::vector<bool> covered(file_ids.size(), false);
+
+    const auto uncovered_count = [&](std::size_t tu) {
+        return static_cast<std::size_t>(
+            std::count_if(tu_files[tu].begin(), tu_files[tu].end(),
+                [&covered](auto file_id) { return !covered[file_id]; }));
+    };
+
+    // Lazy greedy set cover - the number of uncovered files of a translation
+    // unit can only decrease, so it is enough to recompute it for the
+    // translation unit at the top of the queue. In case of equal number of
+    // files, translation units are selected in their original order.
+    using candidate_t = std::pair<std::size_t, std::size_t>;
+    const auto compare = [](const candidate_t &a, const candidate_t &b) {
+        return a.first < b.first || (a.first == b.first && a.second > b.second);
+    };
+    std::priority_queue<candidate_t, std::vector<candidate_t>,
+        decltype(compare)>
+        candidates{compare};
+
+    for (std::size_t i = 0; i < translation_units.size(); i++) {
+        if (!selected[i] && !tu_files[i].empty())
+            candidates.emplace(tu_files[i].size(), i);
+    }
+
+    while (!candidates.empty()) {
+        auto [count, tu] = candidates.top();
+        candidates.pop();
+
+        const auto current_count = uncovered_count(tu);
+        if (current_count == 0)
+            continue;
+
+        if (current_count < count) {
+            candidates.emplace(current_count, tu);
+            continue;
+        }
+
+        selected[tu] = true;
+        for (const auto file_id : tu_files[tu])
+            covered[file_id] = true;
+    }
+
+    std::vector<std::string> result;
+    for (std::size_t i = 0; i < translation_units.size(); i++) {
+        if (selected[i])
+            result.push_back(translation_units[i]);
+    }
+
+    return result;
+}
+
+std::vector<std::string> find_covering_translation_units(
+    const common::compilation_database &db, const config::diagram &config,
+    const common::model::diagram &diagram,
+    const std::vector<std::string> &translation_units)
+{
+    // Package diagrams skip system headers regardless of the config
+    const bool skip_system_headers =
+        diagram.type() == common::model::diagram_t::kPackage ||
+        !config.include_system_headers();
+
+    LOG_DBG("Scanning includes of {} translation units for diagram {}",
+        translation_units.size(), config.name);
+
+    clang_tool scan_tool{diagram.type(), config.name, db, translation_units,
+        config.root_directory(), true};
+    scan_tool.disable_precompiled_preambles();
+
+    include_scan_action_factory scan_factory{skip_system_headers};
+
+    try {
+        scan_tool.run(&scan_factory);
+    }
+    catch (const std::exception &e) {
+        LOG_WARN("Failed to scan includes of translation units for diagram "
+                 "{}, parsing all translation units: {}",
+            config.name, e.what());
+        return translation_units;
+    }
+
+    std::map<std::string, std::vector<std::string>> covered_files;
+    std::set<std::string> all_covered_files;
+    for (const auto &tu : translation_units) {
+        const auto it = scan_factory.result().find(normalize_path(tu));
+        if (it == scan_factory.result().end())
+            continue;
+
+        auto &files = covered_files[tu];
+        for (const auto &file : it->second) {
+            if (diagram.should_include_source_file(file)) {
+                files.push_back(file);
+                all_covered_files.emplace(file);
+            }
+        }
+    }
+
+    auto result =
+        select_covering_translation_units(translation_units, covered_files);
+
+    LOG_INFO("Selected {} out of {} translation units covering {} files for "
+             "diagram {} ({} translation units skipped)",
+        result.size(), translation_units.size(), all_covered_files.size(),
+        config.name, translation_units.size() - result.size());
+
+    LOG_DBG("Files covered by translation units of diagram {}: {}",
+        config.name, fmt::join(all_covered_files, ", "));
+
+    return result;
+}
+
+} // namespace clanguml::generators
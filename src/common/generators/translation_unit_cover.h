@@ -0,0 +1,72 @@
+/**
+ * @file src/common/generators/translation_unit_cover.h
+ *
+ * Copyright (c) 2021-2025 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "common/compilation_database.h"
+#include "common/model/diagram.h"
+#include "config/config.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace clanguml::generators {
+
+/**
+ * @brief Select a subset of translation units covering a set of files
+ *
+ * The subset is computed using a greedy set cover, i.e. in each step the
+ * translation unit which covers the largest number of files not covered by
+ * previously selected translation units is selected. Translation units
+ * missing from `covered_files` are always selected.
+ *
+ * @param translation_units List of translation units
+ * @param covered_files Map of translation units to files, which they cover
+ * @return Selected translation units, in the order of `translation_units`
+ */
+std::vector<std::string> select_covering_translation_units(
+    const std::vector<std::string> &translation_units,
+    const std::map<std::string, std::vector<std::string>> &covered_files);
+
+/**
+ * @brief Find minimal set of translation units needed to generate a diagram
+ *
+ * All translation units are first only preprocessed, in order to find
+ * which source files and headers, accepted by the diagram filters, they
+ * include. Then, only the translation units needed to cover all these files
+ * are selected for parsing.
+ *
+ * The main source file of each translation unit is also covered, as it can
+ * contain declarations of diagram elements, so translation units whose
+ * source file is accepted by the diagram filters are always selected.
+ *
+ * If the preprocessing of any translation unit fails, all translation units
+ * are returned.
+ *
+ * @param db Reference to compilation database
+ * @param config Diagram configuration
+ * @param diagram Diagram model with the filters already set
+ * @param translation_units List of translation units matching diagram glob
+ * @return Translation units, which should be parsed for the diagram
+ */
+std::vector<std::string> find_covering_translation_units(
+    const common::compilation_database &db, const config::diagram &config,
+    const common::model::diagram &diagram,
+    const std::vector<std::string> &translation_units);
+
+} // namespace clanguml::generators
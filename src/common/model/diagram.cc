@@ -20,6 +20,7 @@
 
 #include "filters/diagram_filter.h"
 #include "namespace.h"
+#include "util/trace.h"
 
 namespace clanguml::common::model {
 
@@ -55,6 +56,11 @@ void diagram::set_filter(std::unique_ptr<diagram_filter> filter)
     filter_ = std::move(filter);
 }
 
+template_instantiation_cache &diagram::template_instantiations() const
+{
+    return *template_instantiations_;
+}
+
 void diagram::set_complete(bool complete) { complete_ = complete; }
 
 bool diagram::complete() const { return complete_; }
@@ -62,6 +68,8 @@ bool diagram::complete() const { return complete_; }
 void diagram::finalize()
 {
     // Remove elements that do not match the filter
+    const util::trace_span span{
+        "diagram", "apply filter", {{"diagram", name()}}};
     apply_filter();
     filtered_ = true;
 }
@@ -138,4 +146,12 @@ bool diagram::should_include(const common::model::source_file &f) const
     return filter_->should_include(f);
 }
 
+bool diagram::should_include_source_file(const std::string &file_path) const
+{
+    if (filter_.get() == nullptr)
+        return true;
+
+    return filter_->should_include_source_file(file_path);
+}
+
 } // namespace clanguml::common::model
\ No newline at end of file
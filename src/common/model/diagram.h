@@ -19,8 +19,10 @@
 
 #include "diagram_element.h"
 #include "enums.h"
+#include "memory_usage.h"
 #include "namespace.h"
 #include "source_file.h"
+#include "template_instantiation_cache.h"
 
 #include <memory>
 #include <string>
@@ -152,6 +154,17 @@ public:
     // Disallow std::string overload
     bool should_include(const std::string &s) const = delete;
 
+    /**
+     * @brief Check if elements declared in a source file can be included
+     *
+     * Unlike `should_include(const source_file &)`, the result is cached
+     * for each file path for the entire diagram.
+     *
+     * @param file_path Source file path
+     * @return True, if elements from the source file can be included
+     */
+    bool should_include_source_file(const std::string &file_path) const;
+
     virtual bool has_element(const eid_t /*id*/) const { return false; }
 
     virtual bool should_include(
@@ -166,9 +179,27 @@ public:
 
     virtual void apply_filter() { }
 
+    /**
+     * @brief Estimate memory used by the diagram model
+     *
+     * @param usage Memory usage to which the diagram model is added
+     */
+    virtual void estimate_memory_usage(memory_usage &usage) const = 0;
+
+    /**
+     * @brief Get the cache of template instantiations built for this diagram
+     *
+     * The cache is shared by all translation units of the diagram.
+     *
+     * @return Reference to the template instantiation cache
+     */
+    template_instantiation_cache &template_instantiations() const;
+
 private:
     std::string name_;
     std::unique_ptr<diagram_filter> filter_;
+    std::unique_ptr<template_instantiation_cache> template_instantiations_{
+        std::make_unique<template_instantiation_cache>()};
     bool complete_{false};
     bool filtered_{false};
 };
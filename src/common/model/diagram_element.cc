@@ -25,6 +25,24 @@
 
 namespace clanguml::common::model {
 
+namespace {
+/**
+ * @brief Hash of the relationship fields compared by `operator==`
+ */
+std::size_t relationship_hash(const relationship &r)
+{
+    const auto combine = [](std::size_t seed, std::size_t value) {
+        return seed ^ (value + 0x9e3779b9 + (seed << 6U) + (seed >> 2U));
+    };
+
+    auto seed = std::hash<std::string>{}(r.label());
+    seed = combine(seed, static_cast<std::size_t>(r.type()));
+    seed = combine(seed, std::hash<eid_t::type>{}(r.destination().value()));
+
+    return seed;
+}
+} // namespace
+
 diagram_element::diagram_element() = default;
 
 const eid_t &diagram_element::id() const { return id_; }
@@ -58,17 +76,20 @@ void diagram_element::add_relationship(relationship &&cr)
         return;
     }
 
-    if (!util::contains(relationships_, cr)) {
-        LOG_DBG("Adding relationship from: '{}' ({}) - {} - '{}'", id(),
-            full_name(true), to_string(cr.type()), cr.destination());
+    update_relationships_index();
 
-        relationships_.emplace_back(std::move(cr));
-    }
-}
+    const auto hash = relationship_hash(cr);
+    const auto [begin, end] = relationships_index_.equal_range(hash);
+    if (std::any_of(begin, end, [this, &cr](const auto &it) {
+            return relationships_[it.second] == cr;
+        }))
+        return;
 
-std::vector<relationship> &diagram_element::relationships()
-{
-    return relationships_;
+    LOG_DBG("Adding relationship from: '{}' ({}) - {} - '{}'", id(),
+        full_name(true), to_string(cr.type()), cr.destination());
+
+    relationships_index_.emplace(hash, relationships_.size());
+    relationships_.emplace_back(std::move(cr));
 }
 
 const std::vector<relationship> &diagram_element::relationships() const
@@ -92,27 +113,53 @@ void diagram_element::complete(bool completed) { complete_ = completed; }
 void diagram_element::remove_duplicate_relationships()
 {
     std::vector<relationship> unique_relationships;
+    unique_relationships.reserve(relationships_.size());
+
+    relationships_index_.clear();
 
     for (auto &r : relationships_) {
-        if (!util::contains(unique_relationships, r)) {
-            unique_relationships.emplace_back(r);
+        const auto hash = relationship_hash(r);
+        const auto [begin, end] = relationships_index_.equal_range(hash);
+        const auto is_duplicate = std::any_of(
+            begin, end, [&unique_relationships, &r](const auto &it) {
+                return unique_relationships[it.second] == r;
+            });
+
+        if (!is_duplicate) {
+            relationships_index_.emplace(hash, unique_relationships.size());
+            unique_relationships.emplace_back(std::move(r));
         }
     }
 
     std::swap(relationships_, unique_relationships);
+    relationships_index_valid_ = true;
+}
+
+void diagram_element::update_relationships_index()
+{
+    if (relationships_index_valid_)
+        return;
+
+    relationships_index_.clear();
+    for (std::size_t i = 0; i < relationships_.size(); i++)
+        relationships_index_.emplace(relationship_hash(relationships_[i]), i);
+
+    relationships_index_valid_ = true;
 }
 
 void diagram_element::apply_filter(
     const diagram_filter &filter, const std::set<eid_t> &removed)
 {
-    common::model::apply_filter(relationships(), filter);
-
-    auto &rels = relationships();
-    rels.erase(std::remove_if(std::begin(rels), std::end(rels),
-                   [&removed](auto &&r) {
-                       return removed.count(r.destination()) > 0;
-                   }),
-        std::end(rels));
+    common::model::apply_filter(relationships_, filter);
+
+    relationships_.erase(std::remove_if(std::begin(relationships_),
+                             std::end(relationships_),
+                             [&removed](auto &&r) {
+                                 return removed.count(r.destination()) > 0;
+                             }),
+        std::end(relationships_));
+
+    relationships_index_valid_ = false;
 }
 
 bool operator==(const diagram_element &l, const diagram_element &r)
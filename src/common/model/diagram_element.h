@@ -18,6 +18,7 @@
 #pragma once
 
 #include "decorated_element.h"
+#include "enums.h"
 #include "relationship.h"
 #include "source_location.h"
 #include "util/memoized.h"
@@ -27,8 +28,11 @@
 
 #include <atomic>
 #include <exception>
+#include <optional>
 #include <set>
 #include <string>
+#include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 namespace clanguml::common::model {
@@ -132,6 +136,13 @@ public:
      */
     virtual std::string type_name() const { return "__undefined__"; };
 
+    /**
+     * Return the kind of the diagram element.
+     *
+     * @return Diagram element kind.
+     */
+    virtual element_kind_t kind() const { return element_kind_t::kUndefined; }
+
     /**
      * @brief Return the elements fully qualified name.
      *
@@ -148,13 +159,6 @@ public:
             relative);
     }
 
-    /**
-     * Return all relationships outgoing from this element.
-     *
-     * @return List of relationships.
-     */
-    std::vector<relationship> &relationships();
-
     /**
      * Return all relationships outgoing from this element.
      *
@@ -165,10 +169,52 @@ public:
     /**
      * Add relationships, whose source is this element.
      *
+     * Relationships equal to an already added relationship are skipped.
+     *
      * @param cr Relationship to another diagram element.
      */
     void add_relationship(relationship &&cr);
 
+    /**
+     * Remove relationships matching a predicate.
+     *
+     * @param predicate Returns true for relationships to remove.
+     */
+    template <typename F> void remove_relationships_if(F &&predicate)
+    {
+        const auto size = relationships_.size();
+
+        util::erase_if(relationships_, std::forward<F>(predicate));
+
+        if (relationships_.size() != size)
+            relationships_index_valid_ = false;
+    }
+
+    /**
+     * Change destinations of relationships, for instance after resolving
+     * local ids to global ids.
+     *
+     * Relationships which become duplicates of other relationships are
+     * removed.
+     *
+     * @param resolve Returns new destination of a relationship, or
+     *        `std::nullopt` if the destination should not change.
+     */
+    template <typename F> void resolve_relationship_destinations(F &&resolve)
+    {
+        bool resolved{false};
+        for (auto &r : relationships_) {
+            const std::optional<eid_t> destination = resolve(r);
+            if (destination && *destination != r.destination()) {
+                r.set_destination(*destination);
+                resolved = true;
+            }
+        }
+
+        if (resolved)
+            remove_duplicate_relationships();
+    }
+
     /**
      * Add element to the diagram.
      *
@@ -212,7 +258,7 @@ public:
     /**
      * Due to the fact that a relationship to the same element can be added
      * once with local TU id and other time with global id, the relationship
-     * set can contain duplicates.
+     * set can contain duplicates after the local ids are resolved.
      */
     void remove_duplicate_relationships();
 
@@ -226,13 +272,66 @@ protected:
     }
 
 private:
+    /**
+     * @brief Rebuild the duplicate relationships index if it is outdated
+     */
+    void update_relationships_index();
+
     eid_t id_{};
     std::optional<eid_t> parent_element_id_{};
     std::string name_;
     std::vector<relationship> relationships_;
+    // Positions of relationships in relationships_ by their hash
+    std::unordered_multimap<std::size_t, std::size_t> relationships_index_;
+    bool relationships_index_valid_{true};
     bool nested_{false};
     bool complete_{false};
 };
+
+namespace detail {
+template <typename T, typename = void> struct has_kind_check : std::false_type {
+};
+
+template <typename T>
+struct has_kind_check<T, std::void_t<decltype(T::is_kind(element_kind_t{}))>>
+    : std::true_type { };
+} // namespace detail
+
+/**
+ * @brief Cast diagram element to a specific element type.
+ *
+ * If the target type provides a static `is_kind(element_kind_t)` method,
+ * the check is based on the element kind returned by
+ * @ref diagram_element::kind(), otherwise or if the element kind is
+ * undefined, `dynamic_cast` is used.
+ *
+ * @tparam T Target element type
+ * @tparam E Source element type
+ * @param e Pointer to the element
+ * @return Pointer to the element as T or nullptr if e is not of type T
+ */
+template <typename T, typename E> auto element_cast(E *e)
+{
+    using result_t =
+        std::conditional_t<std::is_const_v<E>, std::add_const_t<T>, T> *;
+
+    if constexpr (std::is_base_of_v<T, std::remove_const_t<E>>) {
+        return static_cast<result_t>(e);
+    }
+    else if constexpr (detail::has_kind_check<T>::value &&
+        std::is_base_of_v<std::remove_const_t<E>, T>) {
+        if (e == nullptr)
+            return static_cast<result_t>(nullptr);
+
+        if (const auto kind = e->kind(); kind != element_kind_t::kUndefined)
+            return T::is_kind(kind) ? static_cast<result_t>(e) : nullptr;
+
+        return dynamic_cast<result_t>(e);
+    }
+    else {
+        return dynamic_cast<result_t>(e);
+    }
+}
 } // namespace clanguml::common::model
 
 template <typename T>
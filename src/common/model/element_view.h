@@ -17,6 +17,7 @@
  */
 #pragma once
 
+#include "common/model/diagram_element.h"
 #include "common/types.h"
 
 #include <set>
@@ -113,16 +114,20 @@ template <typename... Ts> struct element_views : public element_view<Ts>... {
 
     template <typename T> const element_view<T> &view() const
     {
-        return dynamic_cast<const element_view<T> &>(*this);
+        return static_cast<const element_view<T> &>(*this);
     }
 
     /**
-     * @brief Calls `f` function on `e` if it can be dynamically casted to
-     *        any type in the element_views
+     * @brief Calls `f` function on `e` if it can be casted to any type in
+     *        the element_views
+     *
+     * The type of `e` is checked using @ref element_cast, i.e. based on
+     * the element kind where possible.
+     *
      * @tparam T Element type
      * @tparam F Function to call on e
      * @param e Pointer to element
-     * @param f Function to call with `e` dynamically casted to one of types
+     * @param f Function to call with `e` casted to one of types
      */
     template <typename T, typename F> void dynamic_apply(T *e, F &&f) const
     {
@@ -131,7 +136,7 @@ template <typename... Ts> struct element_views : public element_view<Ts>... {
 
         (
             [&] {
-                if (auto *ptr = dynamic_cast<Ts *>(e); ptr) {
+                if (auto *ptr = element_cast<Ts>(e); ptr) {
                     f(ptr);
                 }
             }(),
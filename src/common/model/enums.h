@@ -17,6 +17,7 @@
  */
 #pragma once
 
+#include <cstdint>
 #include <string>
 
 #include "util/fmt_formatters.h"
@@ -25,6 +26,24 @@ namespace clanguml::common::model {
 
 enum class diagram_t { kClass, kSequence, kPackage, kInclude };
 
+/// Kinds of diagram elements, used to dispatch on the element type without
+/// RTTI (see @ref element_cast)
+enum class element_kind_t : uint8_t {
+    kUndefined,
+    kPackage,
+    kSourceFile,
+    kClass,
+    kEnum,
+    kConcept,
+    kObjCInterface,
+    kParticipant,
+    kParticipantClass,
+    kParticipantFunction,
+    kParticipantMethod,
+    kParticipantObjCMethod,
+    kParticipantFunctionTemplate
+};
+
 enum class module_access_t { kPublic, kPrivate };
 enum class access_t { kPublic, kProtected, kPrivate, kNone };
 
@@ -308,6 +308,13 @@ namespace_filter::namespace_filter(
     : filter_visitor{type}
     , namespaces_{std::move(namespaces)}
 {
+    // All regular expressions are matched at once, after the namespaces
+    for (const auto &ns : namespaces_) {
+        if (ns.is_regex())
+            regexes_.add(std::get<common::regex>(ns.value()));
+    }
+
+    regexes_.compile();
 }
 
 tvl::value_t namespace_filter::match(
@@ -317,7 +324,8 @@ tvl::value_t namespace_filter::match(
         return {};
 
     auto res = tvl::any_of(namespaces_.begin(), namespaces_.end(),
-        [&ns, is_inclusive = is_inclusive()](const auto &nsit) {
+        [&ns, is_inclusive = is_inclusive()](
+            const auto &nsit) -> tvl::value_t {
             if (std::holds_alternative<namespace_>(nsit.value())) {
                 const auto &ns_pattern = std::get<namespace_>(nsit.value());
                 if (is_inclusive)
@@ -327,10 +335,12 @@ tvl::value_t namespace_filter::match(
                 return ns.starts_with(ns_pattern);
             }
 
-            const auto &regex = std::get<common::regex>(nsit.value());
-            return regex %= ns.to_string();
+            return {};
         });
 
+    if (!tvl::is_true(res) && !regexes_.empty())
+        res = tvl::or_(res, regexes_ %= ns.to_string());
+
     if ((type() == filter_t::kInclusive && tvl::is_false(res)) ||
         (type() == filter_t::kExclusive && tvl::is_true(res))) {
         LOG_TRACE("Namespace {} rejected by namespace_filter", ns.to_string());
@@ -343,9 +353,10 @@ tvl::value_t namespace_filter::match(const diagram &d, const element &e) const
 {
     tvl::value_t res;
     if (d.type() != diagram_t::kPackage &&
-        dynamic_cast<const package *>(&e) != nullptr) {
+        element_cast<package>(&e) != nullptr) {
         res = tvl::any_of(namespaces_.begin(), namespaces_.end(),
-            [&e, is_inclusive = is_inclusive()](const auto &nsit) {
+            [&e, is_inclusive = is_inclusive()](
+                const auto &nsit) -> tvl::value_t {
                 if (std::holds_alternative<namespace_>(nsit.value())) {
                     const auto &ns_pattern = std::get<namespace_>(nsit.value());
 
@@ -368,10 +379,12 @@ tvl::value_t namespace_filter::match(const diagram &d, const element &e) const
                     return result;
                 }
 
-                return std::get<common::regex>(nsit.value()) %=
-                    e.full_name(false);
+                return {};
             });
 
+        if (!tvl::is_true(res) && !regexes_.empty())
+            res = tvl::or_(res, regexes_ %= e.full_name(false));
+
         if ((type() == filter_t::kInclusive && tvl::is_false(res)) ||
             (type() == filter_t::kExclusive && tvl::is_true(res))) {
             LOG_TRACE(
@@ -383,7 +396,8 @@ tvl::value_t namespace_filter::match(const diagram &d, const element &e) const
 
     if (d.type() == diagram_t::kPackage) {
         res = tvl::any_of(namespaces_.begin(), namespaces_.end(),
-            [&e, is_inclusive = is_inclusive()](const auto &nsit) {
+            [&e, is_inclusive = is_inclusive()](
+                const auto &nsit) -> tvl::value_t {
                 if (std::holds_alternative<namespace_>(nsit.value())) {
                     auto e_ns = namespace_{e.full_name(false)};
                     auto nsit_ns = std::get<namespace_>(nsit.value());
@@ -395,10 +409,12 @@ tvl::value_t namespace_filter::match(const diagram &d, const element &e) const
                     return e_ns.starts_with(nsit_ns) || e_ns == nsit_ns;
                 }
 
-                return std::get<common::regex>(nsit.value()) %=
-                    e.full_name(false);
+                return {};
             });
 
+        if (!tvl::is_true(res) && !regexes_.empty())
+            res = tvl::or_(res, regexes_ %= e.full_name(false));
+
         if ((type() == filter_t::kInclusive && tvl::is_false(res)) ||
             (type() == filter_t::kExclusive && tvl::is_true(res))) {
             LOG_TRACE(
@@ -407,16 +423,19 @@ tvl::value_t namespace_filter::match(const diagram &d, const element &e) const
         return res;
     }
 
-    res = tvl::any_of(
-        namespaces_.begin(), namespaces_.end(), [&e](const auto &nsit) {
+    res = tvl::any_of(namespaces_.begin(), namespaces_.end(),
+        [&e](const auto &nsit) -> tvl::value_t {
             if (std::holds_alternative<namespace_>(nsit.value())) {
                 return e.get_namespace().starts_with(
                     std::get<namespace_>(nsit.value()));
             }
 
-            return std::get<common::regex>(nsit.value()) %= e.full_name(false);
+            return {};
         });
 
+    if (!tvl::is_true(res) && !regexes_.empty())
+        res = tvl::or_(res, regexes_ %= e.full_name(false));
+
     if ((type() == filter_t::kInclusive && tvl::is_false(res)) ||
         (type() == filter_t::kExclusive && tvl::is_true(res))) {
         LOG_TRACE(
@@ -436,6 +455,12 @@ modules_filter::modules_filter(
     : filter_visitor{type}
     , modules_{std::move(modules)}
 {
+    for (const auto &m : modules_) {
+        if (m.is_regex())
+            regexes_.add(std::get<common::regex>(m.value()));
+    }
+
+    regexes_.compile();
 }
 
 tvl::value_t modules_filter::match(
@@ -450,13 +475,13 @@ tvl::value_t modules_filter::match(
     auto module_toks =
         path::split(e.module().value(), path_type::kModule); // NOLINT
 
-    if (dynamic_cast<const package *>(&e) != nullptr &&
+    if (element_cast<package>(&e) != nullptr &&
         e.get_namespace().type() == path_type::kModule) {
         module_toks.push_back(e.name());
     }
 
     auto result = tvl::any_of(modules_.begin(), modules_.end(),
-        [&e, &module_toks](const auto &modit) {
+        [&e, &module_toks](const auto &modit) -> tvl::value_t {
             if (std::holds_alternative<std::string>(modit.value())) {
                 const auto &modit_str = std::get<std::string>(modit.value());
                 const auto modit_toks =
@@ -466,9 +491,12 @@ tvl::value_t modules_filter::match(
                     util::starts_with(module_toks, modit_toks);
             }
 
-            return std::get<common::regex>(modit.value()) %= e.module().value();
+            return {};
         });
 
+    if (!tvl::is_true(result) && !regexes_.empty())
+        result = tvl::or_(result, regexes_ %= e.module().value());
+
     if ((type() == filter_t::kInclusive && tvl::is_false(result)) ||
         (type() == filter_t::kExclusive && tvl::is_true(result))) {
         LOG_TRACE("Element {} rejected by modules_filter", e.full_name(false));
@@ -487,7 +515,7 @@ element_filter::element_filter(
 tvl::value_t element_filter::match(const diagram &d, const element &e) const
 {
     // Do not apply element filter to packages in class diagrams
-    if (d.type() == diagram_t::kClass && e.type_name() == "package")
+    if (d.type() == diagram_t::kClass && e.kind() == element_kind_t::kPackage)
         return std::nullopt;
 
     auto res =
@@ -617,9 +645,8 @@ tvl::value_t element_filter::match(
                 return false;
             }
 
-            if (p.type_name() == "method") {
-                const auto &m = dynamic_cast<const method &>(p);
-                const auto class_id = m.class_id();
+            if (const auto *m = element_cast<method>(&p); m != nullptr) {
+                const auto class_id = m->class_id();
                 const auto &class_participant =
                     sequence_model.get_participant<participant>(class_id)
                         .value();
@@ -629,11 +656,10 @@ tvl::value_t element_filter::match(
                     (el.name == class_participant.full_name(false));
             }
 
-            if (p.type_name() == "objc_method") {
-                const auto &m =
-                    dynamic_cast<const sequence_diagram::model::objc_method &>(
-                        p);
-                const auto class_id = m.class_id();
+            if (const auto *m =
+                    element_cast<sequence_diagram::model::objc_method>(&p);
+                m != nullptr) {
+                const auto class_id = m->class_id();
                 const auto &class_participant =
                     sequence_model.get_participant<participant>(class_id)
                         .value();
@@ -749,41 +775,40 @@ tvl::value_t callee_filter::match(
     tvl::value_t res = tvl::any_of(
         callee_types_.begin(), callee_types_.end(), [&p, is_lambda](auto ct) {
             auto is_function = [](const participant *p) {
-                return dynamic_cast<const function *>(p) != nullptr;
+                return element_cast<function>(p) != nullptr;
             };
 
             auto is_cuda_kernel = [](const participant *p) {
-                const auto *f = dynamic_cast<const function *>(p);
+                const auto *f = element_cast<function>(p);
                 return (f != nullptr) && (f->is_cuda_kernel());
             };
 
             auto is_cuda_device = [](const participant *p) {
-                const auto *f = dynamic_cast<const function *>(p);
+                const auto *f = element_cast<function>(p);
                 return (f != nullptr) && (f->is_cuda_device());
             };
 
+            const auto *m = element_cast<method>(&p);
+
             switch (ct) {
             case config::callee_type::method:
-                return p.type_name() == "method";
+                return m != nullptr;
             case config::callee_type::constructor:
-                return p.type_name() == "method" &&
-                    ((method &)p).is_constructor();
+                return m != nullptr && m->is_constructor();
             case config::callee_type::assignment:
-                return p.type_name() == "method" &&
-                    ((method &)p).is_assignment();
+                return m != nullptr && m->is_assignment();
             case config::callee_type::operator_:
                 return is_function(&p) && ((function &)p).is_operator();
             case config::callee_type::defaulted:
-                return p.type_name() == "method" &&
-                    ((method &)p).is_defaulted();
+                return m != nullptr && m->is_defaulted();
             case config::callee_type::static_:
                 return is_function(&p) && ((function &)p).is_static();
             case config::callee_type::function:
-                return p.type_name() == "function";
+                return p.kind() == element_kind_t::kParticipantFunction;
             case config::callee_type::function_template:
-                return p.type_name() == "function_template";
+                return p.kind() == element_kind_t::kParticipantFunctionTemplate;
             case config::callee_type::lambda:
-                return p.type_name() == "method" && is_lambda((method &)p);
+                return m != nullptr && is_lambda(*m);
             case config::callee_type::cuda_kernel:
                 return is_cuda_kernel(&p);
             case config::callee_type::cuda_device:
@@ -1229,18 +1254,7 @@ tvl::value_t paths_filter::match(
 
     const auto source_file_path = p.fs_path(root_);
 
-    auto res = memoize(
-        true,
-        [this](const std::filesystem::path &sfp) {
-            return std::any_of(
-                paths_.begin(), paths_.end(), [&](const auto &path) {
-                    return sfp.root_name().string() ==
-                        path.root_name().string() &&
-                        util::is_relative_to(
-                            sfp.relative_path(), path.relative_path());
-                });
-        },
-        source_file_path);
+    tvl::value_t res = is_in_paths(source_file_path.string());
 
     if ((type() == filter_t::kInclusive && tvl::is_false(res)) ||
         (type() == filter_t::kExclusive && tvl::is_true(res))) {
@@ -1272,18 +1286,7 @@ tvl::value_t paths_filter::match(
         return {};
     }
 
-    auto res = memoize(
-        true,
-        [this](const std::filesystem::path &p) {
-            return std::any_of(
-                paths_.begin(), paths_.end(), [&](const auto &path) {
-                    return p.root_name().string() ==
-                        path.root_name().string() &&
-                        util::is_relative_to(
-                            p.relative_path(), path.relative_path());
-                });
-        },
-        source_location_path);
+    tvl::value_t res = is_in_paths(p.file());
 
     if ((type() == filter_t::kInclusive && tvl::is_false(res)) ||
         (type() == filter_t::kExclusive && tvl::is_true(res))) {
@@ -1299,6 +1302,28 @@ tvl::value_t paths_filter::match(
     return match(d, dynamic_cast<const common::model::source_location &>(e));
 }
 
+bool paths_filter::is_in_paths(const std::string &file_path) const
+{
+    {
+        std::shared_lock<std::shared_mutex> l(cache_mutex_);
+        if (auto it = cache_.find(file_path); it != cache_.end())
+            return it->second;
+    }
+
+    const std::filesystem::path fp{file_path};
+
+    const auto result =
+        std::any_of(paths_.begin(), paths_.end(), [&fp](const auto &path) {
+            return fp.root_name().string() == path.root_name().string() &&
+                util::is_relative_to(fp.relative_path(), path.relative_path());
+        });
+
+    std::unique_lock<std::shared_mutex> l(cache_mutex_);
+    cache_.emplace(file_path, result);
+
+    return result;
+}
+
 class_method_filter::class_method_filter(filter_t type,
     std::unique_ptr<access_filter> af, std::unique_ptr<method_type_filter> mtf)
     : filter_visitor{type}
@@ -1382,6 +1407,24 @@ bool diagram_filter::should_include(
     return false;
 }
 
+bool diagram_filter::should_include_source_file(
+    const std::string &file_path) const
+{
+    {
+        std::shared_lock<std::shared_mutex> l(source_file_verdicts_mutex_);
+        if (auto it = source_file_verdicts_.find(file_path);
+            it != source_file_verdicts_.end())
+            return it->second;
+    }
+
+    const auto result = should_include(source_file{file_path});
+
+    std::unique_lock<std::shared_mutex> l(source_file_verdicts_mutex_);
+    source_file_verdicts_.emplace(file_path, result);
+
+    return result;
+}
+
 filter_mode_t diagram_filter::mode() const { return mode_; }
 
 void diagram_filter::set_mode(filter_mode_t mode) { mode_ = mode; }
@@ -30,9 +30,11 @@
 #include "config/config.h"
 #include "include_diagram/model/diagram.h"
 #include "sequence_diagram/model/participant.h"
-#include "util/memoized.h"
 
 #include <filesystem>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
 #include <utility>
 
 namespace clanguml::common::model {
@@ -244,6 +246,7 @@ struct namespace_filter : public filter_visitor {
 
 private:
     std::vector<common::namespace_or_regex> namespaces_;
+    common::regex_set regexes_;
 };
 
 /**
@@ -259,6 +262,7 @@ struct modules_filter : public filter_visitor {
 
 private:
     std::vector<common::string_or_regex> modules_;
+    common::regex_set regexes_;
 };
 
 /**
@@ -706,9 +710,7 @@ private:
  * Match elements based on their source location, whether it matches to
  * a specified file paths.
  */
-struct paths_filter : public filter_visitor,
-                      public util::memoized<std::filesystem::path, bool,
-                          std::filesystem::path> {
+struct paths_filter : public filter_visitor {
     paths_filter(filter_t type, const std::vector<std::string> &p,
         const std::filesystem::path &root);
 
@@ -724,8 +726,21 @@ struct paths_filter : public filter_visitor,
         const diagram &d, const common::model::element &e) const override;
 
 private:
+    /**
+     * @brief Check if an absolute path is located in one of filter paths
+     *
+     * The results are cached for each path.
+     *
+     * @param file_path Absolute file path
+     * @return True, if the file is located in one of the filter paths
+     */
+    bool is_in_paths(const std::string &file_path) const;
+
     std::vector<std::filesystem::path> paths_;
     std::filesystem::path root_;
+
+    mutable std::shared_mutex cache_mutex_;
+    mutable std::unordered_map<std::string, bool> cache_;
 };
 
 /**
@@ -795,6 +810,17 @@ public:
      */
     void add_exclusive_filter(std::unique_ptr<filter_visitor> fv);
 
+    /**
+     * @brief Check if elements declared in a source file can be included
+     *
+     * The results are cached for each file path for the lifetime of the
+     * filter, i.e. for all translation units of the diagram.
+     *
+     * @param file_path Source file path
+     * @return Match result.
+     */
+    bool should_include_source_file(const std::string &file_path) const;
+
     /**
      * `should_include` overload for namespace and name.
      *
@@ -850,6 +876,9 @@ private:
     const common::model::diagram &diagram_;
 
     filter_mode_t mode_{filter_mode_t::basic};
+
+    mutable std::shared_mutex source_file_verdicts_mutex_;
+    mutable std::unordered_map<std::string, bool> source_file_verdicts_;
 };
 
 template <typename Collection>
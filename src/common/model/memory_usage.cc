@@ -0,0 +1,126 @@
+/**
+ * @file src/common/model/memory_usage.cc
+ *
+ * Copyright (c) 2021-2025 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "memory_usage.h"
+
+#include "diagram_element.h"
+#include "element.h"
+#include "relationship.h"
+#include "template_parameter.h"
+
+namespace clanguml::common::model {
+
+namespace {
+// Strings up to this length are stored inside the string object (libstdc++)
+constexpr std::size_t kShortStringCapacity{15};
+} // namespace
+
+uint64_t memory_usage::total() const
+{
+    return elements + relationships + template_params + messages + comments +
+        source_locations + strings;
+}
+
+void memory_usage::add_element(
+    const diagram_element &e, std::size_t object_size)
+{
+    element_count++;
+    elements += object_size - sizeof(source_location);
+
+    add_string(e.name());
+    add_diagram_element_parts(e);
+}
+
+void memory_usage::add_element(const element &e, std::size_t object_size)
+{
+    add_element(static_cast<const diagram_element &>(e), object_size);
+
+    add_strings(e.path().tokens());
+    add_strings(e.using_namespace().tokens());
+
+    if (e.module())
+        add_string(*e.module());
+}
+
+void memory_usage::add_message(
+    const diagram_element &m, std::size_t object_size)
+{
+    message_count++;
+    messages += object_size - sizeof(source_location);
+
+    // Message names are interned, so they are not owned by the message
+    add_diagram_element_parts(m);
+}
+
+void memory_usage::add_template_params(
+    const std::vector<template_parameter> &params)
+{
+    template_param_count += params.size();
+    template_params += params.capacity() * sizeof(template_parameter);
+
+    for (const auto &tp : params) {
+        if (const auto type = tp.type(); type)
+            add_string(*type);
+        if (const auto name = tp.name(); name)
+            add_string(*name);
+        if (tp.default_value())
+            add_string(*tp.default_value());
+        if (tp.concept_constraint())
+            add_string(*tp.concept_constraint());
+
+        add_template_params(tp.template_params());
+    }
+}
+
+void memory_usage::add_comment(const std::optional<comment_t> &comment)
+{
+    if (!comment)
+        return;
+
+    comments += sizeof(comment_t) + comment->dump().size();
+}
+
+void memory_usage::add_string(const std::string &s)
+{
+    if (s.size() > kShortStringCapacity)
+        strings += s.size() + 1;
+}
+
+void memory_usage::add_strings(const std::vector<std::string> &values)
+{
+    for (const auto &s : values)
+        add_string(s);
+}
+
+void memory_usage::add_diagram_element_parts(const diagram_element &e)
+{
+    const auto &rels = e.relationships();
+    relationship_count += rels.size();
+    relationships += rels.capacity() * sizeof(relationship);
+    for (const auto &r : rels) {
+        add_string(r.label());
+        add_string(r.multiplicity_source());
+        add_string(r.multiplicity_destination());
+    }
+
+    add_comment(e.comment());
+
+    source_locations += sizeof(source_location);
+}
+
+} // namespace clanguml::common::model
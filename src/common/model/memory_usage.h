@@ -0,0 +1,126 @@
+/**
+ * @file src/common/model/memory_usage.h
+ *
+ * Copyright (c) 2021-2025 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "decorated_element.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace clanguml::common::model {
+
+class diagram_element;
+class element;
+class template_parameter;
+
+/**
+ * @brief Estimate of memory used by a diagram model, by category
+ *
+ * Sizes are computed from the sizes of model objects and of the contents
+ * of their containers and strings, without the allocator overhead and
+ * without strings shared by the entire process (e.g. interned file paths).
+ */
+struct memory_usage {
+    /** Diagram elements, e.g. classes, their members or participants */
+    uint64_t elements{0};
+    /** Relationships between elements */
+    uint64_t relationships{0};
+    /** Template parameters and arguments */
+    uint64_t template_params{0};
+    /** Sequence diagram messages */
+    uint64_t messages{0};
+    /** Comments attached to elements and messages */
+    uint64_t comments{0};
+    /** Source locations of elements and messages */
+    uint64_t source_locations{0};
+    /** Contents of names, namespaces, types and labels */
+    uint64_t strings{0};
+
+    uint64_t element_count{0};
+    uint64_t relationship_count{0};
+    uint64_t template_param_count{0};
+    uint64_t message_count{0};
+
+    /**
+     * @brief Total estimated memory usage
+     *
+     * @return Sum of all categories in bytes
+     */
+    uint64_t total() const;
+
+    /**
+     * @brief Add a diagram element
+     *
+     * @param e Diagram element
+     * @param object_size Size of the actual element type
+     */
+    void add_element(const diagram_element &e, std::size_t object_size);
+
+    /**
+     * @brief Add a diagram element qualified by namespace
+     *
+     * @param e Element
+     * @param object_size Size of the actual element type
+     */
+    void add_element(const element &e, std::size_t object_size);
+
+    /**
+     * @brief Add a sequence diagram message
+     *
+     * @param m Message
+     * @param object_size Size of the message type
+     */
+    void add_message(const diagram_element &m, std::size_t object_size);
+
+    /**
+     * @brief Add template parameters, including nested ones
+     *
+     * @param params Template parameters
+     */
+    void add_template_params(const std::vector<template_parameter> &params);
+
+    /**
+     * @brief Add an optional comment
+     *
+     * @param comment Comment
+     */
+    void add_comment(const std::optional<comment_t> &comment);
+
+    /**
+     * @brief Add contents of a string
+     *
+     * Strings short enough to fit in the string object do not allocate
+     * any memory.
+     *
+     * @param s String
+     */
+    void add_string(const std::string &s);
+
+    /**
+     * @brief Add contents of a list of strings
+     *
+     * @param values List of strings
+     */
+    void add_strings(const std::vector<std::string> &values);
+
+private:
+    void add_diagram_element_parts(const diagram_element &e);
+};
+
+} // namespace clanguml::common::model
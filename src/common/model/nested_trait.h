@@ -17,12 +17,15 @@
  */
 #pragma once
 
+#include "common/model/diagram_element.h"
 #include "util/util.h"
 
 #include <iostream>
+#include <iterator>
 #include <optional>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace clanguml::common::model {
@@ -33,6 +36,12 @@ namespace clanguml::common::model {
  * This class provides a common trait for diagram elements which can contain
  * other nested elements, e.g. packages.
  *
+ * Children of each nested level are indexed by name in a hash map, and
+ * for each child a pointer to its nested trait (or nullptr if the child
+ * cannot contain other elements) is resolved once, when the child is added.
+ * This way, resolving an element at a nested path of depth d requires only
+ * d hash lookups.
+ *
  * @embed{nested_trait_hierarchy_class.svg}
  *
  * @tparam T Type of element
@@ -43,10 +52,31 @@ public:
     nested_trait() = default;
 
     nested_trait(const nested_trait &) = delete;
-    nested_trait(nested_trait &&) noexcept = default;
+    nested_trait(nested_trait &&other) noexcept
+        : is_root_{other.is_root_}
+        , parent_{other.parent_}
+        , added_elements_{std::move(other.added_elements_)}
+        , elements_{std::move(other.elements_)}
+        , nested_elements_{std::move(other.nested_elements_)}
+        , elements_by_name_{std::move(other.elements_by_name_)}
+    {
+        update_nested_parents();
+    }
 
     nested_trait &operator=(const nested_trait &) = delete;
-    nested_trait &operator=(nested_trait &&) noexcept = default;
+    nested_trait &operator=(nested_trait &&other) noexcept
+    {
+        is_root_ = other.is_root_;
+        parent_ = other.parent_;
+        added_elements_ = std::move(other.added_elements_);
+        elements_ = std::move(other.elements_);
+        nested_elements_ = std::move(other.nested_elements_);
+        elements_by_name_ = std::move(other.elements_by_name_);
+
+        update_nested_parents();
+
+        return *this;
+    }
 
     virtual ~nested_trait() = default;
 
@@ -54,6 +84,14 @@ public:
 
     void is_root(bool a) { is_root_ = a; }
 
+    /**
+     * @brief Get the nested level containing this nested element.
+     *
+     * @return Pointer to the parent nested level or nullptr, if this element
+     *         has not been added to any nested level.
+     */
+    const nested_trait *parent_nested() const { return parent_; }
+
     /**
      * Add element at the current nested level.
      *
@@ -72,7 +110,13 @@ public:
         }
 
         added_elements_.emplace(p->id(), p->type_name());
-        elements_by_name_.emplace(p->name(), elements_.size());
+        elements_by_name_[p->name()].push_back(elements_.size());
+
+        auto *nested_ptr = dynamic_cast<nested_trait<T, Path> *>(p.get());
+        if (nested_ptr != nullptr)
+            nested_ptr->parent_ = this;
+
+        nested_elements_.push_back(nested_ptr);
         elements_.emplace_back(std::move(p));
 
         return true;
@@ -98,16 +142,12 @@ public:
             return add_element(std::move(p));
         }
 
-        auto parent = get_element(path);
+        auto [parent_nested, parent_element] =
+            get_nested(path.begin(), path.end(), path.is_root());
 
-        if (parent) {
-            auto *nested_trait_ptr =
-                dynamic_cast<nested_trait<T, Path> *>(&parent.value());
-            if (nested_trait_ptr != nullptr) {
-                p->set_parent_element_id(parent.value().id());
-                return (*nested_trait_ptr)
-                    .template add_element<V>(std::move(p));
-            }
+        if (parent_nested != nullptr) {
+            p->set_parent_element_id(parent_element->id());
+            return parent_nested->template add_element<V>(std::move(p));
         }
 
         LOG_INFO("No parent element found at: {}", path.to_string());
@@ -125,25 +165,40 @@ public:
      */
     template <typename V = T> auto get_element(const Path &path) const
     {
-        if (path.is_empty() || !has_element(path[0])) {
-            LOG_DBG("Nested element {} not found in element", path.to_string());
+        return get_element<V>(path.begin(), path.end(), path.is_root());
+    }
+
+    /**
+     * Get element at path specified by a range of path segments, if exists.
+     *
+     * @tparam V Element type.
+     * @tparam It Path segment iterator type.
+     * @param first Iterator to the first path segment.
+     * @param last Iterator past the last path segment.
+     * @param is_root Whether the path is absolute (only applies to the
+     *                first path segment).
+     * @return Optional reference to the element.
+     */
+    template <typename V = T, typename It>
+    auto get_element(It first, It last, bool is_root) const
+    {
+        if (first == last) {
+            LOG_DBG("Nested element at empty path not found in element");
             return optional_ref<V>{};
         }
 
-        if (path.size() == 1) {
-            return get_element<V>(path[0], path.is_root());
-        }
+        const auto name_it = std::prev(last);
 
-        auto p = get_element<T>(path[0], path.is_root());
+        if (name_it == first)
+            return get_element<V>(*name_it, is_root);
 
-        if (!p)
-            return optional_ref<V>{};
+        auto [parent_nested, parent_element] =
+            get_nested(first, name_it, is_root);
 
-        if (dynamic_cast<nested_trait<T, Path> *>(&p.value()))
-            return dynamic_cast<nested_trait<T, Path> &>(p.value())
-                .get_element<V>(Path{path.begin() + 1, path.end()});
+        if (parent_nested == nullptr)
+            return optional_ref<V>{};
 
-        return optional_ref<V>{};
+        return parent_nested->template get_element<V>(*name_it, false);
     }
 
     /**
@@ -163,31 +218,22 @@ public:
         // name as some ObjC protocol/interface, so the name is not
         // necessarily unique
 
-        auto [it, matches_end] = elements_by_name_.equal_range(name);
-
-        while (true) {
-            if (it == matches_end)
-                break;
-
-            assert((*it).second < elements_.size());
+        const auto matches = elements_by_name_.find(name);
+        if (matches == elements_by_name_.end())
+            return optional_ref<V>{};
 
-            auto [element_name, element_index] = *it;
+        for (const auto element_index : matches->second) {
+            assert(element_index < elements_.size());
 
             // Return the element if it has the expected type
-            if (auto element_ptr =
-                    dynamic_cast<V *>(elements_.at(element_index).get());
-                element_ptr != nullptr) {
-                if (auto nt_ptr = dynamic_cast<nested_trait<T, Path> *>(
-                        elements_.at(element_index).get());
-                    nt_ptr != nullptr) {
-                    if (nt_ptr->is_root_ == is_root)
-                        return optional_ref<V>{std::ref<V>(*element_ptr)};
-                }
-                else
-                    return optional_ref<V>{std::ref<V>(*element_ptr)};
-            }
+            auto *element_ptr = element_cast<V>(elements_[element_index].get());
+
+            if (element_ptr == nullptr)
+                continue;
 
-            ++it;
+            const auto *nested_ptr = nested_elements_[element_index];
+            if (nested_ptr == nullptr || nested_ptr->is_root_ == is_root)
+                return optional_ref<V>{std::ref<V>(*element_ptr)};
         }
 
         return optional_ref<V>{};
@@ -202,16 +248,15 @@ public:
      */
     template <typename F> bool all_of(F &&f) const
     {
-        return std::all_of(
-            elements_.cbegin(), elements_.cend(), [f](const auto &e) {
-                const auto *package_ptr =
-                    dynamic_cast<nested_trait<T, Path> *>(e.get());
+        for (auto i = 0U; i < elements_.size(); i++) {
+            const auto *nested_ptr = nested_elements_[i];
 
-                if (package_ptr != nullptr)
-                    return package_ptr->all_of(f);
+            if (nested_ptr != nullptr ? !nested_ptr->all_of(f)
+                                      : !f(*elements_[i]))
+                return false;
+        }
 
-                return f(*e);
-            });
+        return true;
     }
 
     /**
@@ -229,11 +274,10 @@ public:
         // If we're interested only in non-package elements, that we have to
         // traverse the nested chain
         return elements_.empty() ||
-            std::all_of(elements_.cbegin(), elements_.cend(), [](auto &e) {
-                const auto *package_ptr =
-                    dynamic_cast<nested_trait<T, Path> *>(e.get());
-                return package_ptr != nullptr && package_ptr->is_empty();
-            });
+            std::all_of(nested_elements_.cbegin(), nested_elements_.cend(),
+                [](const auto *nested_ptr) {
+                    return nested_ptr != nullptr && nested_ptr->is_empty();
+                });
     }
 
     auto begin() { return elements_.begin(); }
@@ -259,11 +303,11 @@ public:
         if (level == 0) {
             std::cout << "--- Printing tree:\n";
         }
-        for (const auto &e : d) {
-            if (dynamic_cast<nested_trait<T, Path> *>(e.get())) {
+        for (auto i = 0U; i < d.elements_.size(); i++) {
+            const auto &e = d.elements_[i];
+            if (d.nested_elements_[i] != nullptr) {
                 std::cout << std::string(level, '.') << "[" << *e << "]\n";
-                dynamic_cast<nested_trait<T, Path> *>(e.get())->print_tree(
-                    level + 1);
+                d.nested_elements_[i]->print_tree(level + 1);
             }
             else {
                 std::cout << std::string(level, '.') << "- " << *e << "]\n";
@@ -273,29 +317,27 @@ public:
 
     void remove(const std::set<eid_t> &element_ids)
     {
-        // Find all elements positions to remove
-        size_t idx{0};
-        for (const auto &e : elements_) {
-            if (element_ids.count(e->id()) > 0) {
-                auto range = elements_by_name_.equal_range(e->name());
-
-                for (auto it = range.first; it != range.second; ++it) {
-                    if (it->second == idx) {
-                        elements_by_name_.erase(it);
-                        break;
-                    }
-                }
+        // First remove all matching elements on this level
+        std::size_t kept{0};
+        for (auto i = 0U; i < elements_.size(); i++) {
+            if (element_ids.count(elements_[i]->id()) > 0)
+                continue;
+
+            if (kept != i) {
+                elements_[kept] = std::move(elements_[i]);
+                nested_elements_[kept] = nested_elements_[i];
             }
-
-            idx++;
+            kept++;
         }
 
-        // First remove all matching elements on this level
-        elements_.erase(std::remove_if(elements_.begin(), elements_.end(),
-                            [&element_ids](auto &&e) {
-                                return element_ids.count(e->id()) > 0;
-                            }),
-            elements_.end());
+        if (kept != elements_.size()) {
+            elements_.resize(kept);
+            nested_elements_.resize(kept);
+
+            elements_by_name_.clear();
+            for (auto i = 0U; i < elements_.size(); i++)
+                elements_by_name_[elements_[i]->name()].push_back(i);
+        }
 
         decltype(added_elements_) to_keep_;
 
@@ -307,31 +349,93 @@ public:
         std::swap(to_keep_, added_elements_);
 
         // Now recurse to any packages on this level
-        for (auto &p : elements_) {
-            if (dynamic_cast<nested_trait<T, Path> *>(p.get()))
-                dynamic_cast<nested_trait<T, Path> *>(p.get())->remove(
-                    element_ids);
+        for (auto *nested_ptr : nested_elements_) {
+            if (nested_ptr != nullptr)
+                nested_ptr->remove(element_ids);
         }
     }
 
+    /**
+     * Find nested level with specified name at the current nested level.
+     *
+     * @param name Name of the nested element.
+     * @param is_root Whether the nested element must be a root element.
+     * @return Pair of the nested level and its element, or nullptr's if
+     *         not found.
+     */
+    std::pair<nested_trait *, T *> get_nested(
+        const std::string &name, bool is_root) const
+    {
+        const auto matches = elements_by_name_.find(name);
+        if (matches == elements_by_name_.end())
+            return {nullptr, nullptr};
+
+        for (const auto element_index : matches->second) {
+            auto *nested_ptr = nested_elements_[element_index];
+            if (nested_ptr != nullptr && nested_ptr->is_root_ == is_root)
+                return {nested_ptr, elements_[element_index].get()};
+        }
+
+        return {nullptr, nullptr};
+    }
+
 private:
     /**
-     * Returns true of this nested level contains an element with specified
-     * name.
+     * Find the nested level at path specified by a range of path segments.
      *
-     * @param name Name of the element.
-     * @return True if element exists.
+     * @tparam It Path segment iterator type.
+     * @param first Iterator to the first path segment.
+     * @param last Iterator past the last path segment.
+     * @param is_root Whether the path is absolute (only applies to the
+     *                first path segment).
+     * @return Pair of the nested level and its element, or nullptr's if
+     *         the path does not exist or the range is empty.
      */
-    bool has_element(const std::string &name) const
+    template <typename It>
+    std::pair<nested_trait *, T *> get_nested(
+        It first, It last, bool is_root) const
     {
-        return elements_by_name_.count(name) != 0U;
+        std::pair<nested_trait *, T *> result{nullptr, nullptr};
+
+        const nested_trait *level{this};
+
+        for (auto it = first; it != last; ++it) {
+            if (it != first)
+                is_root = false;
+
+            result = level->get_nested(*it, is_root);
+
+            if (result.first == nullptr) {
+                LOG_DBG("Nested element {} not found in element", *it);
+                return {nullptr, nullptr};
+            }
+
+            level = result.first;
+        }
+
+        return result;
+    }
+
+    /**
+     * Point parent pointers of nested elements on this level to this
+     * object, e.g. after it has been moved.
+     */
+    void update_nested_parents()
+    {
+        for (auto *nested_ptr : nested_elements_) {
+            if (nested_ptr != nullptr)
+                nested_ptr->parent_ = this;
+        }
     }
 
     bool is_root_{false};
 
+    nested_trait *parent_{nullptr};
+
     std::set<std::pair<eid_t, std::string>> added_elements_;
     std::vector<std::unique_ptr<T>> elements_;
-    std::multimap<std::string, size_t> elements_by_name_;
+    std::vector<nested_trait *> nested_elements_;
+    std::unordered_map<std::string, std::vector<size_t>> elements_by_name_;
 };
 
 } // namespace clanguml::common::model
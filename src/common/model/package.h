@@ -51,6 +51,13 @@ public:
 
     std::string type_name() const override { return "package"; }
 
+    element_kind_t kind() const override { return element_kind_t::kPackage; }
+
+    static bool is_kind(element_kind_t kind)
+    {
+        return kind == element_kind_t::kPackage;
+    }
+
     /**
      * Returns whether the namespace is deprecated.
      *
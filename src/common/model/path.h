@@ -70,6 +70,7 @@ class path {
         return "::";
     }
 
+public:
     /**
      * Returns the path separator based on the type of the instance path.
      *
@@ -77,7 +78,6 @@ class path {
      */
     const char *separator() const { return separator(path_type_); }
 
-public:
     using container_type = std::vector<std::string>;
 
     static container_type split(
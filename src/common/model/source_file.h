@@ -89,6 +89,13 @@ public:
             (type_ == right.type_);
     }
 
+    element_kind_t kind() const override { return element_kind_t::kSourceFile; }
+
+    static bool is_kind(element_kind_t kind)
+    {
+        return kind == element_kind_t::kSourceFile;
+    }
+
     /**
      * Set the path to the element in the diagram.
      *
@@ -17,6 +17,8 @@
  */
 #pragma once
 
+#include "util/string_pool.h"
+
 #include <string>
 #include <utility>
 
@@ -25,14 +27,18 @@ namespace clanguml::common::model {
 /**
  * @brief Base class of all diagram elements that have source location.
  *
+ * File paths are interned in the global string pool, as the same few
+ * thousand paths are repeated in all elements, relationships and messages
+ * of a diagram.
+ *
  * @embed{source_location_hierarchy_class.svg}
  */
 class source_location {
 public:
     source_location() = default;
 
-    source_location(std::string f, unsigned int l)
-        : file_{std::move(f)}
+    source_location(const std::string &f, unsigned int l)
+        : file_{f}
         , line_{l}
     {
     }
@@ -42,35 +48,61 @@ public:
      *
      * @return Absolute file path.
      */
-    const std::string &file() const { return file_; }
+    const std::string &file() const { return file_.str(); }
 
     /**
      * Set absolute file path.
      *
      * @param file Absolute file path.
      */
-    void set_file(const std::string &file) { file_ = file; }
+    void set_file(const std::string &file)
+    {
+        file_ = util::interned_string{file};
+    }
+
+    /**
+     * Set absolute file path from already interned string.
+     *
+     * @param file Absolute file path.
+     */
+    void set_file(util::interned_string file) { file_ = file; }
 
     /**
      * Return source file path relative to `relative_to` config option.
      *
      * @return Relative file path.
      */
-    const std::string &file_relative() const { return file_relative_; }
+    const std::string &file_relative() const { return file_relative_.str(); }
 
     /**
      * Set relative file path.
      *
      * @param file Relative file path.
      */
-    void set_file_relative(const std::string &file) { file_relative_ = file; }
+    void set_file_relative(const std::string &file)
+    {
+        file_relative_ = util::interned_string{file};
+    }
+
+    /**
+     * Set relative file path from already interned string.
+     *
+     * @param file Relative file path.
+     */
+    void set_file_relative(util::interned_string file)
+    {
+        file_relative_ = file;
+    }
 
     /**
      * Get the translation unit, from which this source location was visited.
      *
      * @return Path to the translation unit.
      */
-    const std::string &translation_unit() const { return translation_unit_; }
+    const std::string &translation_unit() const
+    {
+        return translation_unit_.str();
+    }
 
     /**
      * Set the path to translation unit, from which this source location was
@@ -79,6 +111,16 @@ public:
      * @param translation_unit Path to the translation unit.
      */
     void set_translation_unit(const std::string &translation_unit)
+    {
+        translation_unit_ = util::interned_string{translation_unit};
+    }
+
+    /**
+     * Set the path to translation unit from already interned string.
+     *
+     * @param translation_unit Path to the translation unit.
+     */
+    void set_translation_unit(util::interned_string translation_unit)
     {
         translation_unit_ = translation_unit;
     }
@@ -130,9 +172,9 @@ public:
     void set_location_id(unsigned int h) { hash_ = h; }
 
 private:
-    std::string file_;
-    std::string file_relative_;
-    std::string translation_unit_;
+    util::interned_string file_;
+    util::interned_string file_relative_;
+    util::interned_string translation_unit_;
     unsigned int line_{0};
     unsigned int column_{0};
     unsigned int hash_{0};
@@ -0,0 +1,51 @@
+/**
+ * @file src/common/model/template_instantiation_cache.cc
+ *
+ * Copyright (c) 2021-2025 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "template_instantiation_cache.h"
+
+#include <mutex>
+
+namespace clanguml::common::model {
+
+std::shared_ptr<const template_instantiation_cache::entry>
+template_instantiation_cache::get(uint64_t key) const
+{
+    std::shared_lock<std::shared_mutex> l(mutex_);
+
+    const auto it = entries_.find(key);
+    if (it == entries_.end())
+        return {};
+
+    return it->second;
+}
+
+void template_instantiation_cache::add(uint64_t key, entry &&e)
+{
+    std::unique_lock<std::shared_mutex> l(mutex_);
+
+    entries_.emplace(key, std::make_shared<const entry>(std::move(e)));
+}
+
+std::size_t template_instantiation_cache::size() const
+{
+    std::shared_lock<std::shared_mutex> l(mutex_);
+
+    return entries_.size();
+}
+
+} // namespace clanguml::common::model
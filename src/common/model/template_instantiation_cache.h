@@ -0,0 +1,83 @@
+/**
+ * @file src/common/model/template_instantiation_cache.h
+ *
+ * Copyright (c) 2021-2025 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "common/model/relationship.h"
+#include "common/model/template_parameter.h"
+
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace clanguml::common::model {
+
+/**
+ * @brief Diagram-wide cache of processed template instantiation arguments
+ *
+ * Building template parameters of a template instantiation, such as
+ * `std::vector<Foo>`, requires traversing and printing all of its template
+ * arguments. Since the same instantiations appear in many translation units,
+ * and often many times within a single translation unit, the result of
+ * processing the arguments of each instantiation is stored in this cache,
+ * so that later occurrences only have to copy it.
+ */
+class template_instantiation_cache {
+public:
+    /**
+     * @brief Result of processing template arguments of an instantiation
+     */
+    struct entry {
+        /*! Template parameters of the instantiation */
+        std::vector<template_parameter> template_params;
+        /*! Relationships added to the template instantiation */
+        std::vector<relationship> relationships;
+    };
+
+    /**
+     * @brief Get cached entry for a template instantiation
+     *
+     * @param key Key of the template instantiation
+     * @return Cached entry or nullptr
+     */
+    std::shared_ptr<const entry> get(uint64_t key) const;
+
+    /**
+     * @brief Store entry for a template instantiation
+     *
+     * If an entry with the same key already exists, it is not replaced.
+     *
+     * @param key Key of the template instantiation
+     * @param e Entry to store
+     */
+    void add(uint64_t key, entry &&e);
+
+    /**
+     * @brief Get number of cached template instantiations
+     *
+     * @return Number of entries in the cache
+     */
+    std::size_t size() const;
+
+private:
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<uint64_t, std::shared_ptr<const entry>> entries_;
+};
+
+} // namespace clanguml::common::model
@@ -18,6 +18,9 @@
 
 #include "types.h"
 
+#include <algorithm>
+#include <cassert>
+
 namespace clanguml::common {
 
 eid_t::eid_t()
@@ -87,6 +90,68 @@ std::string to_string(const bool v) { return v ? "true" : "false"; }
 
 std::string to_string(const std::string &s) { return s; }
 
+regex::regex(std::regex r, std::string p)
+    : regexp{std::move(r)}
+    , pattern{std::move(p)}
+{
+    // Only case sensitive ECMAScript patterns can be matched by the automaton
+    constexpr auto kUnsupportedFlags = std::regex_constants::icase |
+        std::regex_constants::basic | std::regex_constants::extended |
+        std::regex_constants::awk | std::regex_constants::grep |
+        std::regex_constants::egrep;
+
+    if ((regexp.flags() & kUnsupportedFlags) == 0)
+        automaton = util::regex_automaton::compile({pattern});
+}
+
+void regex_set::add(const regex &r)
+{
+    if (r.automaton) {
+        patterns_.push_back(r);
+        compiled_ = false;
+        return;
+    }
+
+    fallback_.push_back(r.regexp);
+}
+
+void regex_set::compile()
+{
+    automata_.clear();
+    compiled_ = true;
+
+    if (patterns_.empty())
+        return;
+
+    std::vector<std::string> patterns;
+    patterns.reserve(patterns_.size());
+    for (const auto &r : patterns_)
+        patterns.push_back(r.pattern);
+
+    if (auto automaton = util::regex_automaton::compile(patterns); automaton) {
+        automata_.emplace_back(std::move(automaton));
+        return;
+    }
+
+    // The combined automaton is too large, match the patterns one by one
+    for (const auto &r : patterns_)
+        automata_.push_back(r.automaton);
+}
+
+bool regex_set::empty() const { return patterns_.empty() && fallback_.empty(); }
+
+bool regex_set::operator%=(const std::string &v) const
+{
+    assert(compiled_);
+
+    if (std::any_of(automata_.begin(), automata_.end(),
+            [&v](const auto &a) { return a->match(v); }))
+        return true;
+
+    return std::any_of(fallback_.begin(), fallback_.end(),
+        [&v](const auto &r) { return std::regex_match(v, r); });
+}
+
 std::string to_string(const string_or_regex &sr) { return sr.to_string(); }
 
 std::string to_string(const std::filesystem::path &p) { return p.string(); }
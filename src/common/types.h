@@ -26,6 +26,7 @@
 #include <vector>
 
 #include "model/namespace.h"
+#include "util/regex_automaton.h"
 
 namespace clanguml::common {
 
@@ -236,6 +237,10 @@ using reference_set = std::unordered_set<std::reference_wrapper<T>>;
 
 /**
  * @brief Wrapper around std::regex, which contains original pattern
+ *
+ * If the pattern is supported by util::regex_automaton, it is matched using
+ * the automaton instead of `std::regex`, which avoids the backtracking of
+ * `std::regex_match()` on long names.
  */
 struct regex {
     /**
@@ -245,11 +250,7 @@ struct regex {
      * @param p Raw regular expression pattern used for regenerating config and
      *          debugging
      */
-    regex(std::regex r, std::string p)
-        : regexp{std::move(r)}
-        , pattern{std::move(p)}
-    {
-    }
+    regex(std::regex r, std::string p);
 
     /**
      * @brief Regular expression match operator
@@ -258,11 +259,66 @@ struct regex {
      */
     [[nodiscard]] bool operator%=(const std::string &v) const
     {
+        if (automaton)
+            return automaton->match(v);
+
         return std::regex_match(v, regexp);
     }
 
     std::regex regexp;   /*!< Parsed regular expression */
     std::string pattern; /*!< Original regular expression pattern */
+
+    /** Compiled automaton, empty if the pattern is not supported */
+    std::shared_ptr<const util::regex_automaton> automaton;
+};
+
+/**
+ * @brief Set of regular expressions matched in a single pass
+ *
+ * All patterns supported by util::regex_automaton are compiled into a single
+ * automaton, so the cost of matching a value does not grow with the number
+ * of patterns. Remaining patterns are matched one by one using `std::regex`.
+ *
+ * The automaton is built by @ref compile(), which has to be called after all
+ * regular expressions are added and before the set is matched.
+ */
+class regex_set {
+public:
+    /**
+     * @brief Add regular expression to the set
+     *
+     * @param r Regular expression
+     */
+    void add(const regex &r);
+
+    /**
+     * @brief Compile all added regular expressions into a single automaton
+     *
+     * If the combined automaton exceeds the automaton size limit, the
+     * patterns are matched using their own automata instead.
+     */
+    void compile();
+
+    /**
+     * @brief Whether the set contains any regular expressions
+     *
+     * @return True, if no regular expressions were added
+     */
+    bool empty() const;
+
+    /**
+     * @brief Check if any of the regular expressions matches the value
+     *
+     * @param v Value to match
+     * @return True, if any of the regular expressions matches the value
+     */
+    [[nodiscard]] bool operator%=(const std::string &v) const;
+
+private:
+    std::vector<regex> patterns_;
+    std::vector<std::shared_ptr<const util::regex_automaton>> automata_;
+    std::vector<std::regex> fallback_;
+    bool compiled_{true};
 };
 
 /**
@@ -311,7 +367,7 @@ template <typename T> struct or_regex {
     [[nodiscard]] bool operator==(const T &v) const
     {
         if (std::holds_alternative<regex>(value_))
-            return std::regex_match(v, std::get<regex>(value_).regexp);
+            return std::get<regex>(value_) %= v;
 
         return std::get<T>(value_) == v;
     }
@@ -20,6 +20,32 @@
 
 namespace clanguml::common::visitor {
 
+namespace {
+/**
+ * Id map of the last ast_id_mapper destroyed on this thread, kept to reuse
+ * its allocated table for the next translation unit.
+ */
+ast_id_mapper::map_type &recycled_id_map()
+{
+    thread_local ast_id_mapper::map_type map;
+    return map;
+}
+} // namespace
+
+ast_id_mapper::ast_id_mapper()
+    : id_map_{std::move(recycled_id_map())}
+{
+}
+
+ast_id_mapper::~ast_id_mapper()
+{
+    auto &recycled = recycled_id_map();
+    if (id_map_.capacity() > recycled.capacity()) {
+        id_map_.clear();
+        recycled = std::move(id_map_);
+    }
+}
+
 void ast_id_mapper::add(int64_t ast_id, eid_t global_id)
 {
     id_map_[ast_id] = global_id;
@@ -30,10 +56,11 @@ std::optional<eid_t> ast_id_mapper::get_global_id(eid_t ast_id)
     if (ast_id.is_global())
         return {};
 
-    if (id_map_.count(ast_id.ast_local_value()) == 0)
+    const auto it = id_map_.find(ast_id.ast_local_value());
+    if (it == id_map_.end())
         return {};
 
-    return id_map_.at(ast_id.ast_local_value());
+    return it->second;
 }
 
 eid_t ast_id_mapper::resolve_or(eid_t id)
@@ -41,10 +68,13 @@ eid_t ast_id_mapper::resolve_or(eid_t id)
     if (id.is_global())
         return id;
 
-    if (id_map_.count(id.ast_local_value()) == 0)
+    const auto it = id_map_.find(id.ast_local_value());
+    if (it == id_map_.end())
         return id;
 
-    return id_map_.at(id.ast_local_value());
+    return it->second;
 }
 
+std::size_t ast_id_mapper::size() const { return id_map_.size(); }
+
 } // namespace clanguml::common::visitor
\ No newline at end of file
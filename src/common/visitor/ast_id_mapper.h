@@ -18,9 +18,9 @@
 #pragma once
 
 #include "common/model/diagram_element.h"
+#include "util/flat_hash_map.h"
 
 #include <cstdint>
-#include <map>
 
 namespace clanguml::common::visitor {
 
@@ -39,10 +39,20 @@ using clanguml::common::eid_t;
  *
  * This class allows to store mappings between Clang local identifiers
  * in current translation unit and the global identifiers for the element.
+ *
+ * The mapping table of a destroyed mapper is kept by the current thread and
+ * reused by the next mapper created on it, so that translation units
+ * processed by the same thread do not have to grow the table from scratch.
  */
 class ast_id_mapper {
 public:
-    ast_id_mapper() = default;
+    using map_type = util::flat_hash_map<
+        /* Clang AST translation unit local id */ int64_t,
+        /* clang-uml global id */ eid_t>;
+
+    ast_id_mapper();
+
+    ~ast_id_mapper();
 
     /**
      * Add id mapping.
@@ -62,10 +72,15 @@ public:
 
     eid_t resolve_or(eid_t id);
 
+    /**
+     * Number of stored id mappings.
+     *
+     * @return Number of mappings.
+     */
+    std::size_t size() const;
+
 private:
-    std::map</* Clang AST translation unit local id */ int64_t,
-        /* clang-uml global id */ eid_t>
-        id_map_;
+    map_type id_map_;
 };
 
 } // namespace clanguml::common::visitor
\ No newline at end of file
@@ -23,6 +23,7 @@
 #include "common/visitor/ast_id_mapper.h"
 #include "common/visitor/translation_unit_visitor.h"
 #include "config/config.h"
+#include "util/hash.h"
 
 namespace clanguml::common::visitor {
 
@@ -169,6 +170,49 @@ public:
         clanguml::common::model::template_element &template_instantiation,
         const clang::TemplateDecl *template_decl);
 
+    /**
+     * @brief Process template class parameters and arguments, reusing the
+     *        result from the diagram template instantiation cache
+     *
+     * If the same template instantiation was already processed in this
+     * diagram, its template parameters and relationships are copied from
+     * the cache. Otherwise, the arguments are processed and the result is
+     * stored in the cache, unless it depends on the context in which the
+     * instantiation was found, or processing the arguments modified the
+     * parent or added other elements to the diagram.
+     *
+     * @param cache_key Key of the instantiation in the cache, if empty
+     *                  the instantiation is not cacheable
+     * @param parent Optional class in which this template is contained
+     * @param cls Template class specialization declaration
+     * @param template_base_params List of base class template parameters
+     * @param template_args List of template arguments
+     * @param template_instantiation Template class model to add template args
+     * @param template_decl Base template declaration
+     */
+    void process_template_arguments_cached(std::optional<uint64_t> cache_key,
+        std::optional<clanguml::common::model::template_element *> &parent,
+        const clang::NamedDecl *cls,
+        std::deque<std::tuple<std::string, int, bool>> &template_base_params,
+        const clang::ArrayRef<clang::TemplateArgument> &template_args,
+        clanguml::common::model::template_element &template_instantiation,
+        const clang::TemplateDecl *template_decl);
+
+    /**
+     * @brief Calculate the key of a template instantiation in the diagram
+     *        template instantiation cache
+     *
+     * @param template_name Qualified name of the template
+     * @param specialization_name Fully qualified name of the instantiation
+     * @param template_args List of template arguments
+     * @return Key of the instantiation, or empty if the instantiation
+     *         depends on template parameters or contains expressions
+     */
+    std::optional<uint64_t> template_instantiation_cache_key(
+        const std::string &template_name,
+        const std::string &specialization_name,
+        clang::ArrayRef<clang::TemplateArgument> template_args) const;
+
     /**
      * @brief Process template arguments based on their type
      *
@@ -541,6 +585,20 @@ public:
     clang::SourceManager &source_manager() const;
 
 private:
+    /**
+     * @brief Add relationship to a template instantiation
+     *
+     * If the arguments of the instantiation are being stored in the
+     * template instantiation cache, the relationship is recorded, even if
+     * it is a duplicate of an existing relationship.
+     *
+     * @param template_instantiation Template instantiation model
+     * @param r Relationship to add
+     */
+    void add_instantiation_relationship(
+        common::model::template_element &template_instantiation,
+        common::model::relationship &&r);
+
     // Reference to the output diagram model
     clanguml::common::model::diagram &diagram_;
 
@@ -552,6 +610,15 @@ private:
     clang::SourceManager &source_manager_;
 
     VisitorT &visitor_;
+
+    // Whether the template instantiation, which arguments are currently
+    // processed, can be stored in the template instantiation cache
+    bool cacheable_{true};
+
+    // Template instantiation, which arguments are currently processed for
+    // the template instantiation cache, and the relationships added to it
+    const common::model::template_element *recorded_instantiation_{nullptr};
+    std::vector<common::model::relationship> recorded_relationships_;
 };
 
 template <typename VisitorT>
@@ -876,8 +943,11 @@ void template_builder<VisitorT>::build(
             base_index++;
         }
 
-    process_template_arguments(parent, cls, template_base_params,
-        template_arguments, template_instantiation, template_decl);
+    process_template_arguments_cached(
+        template_instantiation_cache_key(template_decl_qualified_name,
+            full_template_specialization_name, template_arguments),
+        parent, cls, template_base_params, template_arguments,
+        template_instantiation, template_decl);
 
     if constexpr (std::is_same_v<typename VisitorT::diagram_t,
                       class_diagram::model::diagram>) {
@@ -915,8 +985,16 @@ void template_builder<VisitorT>::build_from_class_template_specialization(
     template_instantiation.set_name(template_decl->getNameAsString());
     template_instantiation.set_namespace(ns);
 
-    process_template_arguments(parent, &template_specialization,
-        template_base_params,
+    std::string specialization_name;
+    llvm::raw_string_ostream specialization_name_ostream(specialization_name);
+    template_specialization.getNameForDiagnostic(specialization_name_ostream,
+        template_specialization.getASTContext().getPrintingPolicy(), true);
+    specialization_name_ostream.flush();
+
+    process_template_arguments_cached(
+        template_instantiation_cache_key(qualified_name, specialization_name,
+            template_specialization.getTemplateArgs().asArray()),
+        parent, &template_specialization, template_base_params,
         template_specialization.getTemplateArgs().asArray(),
         template_instantiation, template_decl);
 
@@ -1035,6 +1113,115 @@ void template_builder<VisitorT>::process_template_arguments(
         common::to_id(template_instantiation.full_name(false)));
 }
 
+template <typename VisitorT>
+void template_builder<VisitorT>::add_instantiation_relationship(
+    common::model::template_element &template_instantiation,
+    common::model::relationship &&r)
+{
+    if (&template_instantiation == recorded_instantiation_)
+        recorded_relationships_.push_back(r);
+
+    template_instantiation.add_relationship(std::move(r));
+}
+
+template <typename VisitorT>
+void template_builder<VisitorT>::process_template_arguments_cached(
+    std::optional<uint64_t> cache_key,
+    std::optional<clanguml::common::model::template_element *> &parent,
+    const clang::NamedDecl *cls,
+    std::deque<std::tuple<std::string, int, bool>> &template_base_params,
+    const clang::ArrayRef<clang::TemplateArgument> &template_args,
+    clanguml::common::model::template_element &template_instantiation,
+    const clang::TemplateDecl *template_decl)
+{
+    if (!cache_key) {
+        process_template_arguments(parent, cls, template_base_params,
+            template_args, template_instantiation, template_decl);
+        cacheable_ = false;
+        return;
+    }
+
+    auto &cache = diagram().template_instantiations();
+
+    if (const auto cached = cache.get(*cache_key); cached) {
+        LOG_DBG("Reusing cached template arguments for template "
+                "specialization/instantiation {}",
+            template_instantiation.name());
+
+        for (auto argument : cached->template_params)
+            template_instantiation.add_template(std::move(argument));
+
+        for (auto r : cached->relationships)
+            template_instantiation.add_relationship(std::move(r));
+
+        template_instantiation.set_id(
+            common::to_id(template_instantiation.full_name(false)));
+
+        return;
+    }
+
+    const auto template_params_offset =
+        template_instantiation.template_params().size();
+
+    // Nested template instantiations, which are not cacheable, make the
+    // current one not cacheable as well
+    const auto outer_cacheable = std::exchange(cacheable_, true);
+    const auto *outer_recorded_instantiation =
+        std::exchange(recorded_instantiation_, &template_instantiation);
+    auto outer_recorded_relationships =
+        std::exchange(recorded_relationships_, {});
+
+    process_template_arguments(parent, cls, template_base_params,
+        template_args, template_instantiation, template_decl);
+
+    if (cacheable_) {
+        const auto &template_params = template_instantiation.template_params();
+
+        common::model::template_instantiation_cache::entry e;
+        e.template_params.assign(
+            template_params.begin() + template_params_offset,
+            template_params.end());
+        e.relationships = std::move(recorded_relationships_);
+
+        cache.add(*cache_key, std::move(e));
+    }
+
+    cacheable_ = outer_cacheable && cacheable_;
+    recorded_instantiation_ = outer_recorded_instantiation;
+    recorded_relationships_ = std::move(outer_recorded_relationships);
+}
+
+template <typename VisitorT>
+std::optional<uint64_t>
+template_builder<VisitorT>::template_instantiation_cache_key(
+    const std::string &template_name, const std::string &specialization_name,
+    clang::ArrayRef<clang::TemplateArgument> template_args) const
+{
+    // Dependent arguments are resolved using the declaration in which they
+    // were found, and expressions are rendered from their source text, so
+    // such instantiations are not cached
+    const auto is_cacheable = [](const clang::TemplateArgument &arg) {
+        return !arg.isDependent() &&
+            arg.getKind() != clang::TemplateArgument::Expression;
+    };
+
+    for (const auto &arg : template_args) {
+        if (!is_cacheable(arg))
+            return {};
+
+        if (arg.getKind() == clang::TemplateArgument::Pack &&
+            !std::all_of(arg.getPackAsArray().begin(),
+                arg.getPackAsArray().end(), is_cacheable))
+            return {};
+    }
+
+    return util::hash64{}
+        .update(template_name)
+        .update({"\0", 1})
+        .update(specialization_name)
+        .digest();
+}
+
 template <typename VisitorT>
 void template_builder<VisitorT>::argument_process_dispatch(
     std::optional<clanguml::common::model::template_element *> &parent,
@@ -1555,6 +1742,8 @@ template_builder<VisitorT>::try_as_typedef_type(
         // it can be a:
         //   - class/struct
         if (typedef_type->getDecl()->isCXXClassMember() && parent) {
+            // The argument name depends on the parent class
+            cacheable_ = false;
             return template_parameter::make_argument(
                 fmt::format("{}::{}", parent.value()->full_name(false),
                     typedef_type->getDecl()->getNameAsString()));
@@ -1661,6 +1850,10 @@ template_builder<VisitorT>::try_as_template_specialization_type(
 
     if (diagram().should_include(
             namespace_{nested_template_instantiation_full_name})) {
+        // Elements added to the diagram and relationships added to the
+        // parent are not restored from the template instantiation cache
+        cacheable_ = false;
+
         visitor_.set_source_location(*cls, *nested_template_instantiation);
         visitor_.add_diagram_element(std::move(nested_template_instantiation));
     }
@@ -1766,6 +1959,10 @@ template_builder<VisitorT>::try_as_record_type(
             record_type->getAsRecordDecl());
 
     if (class_template_specialization != nullptr) {
+        // Relationships of the argument depend on the elements already
+        // added to the diagram
+        cacheable_ = false;
+
         auto tag_argument =
             visitor_.create_element(class_template_specialization);
 
@@ -1778,8 +1975,9 @@ template_builder<VisitorT>::try_as_record_type(
             argument.set_type(tag_argument->name_and_ns());
             for (const auto &p : tag_argument->template_params())
                 argument.add_template_param(p);
-            for (auto &r : tag_argument->relationships()) {
-                template_instantiation.add_relationship(std::move(r));
+            for (const auto &r : tag_argument->relationships()) {
+                template_instantiation.add_relationship(
+                    common::model::relationship{r});
             }
 
             if (config_.generate_template_argument_dependencies() &&
@@ -1798,8 +1996,8 @@ template_builder<VisitorT>::try_as_record_type(
             diagram().should_include(namespace_{type_name})) {
             // Add dependency relationship to the parent
             // template
-            template_instantiation.add_relationship(
-                {relationship_t::kDependency, type_id});
+            add_instantiation_relationship(
+                template_instantiation, {relationship_t::kDependency, type_id});
         }
     }
 
@@ -1829,8 +2027,8 @@ std::optional<template_parameter> template_builder<VisitorT>::try_as_enum_type(
 
     if (enum_type->getAsTagDecl() != nullptr &&
         config_.generate_template_argument_dependencies()) {
-        template_instantiation.add_relationship(
-            {relationship_t::kDependency, type_id});
+        add_instantiation_relationship(
+            template_instantiation, {relationship_t::kDependency, type_id});
     }
 
     return argument;
@@ -1886,7 +2084,7 @@ bool template_builder<VisitorT>::add_base_classes(
         LOG_DBG("Adding template argument as base class '{}'",
             ct.to_string({}, false));
 
-        dynamic_cast<class_diagram::model::class_ &>(tinst).add_relationship(
+        add_instantiation_relationship(tinst,
             common::model::relationship{
                 maybe_id.value(), common::model::access_t::kPublic, false});
     }
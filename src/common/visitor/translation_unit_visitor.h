@@ -27,6 +27,7 @@
 #include "common/model/template_element.h"
 #include "common/visitor/ast_id_mapper.h"
 #include "config/config.h"
+#include "util/flat_hash_map.h"
 
 #include <clang/AST/Comment.h>
 #include <clang/AST/Expr.h>
@@ -34,10 +35,13 @@
 #include <clang/Basic/Module.h>
 #include <clang/Basic/SourceManager.h>
 
+#include <algorithm>
+#include <cstdint>
 #include <deque>
 #include <functional>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 
 namespace clanguml::common::visitor {
@@ -78,6 +82,8 @@ public:
             comment_visitor_ =
                 std::make_unique<comment::clang_visitor>(source_manager_);
         }
+
+        init_traversal_pruning();
     }
 
     virtual ~translation_unit_visitor() = default;
@@ -87,6 +93,24 @@ public:
         translation_unit_path_ = relative(
             std::filesystem::path{translation_unit_path}, relative_to_path_);
         translation_unit_path_.make_preferred();
+
+        source_paths_cache_.translation_unit =
+            util::interned_string{translation_unit_path_.string()};
+    }
+
+    /**
+     * @brief Set whether the current translation unit is a unity
+     *        translation unit
+     *
+     * Elements from a unity translation unit get the path of the included
+     * translation unit they come from, instead of the unity translation
+     * unit path, which does not exist on disk.
+     *
+     * @param unity True, if the translation unit is a unity translation unit
+     */
+    void set_unity_translation_unit(bool unity)
+    {
+        source_paths_cache_.unity = unity;
     }
 
     /**
@@ -160,8 +184,8 @@ public:
     void set_source_location(const clang::SourceLocation &location,
         clanguml::common::model::source_location &element)
     {
-        common::set_source_location(
-            source_manager(), location, element, tu_path(), relative_to_path_);
+        common::set_source_location(source_manager(), location, element,
+            tu_path(), relative_to_path_, &source_paths_cache_);
     }
 
     void set_owning_module(
@@ -243,8 +267,31 @@ public:
     bool skip_system_header_decl(const clang::NamedDecl *decl) const
     {
         return !config().include_system_headers() &&
-            source_manager().isInSystemHeader(
-                decl->getSourceRange().getBegin());
+            is_in_system_header(decl->getSourceRange().getBegin());
+    }
+
+    /**
+     * @brief Check if a source location is in a system header
+     *
+     * The result is cached for each file in the current translation unit.
+     *
+     * @param loc Source location
+     * @return True, if the location is in a system header
+     */
+    bool is_in_system_header(clang::SourceLocation loc) const
+    {
+        if (loc.isInvalid())
+            return false;
+
+        auto *verdict =
+            find_file_verdict(source_manager().getExpansionLoc(loc));
+        if (verdict == nullptr)
+            return source_manager().isInSystemHeader(loc);
+
+        if (!verdict->is_system_header)
+            verdict->is_system_header = source_manager().isInSystemHeader(loc);
+
+        return *verdict->is_system_header;
     }
 
     /**
@@ -278,15 +325,99 @@ public:
                 common::model::namespace_{decl->getQualifiedNameAsString()});
         }
 
-        const auto decl_file =
-            decl->getLocation().printToString(source_manager());
+        return should_include_namespace && should_include_decl_file(decl);
+    }
+
+    /**
+     * @brief Check if the paths filters include the file of a declaration
+     *
+     * @param decl Clang declaration.
+     * @return True, if the declaration file is included by the diagram.
+     */
+    bool should_include_decl_file(const clang::NamedDecl *decl) const
+    {
+        const auto loc = decl->getLocation();
+
+        // Locations in macro expansions are printed with their spelling
+        // location, so they can't share the verdict of the expansion file
+        auto *verdict = loc.isFileID() ? find_file_verdict(loc) : nullptr;
+        if (verdict != nullptr && verdict->is_included)
+            return *verdict->is_included;
+
+        const auto result = diagram().should_include_source_file(
+            get_file_path(loc.printToString(source_manager())));
 
-        const auto should_include_decl_file = diagram().should_include(
-            common::model::source_file{get_file_path(decl_file)});
+        if (verdict != nullptr)
+            verdict->is_included = result;
 
-        return should_include_namespace && should_include_decl_file;
+        return result;
     }
 
+    /**
+     * @brief Check if the traversal of a declaration can be skipped
+     *
+     * A declaration, together with all declarations nested in it, can be
+     * skipped if the diagram filters can never include any of them, e.g. a
+     * namespace rejected by the namespace filters or a class declared in a
+     * system header or in a file rejected by the paths filters.
+     *
+     * Pruning is only enabled for diagram types and filter configurations,
+     * for which this is equivalent to rejecting each nested declaration
+     * separately in the `Visit*()` methods.
+     *
+     * @param decl Declaration
+     * @return True, if the declaration does not have to be traversed
+     */
+    bool should_skip_traversal(const clang::Decl *decl)
+    {
+        if (decl == nullptr)
+            return false;
+
+        if (const auto *ns = clang::dyn_cast<clang::NamespaceDecl>(decl);
+            ns != nullptr) {
+            // Inline namespaces can be omitted in qualified names matched
+            // by filters
+            if (!prune_namespaces_ || ns->isAnonymousNamespace() ||
+                ns->isInline())
+                return false;
+
+            if (diagram().should_include(
+                    common::model::namespace_{ns->getQualifiedNameAsString()}))
+                return false;
+        }
+        else {
+            const auto *named_decl = clang::dyn_cast<clang::NamedDecl>(decl);
+            if (named_decl == nullptr ||
+                !decl->getDeclContext()->isFileContext())
+                return false;
+
+            const bool skip_system_header = prune_system_headers_ &&
+                is_in_system_header(decl->getSourceRange().getBegin());
+
+            if (!skip_system_header &&
+                (!prune_files_ || should_include_decl_file(named_decl)))
+                return false;
+        }
+
+        skipped_declarations_++;
+
+        return true;
+    }
+
+    /**
+     * @brief Get number of declarations skipped by traversal pruning
+     *
+     * @return Number of declarations, whose traversal was skipped
+     */
+    uint64_t skipped_declarations() const { return skipped_declarations_; }
+
+    /**
+     * @brief Get the cache of printed type and declaration names
+     *
+     * @return Reference to the printing cache of the visitor
+     */
+    common::printing_cache &printing_cache() { return printing_cache_; }
+
     /**
      * @brief Get diagram model reference
      *
@@ -328,6 +459,78 @@ protected:
     }
 
 private:
+    /**
+     * @brief Filter verdicts for a single file in the translation unit
+     */
+    struct file_verdict {
+        std::optional<bool> is_system_header;
+        std::optional<bool> is_included;
+    };
+
+    /**
+     * @brief Find cached filter verdicts for a file location
+     *
+     * Files with `#line` directives are not cached, as locations in them
+     * can resolve to different presumed file names.
+     *
+     * @param loc File source location
+     * @return Pointer to verdicts of the location file or nullptr
+     */
+    file_verdict *find_file_verdict(clang::SourceLocation loc) const
+    {
+        if (loc.isInvalid() || !loc.isFileID())
+            return nullptr;
+
+        const auto file_id = source_manager().getFileID(loc);
+
+        bool invalid{false};
+        const auto &entry = source_manager().getSLocEntry(file_id, &invalid);
+        if (invalid || !entry.isFile() || entry.getFile().hasLineDirectives())
+            return nullptr;
+
+        return &file_verdicts_[file_id.getHashValue()];
+    }
+
+    void init_traversal_pruning()
+    {
+        using common::model::diagram_t;
+
+        const auto type = config_.type();
+        const bool is_basic_filter_mode =
+            config_.filter_mode() == config::filter_mode_t::basic;
+
+        // Package diagrams skip system headers regardless of the config
+        prune_system_headers_ = (type == diagram_t::kClass &&
+                                    !config_.include_system_headers()) ||
+            type == diagram_t::kPackage;
+
+        if (!is_basic_filter_mode)
+            return;
+
+        // Regular expressions can match nested namespaces, even if they
+        // don't match the enclosing namespace
+        const auto has_regex = [](const auto &namespaces) {
+            return std::any_of(namespaces.begin(), namespaces.end(),
+                [](const auto &ns) { return ns.is_regex(); });
+        };
+
+        const bool namespaces_are_literal =
+            !(config_.include && has_regex(config_.include().namespaces)) &&
+            !(config_.exclude && has_regex(config_.exclude().namespaces));
+
+        // Package diagrams only add relationships of packages created
+        // from included namespaces
+        prune_namespaces_ = namespaces_are_literal &&
+            (type == diagram_t::kClass ||
+                (type == diagram_t::kPackage &&
+                    config_.package_type() ==
+                        config::package_type_t::kNamespace));
+
+        prune_files_ = type == diagram_t::kClass &&
+            ((config_.include && !config_.include().paths.empty()) ||
+                (config_.exclude && !config_.exclude().paths.empty()));
+    }
+
     // Reference to the output diagram model
     DiagramT &diagram_;
 
@@ -342,8 +545,23 @@ private:
 
     std::filesystem::path translation_unit_path_;
 
+    // Resolved source file paths, valid for the current translation unit
+    common::source_paths_cache source_paths_cache_;
+
+    // Printed type and declaration names, valid for the current translation
+    // unit
+    common::printing_cache printing_cache_;
+
     std::set<const clang::RawComment *> processed_comments_;
 
     mutable common::visitor::ast_id_mapper id_mapper_;
+
+    // Filter verdicts for each FileID in the current translation unit
+    mutable util::flat_hash_map<unsigned, file_verdict> file_verdicts_;
+
+    bool prune_namespaces_{false};
+    bool prune_system_headers_{false};
+    bool prune_files_{false};
+    uint64_t skipped_declarations_{0};
 };
 } // namespace clanguml::common::visitor
@@ -19,8 +19,11 @@
 #include "config.h"
 #include "diagram_templates.h"
 #include "glob/glob.hpp"
+#include "util/regex_automaton.h"
 
+#include <algorithm>
 #include <filesystem>
+#include <unordered_set>
 
 namespace clanguml::config {
 
@@ -208,6 +211,37 @@ std::string to_string(member_order_t mo)
         return "";
     }
 }
+
+std::string to_string(compile_commands_dedup_t ccd)
+{
+    switch (ccd) {
+    case compile_commands_dedup_t::kFirst:
+        return "first";
+    case compile_commands_dedup_t::kUnion:
+        return "union";
+    case compile_commands_dedup_t::kSemantic:
+        return "semantic";
+    default:
+        assert(false);
+        return "";
+    }
+}
+
+std::string to_string(skip_function_bodies_t sfb)
+{
+    switch (sfb) {
+    case skip_function_bodies_t::never:
+        return "never";
+    case skip_function_bodies_t::outside_main_file:
+        return "outside_main_file";
+    case skip_function_bodies_t::always:
+        return "always";
+    default:
+        assert(false);
+        return "";
+    }
+}
+
 std::string to_string(context_direction_t cd)
 {
     switch (cd) {
@@ -260,6 +294,8 @@ void plantuml::append(const plantuml &r)
     after.insert(after.end(), r.after.begin(), r.after.end());
     if (cmd.empty())
         cmd = r.cmd;
+    if (batch_cmd.empty())
+        batch_cmd = r.batch_cmd;
 }
 
 void mermaid::append(const mermaid &r)
@@ -268,6 +304,8 @@ void mermaid::append(const mermaid &r)
     after.insert(after.end(), r.after.begin(), r.after.end());
     if (cmd.empty())
         cmd = r.cmd;
+    if (batch_cmd.empty())
+        batch_cmd = r.batch_cmd;
 }
 
 void graphml::append(const graphml &r)
@@ -306,6 +344,9 @@ void inheritable_diagram_options::inherit(
     generate_template_argument_dependencies.override(
         parent.generate_template_argument_dependencies);
     package_type.override(parent.package_type);
+    skip_function_bodies.override(parent.skip_function_bodies);
+    minimal_translation_units.override(parent.minimal_translation_units);
+    unity_batch_size.override(parent.unity_batch_size);
     generate_template_argument_dependencies.override(
         parent.generate_template_argument_dependencies);
     skip_redundant_dependencies.override(parent.skip_redundant_dependencies);
@@ -355,26 +396,120 @@ bool inheritable_diagram_options::generate_fully_qualified_name() const
         !generate_packages();
 }
 
-std::vector<std::string> diagram::glob_translation_units(
-    const std::vector<std::string> &compilation_database_files,
-    bool is_fixed) const
+translation_unit_index::translation_unit_index(
+    const std::vector<std::string> &compilation_database_files)
 {
     // Make sure that the paths are in preferred format for a given platform
     // before intersecting the matches with compliation database
-    std::vector<std::string> compilation_database_paths;
-    compilation_database_paths.reserve(compilation_database_files.size());
+    paths_.reserve(compilation_database_files.size());
     for (const auto &cdf : compilation_database_files) {
         std::filesystem::path p{cdf};
         p.make_preferred();
-        compilation_database_paths.emplace_back(p.string());
+        paths_.emplace_back(p.string());
     }
 
+    sorted_paths_ = paths_;
+    sorted_paths_.insert(sorted_paths_.end(),
+        compilation_database_files.begin(), compilation_database_files.end());
+    std::sort(sorted_paths_.begin(), sorted_paths_.end());
+    sorted_paths_.erase(std::unique(sorted_paths_.begin(), sorted_paths_.end()),
+        sorted_paths_.end());
+}
+
+const std::vector<std::string> &translation_unit_index::paths() const
+{
+    return paths_;
+}
+
+bool translation_unit_index::contains(const std::string &path) const
+{
+    return std::binary_search(sorted_paths_.begin(), sorted_paths_.end(), path);
+}
+
+const std::vector<std::string> &translation_unit_index::match_regex(
+    const std::string &pattern, bool existing_only)
+{
+    const auto key = std::make_pair(pattern, existing_only);
+    if (auto it = regex_matches_.find(key); it != regex_matches_.end())
+        return it->second;
+
+    // Use the automaton if the pattern is supported, as it does not
+    // backtrack on long paths
+    const auto automaton = util::regex_automaton::compile({pattern});
+    const auto regex_pattern = automaton
+        ? std::regex{}
+        : std::regex{pattern, std::regex_constants::optimize};
+
+    std::vector<std::string> result;
+    std::copy_if(paths_.begin(), paths_.end(), std::back_inserter(result),
+        [this, &automaton, &regex_pattern, existing_only](const auto &tu) {
+            if (existing_only && !exists(tu))
+                return false;
+
+            if (automaton)
+                return automaton->search(tu);
+
+            return std::regex_search(tu, regex_pattern);
+        });
+
+    return regex_matches_.emplace(key, std::move(result)).first->second;
+}
+
+const std::vector<std::string> &translation_unit_index::match_glob(
+    const std::string &absolute_pattern)
+{
+    if (auto it = glob_matches_.find(absolute_pattern);
+        it != glob_matches_.end())
+        return it->second;
+
+    std::vector<std::string> result;
+    for (const auto &match : glob::glob(absolute_pattern, true, false)) {
+        result.emplace_back(std::filesystem::canonical(match).string());
+    }
+
+    return glob_matches_.emplace(absolute_pattern, std::move(result))
+        .first->second;
+}
+
+bool translation_unit_index::exists(const std::string &path)
+{
+    if (auto it = exists_.find(path); it != exists_.end())
+        return it->second;
+
+    return exists_.emplace(path, std::filesystem::exists(path)).first->second;
+}
+
+std::vector<std::string> diagram::glob_translation_units(
+    const std::vector<std::string> &compilation_database_files,
+    bool is_fixed) const
+{
+    translation_unit_index index{compilation_database_files};
+
+    return glob_translation_units(index, is_fixed);
+}
+
+std::vector<std::string> diagram::glob_translation_units(
+    translation_unit_index &index, bool is_fixed) const
+{
     // If glob is not defined use all translation units from the
     // compilation database
     if (!glob.has_value || (glob().include.empty() && glob().exclude.empty())) {
-        return compilation_database_paths;
+        return index.paths();
     }
 
+    const auto make_absolute_glob_path = [this](const auto &g) {
+        std::filesystem::path absolute_glob_path{g.to_string()};
+
+#ifdef _MSC_VER
+        if (!absolute_glob_path.has_root_name())
+#else
+        if (!absolute_glob_path.is_absolute())
+#endif
+            absolute_glob_path = root_directory() / absolute_glob_path;
+
+        return absolute_glob_path.string();
+    };
+
     // Otherwise, get all translation units matching the glob from diagram
     // configuration
     std::vector<std::string> glob_matches{};
@@ -385,94 +520,52 @@ std::vector<std::string> diagram::glob_translation_units(
         if (g.is_regex()) {
             LOG_DBG("Matching inclusive glob regex {}", g.to_string());
 
-            std::regex regex_pattern(
-                g.to_string(), std::regex_constants::optimize);
-
-            std::copy_if(compilation_database_paths.begin(),
-                compilation_database_paths.end(),
-                std::back_inserter(glob_matches),
-                [&regex_pattern](const auto &tu) {
-                    std::smatch m;
-
-                    return exists(std::filesystem::path{tu}) &&
-                        std::regex_search(tu, m, regex_pattern);
-                });
+            const auto &matches = index.match_regex(g.to_string(), true);
+            glob_matches.insert(
+                glob_matches.end(), matches.begin(), matches.end());
         }
         else {
-            std::filesystem::path absolute_glob_path{g.to_string()};
+            const auto absolute_glob_path = make_absolute_glob_path(g);
 
-#ifdef _MSC_VER
-            if (!absolute_glob_path.has_root_name())
-#else
-            if (!absolute_glob_path.is_absolute())
-#endif
-                absolute_glob_path = root_directory() / absolute_glob_path;
-
-            LOG_DBG("Searching glob path {}", absolute_glob_path.string());
-
-            auto matches = glob::glob(absolute_glob_path.string(), true, false);
+            LOG_DBG("Searching glob path {}", absolute_glob_path);
 
-            for (const auto &match : matches) {
-                const auto path =
-                    std::filesystem::canonical(root_directory() / match);
-
-                glob_matches.emplace_back(path.string());
-            }
+            const auto &matches = index.match_glob(absolute_glob_path);
+            glob_matches.insert(
+                glob_matches.end(), matches.begin(), matches.end());
         }
     }
 
     if (glob().include.empty())
-        glob_matches = compilation_database_paths;
+        glob_matches = index.paths();
 
+    std::unordered_set<std::string> excluded;
     for (const auto &g : glob().exclude) {
         if (g.is_regex()) {
             LOG_DBG("Matching exclusive glob regex {}", g.to_string());
 
-            std::regex regex_pattern(
-                g.to_string(), std::regex_constants::optimize);
-
-            for (const auto &cdf : compilation_database_paths) {
-                std::smatch m;
-                if (std::regex_search(cdf, m, regex_pattern)) {
-                    glob_matches.erase(
-                        remove(begin(glob_matches), end(glob_matches), cdf),
-                        glob_matches.end());
-                }
-            }
+            const auto &matches = index.match_regex(g.to_string(), false);
+            excluded.insert(matches.begin(), matches.end());
         }
         else {
-            std::filesystem::path absolute_glob_path{g.to_string()};
-
-#ifdef _MSC_VER
-            if (!absolute_glob_path.has_root_name())
-#else
-            if (!absolute_glob_path.is_absolute())
-#endif
-                absolute_glob_path = root_directory() / absolute_glob_path;
+            const auto absolute_glob_path = make_absolute_glob_path(g);
 
-            LOG_DBG("Searching exclusive glob path {}",
-                absolute_glob_path.string());
+            LOG_DBG("Searching exclusive glob path {}", absolute_glob_path);
 
-            auto matches = glob::glob(absolute_glob_path.string(), true, false);
-
-            for (const auto &match : matches) {
-                const auto path =
-                    std::filesystem::canonical(root_directory() / match);
-
-                glob_matches.erase(remove(begin(glob_matches),
-                                       end(glob_matches), path.string()),
-                    glob_matches.end());
-            }
+            const auto &matches = index.match_glob(absolute_glob_path);
+            excluded.insert(matches.begin(), matches.end());
         }
     }
 
     // Calculate intersection between glob matches and compilation database
     std::vector<std::string> result;
     for (const auto &gm : glob_matches) {
+        if (excluded.count(gm) > 0)
+            continue;
+
         std::filesystem::path gm_path{gm};
         gm_path.make_preferred();
-        if (is_fixed || util::contains(compilation_database_paths, gm_path) ||
-            util::contains(compilation_database_files, gm)) {
+        if (is_fixed || index.contains(gm_path.string()) ||
+            index.contains(gm)) {
             result.emplace_back(gm_path.string());
         }
     }
@@ -534,6 +627,22 @@ std::optional<std::string> diagram::get_together_group(
     return std::nullopt;
 }
 
+skip_function_bodies_t diagram::function_bodies_to_skip() const
+{
+    // Sequence diagrams are generated from function bodies
+    if (type() == common::model::diagram_t::kSequence)
+        return skip_function_bodies_t::never;
+
+    if (skip_function_bodies)
+        return skip_function_bodies();
+
+    // Include diagrams are generated only from preprocessor callbacks
+    if (type() == common::model::diagram_t::kInclude)
+        return skip_function_bodies_t::always;
+
+    return skip_function_bodies_t::never;
+}
+
 void diagram::initialize_type_aliases()
 {
     if (type_aliases().count("std::basic_string<char>") == 0U) {
@@ -32,6 +32,7 @@
 #include <optional>
 #include <regex>
 #include <string>
+#include <unordered_map>
 #include <variant>
 #include <vector>
 
@@ -145,6 +146,27 @@ enum class member_order_t {
 
 std::string to_string(member_order_t mt);
 
+/*! Which function bodies can be skipped when parsing translation units */
+enum class skip_function_bodies_t {
+    never,             /*!< Parse all function bodies */
+    outside_main_file, /*!< Skip bodies of functions defined outside of
+                            the translation unit source file */
+    always             /*!< Skip all function bodies */
+};
+
+std::string to_string(skip_function_bodies_t sfb);
+
+/*! Which compile commands of a single translation unit should be parsed */
+enum class compile_commands_dedup_t {
+    kFirst,   /*!< Only the first compile command */
+    kUnion,   /*!< Single compile command with include paths and macro
+                   definitions of all compile commands */
+    kSemantic /*!< Compile commands, which differ in other than warning
+                   and diagnostic output flags */
+};
+
+std::string to_string(compile_commands_dedup_t ccd);
+
 /*! Which comment parser should be used */
 enum class comment_parser_t {
     plain, /*!< Basic string parser */
@@ -187,6 +209,9 @@ struct plantuml {
     std::vector<std::string> after;
     /*! Command template to render diagram using PlantUML */
     std::string cmd;
+    /*! Command template to render multiple diagrams in a single PlantUML
+        invocation */
+    std::string batch_cmd;
     /*! Provide customized styles for various elements */
     std::map<std::string, std::string> style;
 
@@ -212,6 +237,9 @@ struct mermaid {
     std::vector<std::string> after;
     /*! Command template to render diagram using MermaidJS */
     std::string cmd;
+    /*! Command template to render multiple diagrams in a single MermaidJS
+        invocation */
+    std::string batch_cmd;
 
     void append(const mermaid &r);
 };
@@ -652,6 +680,10 @@ struct inheritable_diagram_options {
     option<bool> generate_packages{"generate_packages", false};
     option<package_type_t> package_type{
         "package_type", package_type_t::kNamespace};
+    option<skip_function_bodies_t> skip_function_bodies{
+        "skip_function_bodies"};
+    option<bool> minimal_translation_units{"minimal_translation_units", false};
+    option<unsigned> unity_batch_size{"unity_batch_size", 0};
     option<bool> generate_template_argument_dependencies{
         "generate_template_argument_dependencies", true};
     option<bool> skip_redundant_dependencies{
@@ -700,6 +732,70 @@ protected:
         YAML::Emitter &out, const inheritable_diagram_options &c);
 };
 
+/**
+ * @brief Index of compilation database files used to find translation units
+ *        of all diagrams
+ *
+ * The index caches results of all file system operations and glob
+ * expansions, so that each file is only stat'ed and each glob pattern is only
+ * expanded once, regardless of the number of diagrams.
+ *
+ * The index is not thread-safe.
+ */
+class translation_unit_index {
+public:
+    /**
+     * @param compilation_database_files Files in compilation database
+     */
+    explicit translation_unit_index(
+        const std::vector<std::string> &compilation_database_files);
+
+    /**
+     * @brief Get compilation database files in preferred platform format
+     *
+     * @return Compilation database paths in the original order
+     */
+    const std::vector<std::string> &paths() const;
+
+    /**
+     * @brief Check if a path is in the compilation database
+     *
+     * @param path File path, either in preferred or original format
+     * @return True, if the path is in the compilation database
+     */
+    bool contains(const std::string &path) const;
+
+    /**
+     * @brief Get compilation database files matching a regular expression
+     *
+     * @param pattern Regular expression
+     * @param existing_only If true, only existing files are returned
+     * @return Matching paths, in the original order
+     */
+    const std::vector<std::string> &match_regex(
+        const std::string &pattern, bool existing_only);
+
+    /**
+     * @brief Expand a glob pattern
+     *
+     * @param absolute_pattern Absolute glob pattern
+     * @return Canonical paths of all matching files
+     */
+    const std::vector<std::string> &match_glob(
+        const std::string &absolute_pattern);
+
+private:
+    bool exists(const std::string &path);
+
+    std::vector<std::string> paths_;
+    std::vector<std::string> sorted_paths_;
+
+    std::unordered_map<std::string, bool> exists_;
+    std::map<std::pair<std::string, bool>, std::vector<std::string>>
+        regex_matches_;
+    std::unordered_map<std::string, std::vector<std::string>> glob_matches_;
+};
+
 /**
  * @brief Common diagram configuration type
  *
@@ -722,6 +818,16 @@ struct diagram : public inheritable_diagram_options {
         const std::vector<std::string> &compilation_database_files,
         bool is_fixed = false) const;
 
+    /**
+     * @brief Filter translation units based on glob patterns
+     *
+     * @param index Index of compilation database files shared by diagrams
+     * @param is_fixed True, if the compilation database is fixed
+     * @return List of translation unit paths
+     */
+    std::vector<std::string> glob_translation_units(
+        translation_unit_index &index, bool is_fixed = false) const;
+
     /**
      * @brief Make path relative to the `relative_to` config option
      *
@@ -743,6 +849,18 @@ struct diagram : public inheritable_diagram_options {
     std::optional<std::string> get_together_group(
         const std::string &full_name) const;
 
+    /**
+     * @brief Determine which function bodies can be skipped by the parser
+     *
+     * Unless `skip_function_bodies` is set explicitly, function bodies are
+     * only skipped for diagrams which provably do not use any information
+     * from them, i.e. include diagrams. Sequence diagrams always require
+     * function bodies.
+     *
+     * @return Which function bodies should be skipped
+     */
+    skip_function_bodies_t function_bodies_to_skip() const;
+
     /**
      * @brief Initialize predefined set of C++ type aliases
      *
@@ -838,6 +956,12 @@ struct config : public inheritable_diagram_options {
      */
     option<std::string> query_driver{"query_driver"};
 
+    /*! Determines which of the compile commands for a single translation
+     * unit are parsed, after the compile flags have been adjusted
+     */
+    option<compile_commands_dedup_t> compile_commands_dedup{
+        "compile_commands_dedup", compile_commands_dedup_t::kSemantic};
+
     /*! Diagrams output directory */
     option<std::string> output_directory{"output_directory"};
 
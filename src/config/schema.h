@@ -63,6 +63,14 @@ types:
     member_order_t: !variant
         - lexical
         - as_is
+    skip_function_bodies_t: !variant
+        - never
+        - outside_main_file
+        - always
+    compile_commands_dedup_t: !variant
+        - first
+        - union
+        - semantic
     regex_t:
         r: string
     regex_or_string_t: [string, regex_t]
@@ -201,11 +209,13 @@ types:
             before: !optional [string]
             after: !optional [string]
             cmd: !optional string
+            batch_cmd: !optional string
             style: !optional map_t<string;string>
         mermaid: !optional
             before: !optional [string]
             after: !optional [string]
             cmd: !optional string
+            batch_cmd: !optional string
         graphml: !optional
             notes: !optional notes_t
         relative_to: !optional string
@@ -222,6 +232,9 @@ types:
         package_type: !optional package_type_t
         generate_template_argument_dependencies: !optional bool
         skip_redundant_dependencies: !optional bool
+        skip_function_bodies: !optional skip_function_bodies_t
+        minimal_translation_units: !optional bool
+        unity_batch_size: !optional int
         member_order: !optional member_order_t
         group_methods: !optional bool
         type_aliases: !optional map_t<string;string>
@@ -248,10 +261,12 @@ types:
             before: !optional [string]
             after: !optional [string]
             cmd: !optional string
+            batch_cmd: !optional string
         mermaid: !optional
             before: !optional [string]
             after: !optional [string]
             cmd: !optional string
+            batch_cmd: !optional string
         relative_to: !optional string
         type_aliases: !optional map_t<string;string>
         using_namespace: !optional [string, [string]]
@@ -295,10 +310,12 @@ types:
             before: !optional [string]
             after: !optional [string]
             cmd: !optional string
+            batch_cmd: !optional string
         mermaid: !optional
             before: !optional [string]
             after: !optional [string]
             cmd: !optional string
+            batch_cmd: !optional string
         graphml: !optional
             notes: !optional notes_t
         relative_to: !optional string
@@ -311,6 +328,9 @@ types:
         #
         generate_packages: !optional bool
         package_type: !optional package_type_t
+        skip_function_bodies: !optional skip_function_bodies_t
+        minimal_translation_units: !optional bool
+        unity_batch_size: !optional int
         layout: !optional layout_t
     include_diagram_t:
         type: !variant [include]
@@ -333,10 +353,12 @@ types:
             before: !optional [string]
             after: !optional [string]
             cmd: !optional string
+            batch_cmd: !optional string
         mermaid: !optional
             before: !optional [string]
             after: !optional [string]
             cmd: !optional string
+            batch_cmd: !optional string
         graphml: !optional
             notes: !optional notes_t
         relative_to: !optional string
@@ -347,6 +369,7 @@ types:
         # Include diagram specific options
         #
         generate_system_headers: !optional bool
+        skip_function_bodies: !optional skip_function_bodies_t
     diagram_t:
         - class_diagram_t
         - sequence_diagram_t
@@ -366,6 +389,7 @@ root:
     query_driver: !optional string
     add_compile_flags: !optional [string]
     remove_compile_flags: !optional [regex_or_string_t]
+    compile_commands_dedup: !optional compile_commands_dedup_t
     allow_empty_diagrams: !optional bool
     diagram_templates: !optional diagram_templates_t
     diagrams: !optional map_t<string;diagram_t>
@@ -385,10 +409,12 @@ root:
         before: !optional [string]
         after: !optional [string]
         cmd: !optional string
+        batch_cmd: !optional string
     mermaid: !optional
         before: !optional [string]
         after: !optional [string]
         cmd: !optional string
+        batch_cmd: !optional string
     graphml: !optional
         notes: !optional [notes_t]
     relative_to: !optional string
@@ -415,6 +441,9 @@ root:
     package_type: !optional package_type_t
     generate_template_argument_dependencies: !optional bool
     skip_redundant_dependencies: !optional bool
+    skip_function_bodies: !optional skip_function_bodies_t
+    minimal_translation_units: !optional bool
+    unity_batch_size: !optional int
     type_aliases: !optional map_t<string;string>
     filter_mode: !optional filter_mode_t
     include_system_headers: !optional bool
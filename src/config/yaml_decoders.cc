@@ -78,6 +78,7 @@ using clanguml::common::model::module_access_t;
 using clanguml::common::model::relationship_t;
 using clanguml::config::callee_type;
 using clanguml::config::class_diagram;
+using clanguml::config::compile_commands_dedup_t;
 using clanguml::config::config;
 using clanguml::config::context_config;
 using clanguml::config::context_direction_t;
@@ -101,6 +102,7 @@ using clanguml::config::package_type_t;
 using clanguml::config::plantuml;
 using clanguml::config::relationship_hint_t;
 using clanguml::config::sequence_diagram;
+using clanguml::config::skip_function_bodies_t;
 using clanguml::config::source_location;
 
 inline bool has_key(const YAML::Node &n, const std::string &key)
@@ -201,6 +203,42 @@ void get_option<package_type_t>(
     }
 }
 
+template <>
+void get_option<skip_function_bodies_t>(
+    const Node &node, clanguml::config::option<skip_function_bodies_t> &option)
+{
+    if (node[option.name]) {
+        const auto &val = node[option.name].as<std::string>();
+        if (val == "never")
+            option.set(skip_function_bodies_t::never);
+        else if (val == "outside_main_file")
+            option.set(skip_function_bodies_t::outside_main_file);
+        else if (val == "always")
+            option.set(skip_function_bodies_t::always);
+        else
+            throw std::runtime_error(
+                "Invalid skip_function_bodies value: " + val);
+    }
+}
+
+template <>
+void get_option<compile_commands_dedup_t>(const Node &node,
+    clanguml::config::option<compile_commands_dedup_t> &option)
+{
+    if (node[option.name]) {
+        const auto &val = node[option.name].as<std::string>();
+        if (val == "first")
+            option.set(compile_commands_dedup_t::kFirst);
+        else if (val == "union")
+            option.set(compile_commands_dedup_t::kUnion);
+        else if (val == "semantic")
+            option.set(compile_commands_dedup_t::kSemantic);
+        else
+            throw std::runtime_error(
+                "Invalid compile_commands_dedup value: " + val);
+    }
+}
+
 template <>
 void get_option<clanguml::config::comment_parser_t>(const Node &node,
     clanguml::config::option<clanguml::config::comment_parser_t> &option)
@@ -508,6 +546,9 @@ template <> struct convert<plantuml> {
         if (node["cmd"])
             rhs.cmd = node["cmd"].as<decltype(rhs.cmd)>();
 
+        if (node["batch_cmd"])
+            rhs.batch_cmd = node["batch_cmd"].as<decltype(rhs.batch_cmd)>();
+
         if (node["style"])
             rhs.style = node["style"].as<decltype(rhs.style)>();
 
@@ -527,6 +568,9 @@ template <> struct convert<mermaid> {
         if (node["cmd"])
             rhs.cmd = node["cmd"].as<decltype(rhs.cmd)>();
 
+        if (node["batch_cmd"])
+            rhs.batch_cmd = node["batch_cmd"].as<decltype(rhs.batch_cmd)>();
+
         return true;
     }
 };
@@ -829,6 +873,9 @@ template <> struct convert<class_diagram> {
         get_option(node, rhs.package_type);
         get_option(node, rhs.generate_template_argument_dependencies);
         get_option(node, rhs.skip_redundant_dependencies);
+        get_option(node, rhs.skip_function_bodies);
+        get_option(node, rhs.minimal_translation_units);
+        get_option(node, rhs.unity_batch_size);
         get_option(node, rhs.relationship_hints);
         get_option(node, rhs.type_aliases);
 
@@ -885,6 +932,9 @@ template <> struct convert<package_diagram> {
 
         get_option(node, rhs.layout);
         get_option(node, rhs.package_type);
+        get_option(node, rhs.skip_function_bodies);
+        get_option(node, rhs.minimal_translation_units);
+        get_option(node, rhs.unity_batch_size);
 
         get_option(node, rhs.get_relative_to());
 
@@ -904,6 +954,7 @@ template <> struct convert<include_diagram> {
         get_option(node, rhs.layout);
         get_option(node, rhs.generate_system_headers);
         get_option(node, rhs.generate_packages, true);
+        get_option(node, rhs.skip_function_bodies);
 
         get_option(node, rhs.get_relative_to());
 
@@ -1044,6 +1095,7 @@ template <> struct convert<config> {
         get_option(node, rhs.filter_mode);
         get_option(node, rhs.output_directory);
         get_option(node, rhs.query_driver);
+        get_option(node, rhs.compile_commands_dedup);
         get_option(node, rhs.allow_empty_diagrams);
         get_option(node, rhs.compilation_database_dir);
         get_option(node, rhs.add_compile_flags);
@@ -1058,6 +1110,9 @@ template <> struct convert<config> {
         get_option(node, rhs.package_type);
         get_option(node, rhs.generate_template_argument_dependencies);
         get_option(node, rhs.skip_redundant_dependencies);
+        get_option(node, rhs.skip_function_bodies);
+        get_option(node, rhs.minimal_translation_units);
+        get_option(node, rhs.unity_batch_size);
         get_option(node, rhs.generate_links);
         get_option(node, rhs.generate_system_headers);
         get_option(node, rhs.git);
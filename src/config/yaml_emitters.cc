@@ -110,6 +110,20 @@ YAML::Emitter &operator<<(YAML::Emitter &out, const package_type_t &r)
     return out;
 }
 
+YAML::Emitter &operator<<(
+    YAML::Emitter &out, const skip_function_bodies_t &sfb)
+{
+    out << to_string(sfb);
+    return out;
+}
+
+YAML::Emitter &operator<<(
+    YAML::Emitter &out, const compile_commands_dedup_t &ccd)
+{
+    out << to_string(ccd);
+    return out;
+}
+
 YAML::Emitter &operator<<(YAML::Emitter &out, const context_config &c)
 {
     out << YAML::BeginMap;
@@ -177,6 +191,8 @@ YAML::Emitter &operator<<(YAML::Emitter &out, const plantuml &p)
         out << YAML::Key << "after" << YAML::Value << p.after;
     if (!p.cmd.empty())
         out << YAML::Key << "cmd" << YAML::Value << p.cmd;
+    if (!p.batch_cmd.empty())
+        out << YAML::Key << "batch_cmd" << YAML::Value << p.batch_cmd;
     if (!p.style.empty())
         out << YAML::Key << "style" << YAML::Value << p.style;
     out << YAML::EndMap;
@@ -198,6 +214,8 @@ YAML::Emitter &operator<<(YAML::Emitter &out, const mermaid &p)
         out << YAML::Key << "after" << YAML::Value << p.after;
     if (!p.cmd.empty())
         out << YAML::Key << "cmd" << YAML::Value << p.cmd;
+    if (!p.batch_cmd.empty())
+        out << YAML::Key << "batch_cmd" << YAML::Value << p.batch_cmd;
     out << YAML::EndMap;
 
     return out;
@@ -377,6 +395,7 @@ YAML::Emitter &operator<<(YAML::Emitter &out, const config &c)
     out << c.query_driver;
     out << c.add_compile_flags;
     out << c.remove_compile_flags;
+    out << c.compile_commands_dedup;
     out << c.diagram_templates;
 
     out << dynamic_cast<const inheritable_diagram_options &>(c);
@@ -448,6 +467,9 @@ YAML::Emitter &operator<<(
         out << c.package_type;
         out << c.generate_template_argument_dependencies;
         out << c.skip_redundant_dependencies;
+        out << c.skip_function_bodies;
+        out << c.minimal_translation_units;
+        out << c.unity_batch_size;
     }
     else if (const auto *sd = dynamic_cast<const sequence_diagram *>(&c);
              sd != nullptr) {
@@ -469,11 +491,15 @@ YAML::Emitter &operator<<(
         out << pd->title;
         out << c.generate_packages;
         out << c.package_type;
+        out << c.skip_function_bodies;
+        out << c.minimal_translation_units;
+        out << c.unity_batch_size;
     }
     else if (const auto *id = dynamic_cast<const include_diagram *>(&c);
              id != nullptr) {
         out << id->title;
         out << c.generate_system_headers;
+        out << c.skip_function_bodies;
     }
 
     return out;
@@ -541,12 +567,13 @@ template <> bool is_null(const glob_t &v)
 template <> bool is_null(const plantuml &v)
 {
     return v.before.empty() && v.after.empty() && v.cmd.empty() &&
-        v.style.empty();
+        v.batch_cmd.empty() && v.style.empty();
 }
 
 template <> bool is_null(const mermaid &v)
 {
-    return v.before.empty() && v.after.empty() && v.cmd.empty();
+    return v.before.empty() && v.after.empty() && v.cmd.empty() &&
+        v.batch_cmd.empty();
 }
 
 template <> bool is_null(const graphml &v) { return v.notes.empty(); }
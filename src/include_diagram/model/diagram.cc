@@ -136,6 +136,14 @@ void diagram::apply_filter()
 
 bool diagram::is_empty() const { return element_view<source_file>::is_empty(); }
 
+void diagram::estimate_memory_usage(common::model::memory_usage &usage) const
+{
+    for (const auto &f : files()) {
+        usage.add_element(f.get(), sizeof(source_file));
+        usage.add_strings(f.get().path().tokens());
+    }
+}
+
 } // namespace clanguml::include_diagram::model
 
 namespace clanguml::common::model {
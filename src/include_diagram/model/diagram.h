@@ -130,6 +130,14 @@ public:
     bool is_empty() const override;
 
     void apply_filter() override;
+
+    /**
+     * @brief Estimate memory used by the diagram model
+     *
+     * @param usage Memory usage to which the diagram model is added
+     */
+    void estimate_memory_usage(
+        common::model::memory_usage &usage) const override;
 };
 
 template <typename ElementT>
@@ -20,6 +20,7 @@
 #include "common/compilation_database.h"
 #include "common/generators/generators.h"
 #include "util/query_driver_output_extractor.h"
+#include "util/trace.h"
 #include "util/util.h"
 
 #ifdef ENABLE_BACKWARD_CPP
@@ -45,6 +46,9 @@ int main(int argc, const char *argv[])
 {
     cli::cli_handler cli;
 
+    // Write the trace, if enabled, also when the generation fails
+    const util::trace_writer trace_writer;
+
     try {
         auto res = cli.handle_options(argc, argv);
 
@@ -89,6 +89,12 @@ void diagram::apply_filter()
 }
 
 bool diagram::is_empty() const { return element_view<package>::is_empty(); }
+
+void diagram::estimate_memory_usage(common::model::memory_usage &usage) const
+{
+    for (const auto &p : packages())
+        usage.add_element(p.get(), sizeof(package));
+}
 } // namespace clanguml::package_diagram::model
 
 namespace clanguml::common::model {
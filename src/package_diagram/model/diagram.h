@@ -162,6 +162,14 @@ public:
 
     void apply_filter() override;
 
+    /**
+     * @brief Estimate memory used by the diagram model
+     *
+     * @param usage Memory usage to which the diagram model is added
+     */
+    void estimate_memory_usage(
+        common::model::memory_usage &usage) const override;
+
     /**
      * @brief Get reference to vector of elements of specific type
      *
@@ -275,32 +283,51 @@ bool diagram::add_with_module_path(
     // model
     auto module_relative_to = path{p->using_namespace()};
 
+    // Walk the parent path only once, carrying the parent package forward
+    nested_trait_ns *parent{this};
+    common::model::element *parent_element{nullptr};
     for (auto it = parent_path.begin(); it != parent_path.end(); it++) {
-        auto pkg = std::make_unique<common::model::package>(
-            p->using_namespace(), common::model::path_type::kModule);
-        pkg->set_name(*it);
+        auto [nested, nested_element] = parent->get_nested(*it, false);
+
+        if (nested == nullptr) {
+            auto pkg = std::make_unique<common::model::package>(
+                p->using_namespace(), common::model::path_type::kModule);
+            pkg->set_name(*it);
+
+            auto module_relative_part = common::model::path(
+                parent_path.begin(), it, common::model::path_type::kModule);
+
+            auto module_absolute_path =
+                module_relative_to | module_relative_part;
+            pkg->set_module(module_absolute_path.to_string());
+            pkg->set_namespace(module_absolute_path);
 
-        auto module_relative_part = common::model::path(
-            parent_path.begin(), it, common::model::path_type::kModule);
+            auto package_absolute_path = module_absolute_path | pkg->name();
 
-        auto module_absolute_path = module_relative_to | module_relative_part;
-        pkg->set_module(module_absolute_path.to_string());
-        pkg->set_namespace(module_absolute_path);
+            pkg->set_id(common::to_id(package_absolute_path.to_string()));
+            if (parent_element != nullptr)
+                pkg->set_parent_element_id(parent_element->id());
 
-        auto package_absolute_path = module_absolute_path | pkg->name();
+            auto &pkg_ref = *pkg;
+            if (!parent->add_element(std::move(pkg)))
+                return false;
 
-        pkg->set_id(common::to_id(package_absolute_path.to_string()));
+            element_view<ElementT>::add(std::ref(pkg_ref));
 
-        auto p_ref = std::ref(*pkg);
+            nested = &pkg_ref;
+            nested_element = &pkg_ref;
+        }
 
-        auto res = add_element(module_relative_part, std::move(pkg));
-        if (res)
-            element_view<ElementT>::add(p_ref);
+        parent = nested;
+        parent_element = nested_element;
     }
 
     auto p_ref = std::ref(*p);
 
-    auto res = add_element(parent_path, std::move(p));
+    if (parent_element != nullptr)
+        p->set_parent_element_id(parent_element->id());
+
+    auto res = parent->add_element(std::move(p));
     if (res)
         element_view<ElementT>::add(p_ref);
 
@@ -314,21 +341,43 @@ bool diagram::add_with_filesystem_path(
     LOG_TRACE("Adding package: {}, {}", p->name(), p->full_name(true));
 
     // Make sure all parent directories are already packages in the
-    // model
+    // model, walking the parent path only once
+    nested_trait_ns *parent{this};
+    common::model::element *parent_element{nullptr};
     for (auto it = parent_path.begin(); it != parent_path.end(); it++) {
-        auto pkg = std::make_unique<common::model::package>(
-            p->using_namespace(), common::model::path_type::kFilesystem);
-        pkg->set_name(*it);
-        auto ns = common::model::path(
-            parent_path.begin(), it, common::model::path_type::kFilesystem);
-        pkg->set_namespace(ns);
-        pkg->set_id(common::to_id(pkg->full_name(false)));
-
-        add_with_filesystem_path(ns, std::move(pkg));
+        auto [nested, nested_element] = parent->get_nested(*it, false);
+
+        if (nested == nullptr) {
+            auto pkg = std::make_unique<common::model::package>(
+                p->using_namespace(), common::model::path_type::kFilesystem);
+            pkg->set_name(*it);
+            auto ns = common::model::path(
+                parent_path.begin(), it, common::model::path_type::kFilesystem);
+            pkg->set_namespace(ns);
+            pkg->set_id(common::to_id(pkg->full_name(false)));
+            if (parent_element != nullptr)
+                pkg->set_parent_element_id(parent_element->id());
+
+            auto &pkg_ref = *pkg;
+            if (!parent->add_element(std::move(pkg)))
+                return false;
+
+            element_view<ElementT>::add(std::ref(pkg_ref));
+
+            nested = &pkg_ref;
+            nested_element = &pkg_ref;
+        }
+
+        parent = nested;
+        parent_element = nested_element;
     }
 
     auto pp = std::ref(*p);
-    auto res = add_element(parent_path, std::move(p));
+
+    if (parent_element != nullptr)
+        p->set_parent_element_id(parent_element->id());
+
+    auto res = parent->add_element(std::move(p));
     if (res)
         element_view<ElementT>::add(pp);
 
@@ -42,6 +42,14 @@ translation_unit_visitor::translation_unit_visitor(clang::SourceManager &sm,
 {
 }
 
+bool translation_unit_visitor::TraverseDecl(clang::Decl *decl)
+{
+    if (should_skip_traversal(decl))
+        return true;
+
+    return RecursiveASTVisitor<translation_unit_visitor>::TraverseDecl(decl);
+}
+
 bool translation_unit_visitor::VisitNamespaceDecl(clang::NamespaceDecl *ns)
 {
     assert(ns != nullptr);
@@ -432,7 +440,7 @@ eid_t translation_unit_visitor::get_package_id(const clang::Decl *cls)
         relative_file.string(), common::model::path_type::kFilesystem};
     parent_path.pop_back();
 
-    return common::to_id(parent_path.to_string());
+    return common::to_id(parent_path);
 }
 
 void translation_unit_visitor::process_class_declaration(
@@ -21,23 +21,25 @@
 namespace clanguml::sequence_diagram::model {
 
 using clanguml::common::generators::display_name_adapter;
+using clanguml::common::model::element_kind_t;
 
 void to_json(nlohmann::json &j, const participant &c)
 {
     to_json(j, dynamic_cast<const participant::element &>(c));
     j["type"] = c.type_name();
 
-    if (c.type_name() == "method") {
-        j["name"] = dynamic_cast<const method &>(c).method_name();
+    if (c.kind() == element_kind_t::kParticipantMethod) {
+        j["name"] = static_cast<const method &>(c).method_name();
     }
-    else if (c.type_name() == "objc_method") {
-        j["name"] = dynamic_cast<const objc_method &>(c).method_name();
+    else if (c.kind() == element_kind_t::kParticipantObjCMethod) {
+        j["name"] = static_cast<const objc_method &>(c).method_name();
     }
 
     j["full_name"] = display_name_adapter(c).full_name(false);
 
-    if (c.type_name() == "function" || c.type_name() == "function_template") {
-        const auto &f = dynamic_cast<const function &>(c);
+    if (c.kind() == element_kind_t::kParticipantFunction ||
+        c.kind() == element_kind_t::kParticipantFunctionTemplate) {
+        const auto &f = static_cast<const function &>(c);
         if (f.is_cuda_kernel())
             j["is_cuda_kernel"] = true;
         if (f.is_cuda_device())
@@ -57,6 +59,8 @@ void to_json(nlohmann::json &j, const activity &c)
 namespace clanguml::sequence_diagram::generators::json {
 
 using clanguml::common::generators::display_name_adapter;
+using clanguml::common::model::element_cast;
+using clanguml::common::model::element_kind_t;
 using clanguml::common::model::message_t;
 using clanguml::config::location_t;
 using clanguml::sequence_diagram::model::activity;
@@ -92,21 +96,22 @@ void generator::generate_call(const message &m, nlohmann::json &parent) const
     model::function::message_render_mode render_mode =
         model::function::message_render_mode::full;
 
-    if (to.value().type_name() == "method") {
-        message = dynamic_cast<const model::method &>(to.value())
+    if (to.value().kind() == element_kind_t::kParticipantMethod) {
+        message = static_cast<const model::method &>(to.value())
                       .message_name(render_mode);
     }
-    else if (to.value().type_name() == "objc_method") {
-        message = dynamic_cast<const model::objc_method &>(to.value())
+    else if (to.value().kind() == element_kind_t::kParticipantObjCMethod) {
+        message = static_cast<const model::objc_method &>(to.value())
                       .message_name(render_mode);
     }
     else if (config().combine_free_functions_into_file_participants()) {
-        if (to.value().type_name() == "function") {
-            message = dynamic_cast<const model::function &>(to.value())
+        if (to.value().kind() == element_kind_t::kParticipantFunction) {
+            message = static_cast<const model::function &>(to.value())
                           .message_name(render_mode);
         }
-        else if (to.value().type_name() == "function_template") {
-            message = dynamic_cast<const model::function_template &>(to.value())
+        else if (to.value().kind() ==
+            element_kind_t::kParticipantFunctionTemplate) {
+            message = static_cast<const model::function_template &>(to.value())
                           .message_name(render_mode);
         }
     }
@@ -143,14 +148,14 @@ void generator::generate_to_activity(
     nlohmann::json &msg) const
 {
     msg["to"]["activity_id"] = std::to_string(to.value().id().value());
-    if (to.value().type_name() == "method") {
+    if (to.value().kind() == element_kind_t::kParticipantMethod) {
         const auto &class_participant =
             model().get_participant<model::method>(to.value().id()).value();
 
         msg["to"]["participant_id"] =
             std::to_string(class_participant.class_id().value());
     }
-    else if (to.value().type_name() == "objc_method") {
+    else if (to.value().kind() == element_kind_t::kParticipantObjCMethod) {
         const auto &class_participant =
             model()
                 .get_participant<model::objc_method>(to.value().id())
@@ -159,8 +164,8 @@ void generator::generate_to_activity(
         msg["to"]["participant_id"] =
             std::to_string(class_participant.class_id().value());
     }
-    else if (to.value().type_name() == "function" ||
-        to.value().type_name() == "function_template") {
+    else if (to.value().kind() == element_kind_t::kParticipantFunction ||
+        to.value().kind() == element_kind_t::kParticipantFunctionTemplate) {
         if (config().combine_free_functions_into_file_participants()) {
             const auto &file_participant =
                 model()
@@ -174,7 +179,8 @@ void generator::generate_to_activity(
                 std::to_string(to.value().id().value());
         }
     }
-    else if (to.value().type_name() == "lambda") {
+    else if (const auto *c = element_cast<model::class_>(&to.value());
+             c != nullptr && c->is_lambda()) {
         msg["to"]["participant_id"] = std::to_string(to.value().id().value());
     }
 }
@@ -187,14 +193,14 @@ void generator::generate_from_activity(const message &m,
     if (const auto &cmt = m.comment(); cmt.has_value())
         msg["comment"] = cmt.value().at("comment");
 
-    if (from.value().type_name() == "method") {
+    if (from.value().kind() == element_kind_t::kParticipantMethod) {
         const auto &class_participant =
             model().get_participant<model::method>(from.value().id()).value();
 
         msg["from"]["participant_id"] =
             std::to_string(class_participant.class_id().value());
     }
-    else if (from.value().type_name() == "objc_method") {
+    else if (from.value().kind() == element_kind_t::kParticipantObjCMethod) {
         const auto &class_participant =
             model()
                 .get_participant<model::objc_method>(from.value().id())
@@ -203,8 +209,8 @@ void generator::generate_from_activity(const message &m,
         msg["from"]["participant_id"] =
             std::to_string(class_participant.class_id().value());
     }
-    else if (from.value().type_name() == "function" ||
-        from.value().type_name() == "function_template") {
+    else if (from.value().kind() == element_kind_t::kParticipantFunction ||
+        from.value().kind() == element_kind_t::kParticipantFunctionTemplate) {
         if (config().combine_free_functions_into_file_participants()) {
             const auto &file_participant =
                 model()
@@ -218,7 +224,8 @@ void generator::generate_from_activity(const message &m,
                 std::to_string(from.value().id().value());
         }
     }
-    else if (from.value().type_name() == "lambda") {
+    else if (const auto *c = element_cast<model::class_>(&from.value());
+             c != nullptr && c->is_lambda()) {
         msg["from"]["participant_id"] =
             std::to_string(from.value().id().value());
     }
@@ -328,7 +335,7 @@ void generator::process_call_message(
 
     generate_call(m, current_block_statement());
 
-    if (model().sequences().find(m.to()) != model().sequences().end()) {
+    if (model().sequences().contains(m.to())) {
         if (std::find(visited.begin(), visited.end(), m.to()) ==
             visited.end()) { // break infinite recursion on recursive calls
 
@@ -887,7 +894,7 @@ void generator::generate_from_sequences(nlohmann::json &parent) const
 
         block_statements_stack_.pop_back();
 
-        if (from.value().type_name() == "method" ||
+        if (from.value().kind() == element_kind_t::kParticipantMethod ||
             config().combine_free_functions_into_file_participants()) {
 
             sequence["return_type"] =
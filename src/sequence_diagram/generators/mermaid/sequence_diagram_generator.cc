@@ -21,6 +21,7 @@
 namespace clanguml::sequence_diagram::generators::mermaid {
 
 using clanguml::common::generators::display_name_adapter;
+using clanguml::common::model::element_kind_t;
 using clanguml::common::model::message_t;
 using clanguml::config::location_t;
 using clanguml::sequence_diagram::model::message;
@@ -108,21 +109,21 @@ void generator::generate_call(const message &m, std::ostream &ostr) const
     model::function::message_render_mode render_mode =
         select_method_arguments_render_mode();
 
-    if (to.value().type_name() == "method") {
-        const auto &f = dynamic_cast<const model::method &>(to.value());
+    if (to.value().kind() == element_kind_t::kParticipantMethod) {
+        const auto &f = static_cast<const model::method &>(to.value());
         if (m.type() == message_t::kCoAwait)
             message = fmt::format(
                 "<< co_await >><br>{}", f.message_name(render_mode));
         else
             message = f.message_name(render_mode);
     }
-    else if (to.value().type_name() == "objc_method") {
-        const auto &f = dynamic_cast<const model::objc_method &>(to.value());
+    else if (to.value().kind() == element_kind_t::kParticipantObjCMethod) {
+        const auto &f = static_cast<const model::objc_method &>(to.value());
         message = f.message_name(render_mode);
     }
     else if (config().combine_free_functions_into_file_participants()) {
-        if (to.value().type_name() == "function") {
-            const auto &f = dynamic_cast<const model::function &>(to.value());
+        if (to.value().kind() == element_kind_t::kParticipantFunction) {
+            const auto &f = static_cast<const model::function &>(to.value());
 
             message = f.message_name(render_mode);
 
@@ -133,8 +134,9 @@ void generator::generate_call(const message &m, std::ostream &ostr) const
             else if (f.is_coroutine())
                 message = fmt::format("<< Coroutine >><br>{}", message);
         }
-        else if (to.value().type_name() == "function_template") {
-            const auto &f = dynamic_cast<const model::function &>(to.value());
+        else if (to.value().kind() ==
+            element_kind_t::kParticipantFunctionTemplate) {
+            const auto &f = static_cast<const model::function &>(to.value());
             message = f.message_name(render_mode);
 
             if (f.is_cuda_kernel())
@@ -213,8 +215,8 @@ void generator::generate_return(const message &m, std::ostream &ostr) const
         }
     }
     else if (from.has_value() && !from.value().is_void() &&
-        (from.value().type_name() == "method" ||
-            from.value().type_name() == "objc_method" ||
+        (from.value().kind() == element_kind_t::kParticipantMethod ||
+            from.value().kind() == element_kind_t::kParticipantObjCMethod ||
             config().combine_free_functions_into_file_participants())) {
         const std::string from_alias = generate_alias(from.value());
 
@@ -301,7 +303,7 @@ void generator::generate_activity(
 
             ostr << indent(1) << "activate " << to_alias << '\n';
 
-            if (model().sequences().find(m.to()) != model().sequences().end()) {
+            if (model().sequences().contains(m.to())) {
                 if (std::find(visited.begin(), visited.end(), m.to()) ==
                     visited
                         .end()) { // break infinite recursion on recursive calls
@@ -484,7 +486,7 @@ void generator::generate_participant(
     const auto &participant =
         model().get_participant<model::participant>(participant_id).value();
 
-    if (participant.type_name() == "method") {
+    if (participant.kind() == element_kind_t::kParticipantMethod) {
         const auto class_id =
             model()
                 .get_participant<model::method>(participant_id)
@@ -511,7 +513,7 @@ void generator::generate_participant(
 
         generated_participants_.emplace(class_id);
     }
-    else if (participant.type_name() == "objc_method") {
+    else if (participant.kind() == element_kind_t::kParticipantObjCMethod) {
         const auto class_id =
             model()
                 .get_participant<model::objc_method>(participant_id)
@@ -538,8 +540,9 @@ void generator::generate_participant(
 
         generated_participants_.emplace(class_id);
     }
-    else if ((participant.type_name() == "function" ||
-                 participant.type_name() == "function_template") &&
+    else if ((participant.kind() == element_kind_t::kParticipantFunction ||
+                 participant.kind() ==
+                     element_kind_t::kParticipantFunctionTemplate) &&
         config().combine_free_functions_into_file_participants()) {
         // Create a single participant for all functions declared in a
         // single file
@@ -576,8 +579,9 @@ void generator::generate_participant(
 
         ostr << indent(1) << "participant " << participant.alias() << " as ";
 
-        if (participant.type_name() == "function" ||
-            participant.type_name() == "function_template") {
+        if (participant.kind() == element_kind_t::kParticipantFunction ||
+            participant.kind() ==
+                element_kind_t::kParticipantFunctionTemplate) {
             const auto &f =
                 model()
                     .get_participant<model::function>(participant_id)
@@ -606,8 +610,9 @@ bool generator::is_participant_generated(eid_t id) const
 std::string generator::generate_alias(
     const model::participant &participant) const
 {
-    if ((participant.type_name() == "function" ||
-            participant.type_name() == "function_template") &&
+    if ((participant.kind() == element_kind_t::kParticipantFunction ||
+            participant.kind() ==
+                element_kind_t::kParticipantFunctionTemplate) &&
         config().combine_free_functions_into_file_participants()) {
         const auto file_id = common::to_id(participant.file());
 
@@ -666,8 +671,8 @@ void generator::generate_from_sequences(std::ostream &ostr) const
         // file participants, we need to add an 'entry' point call to know
         // which method relates to the first activity for this 'start_from'
         // condition
-        if (from.value().type_name() == "method" ||
-            from.value().type_name() == "objc_method" ||
+        if (from.value().kind() == element_kind_t::kParticipantMethod ||
+            from.value().kind() == element_kind_t::kParticipantObjCMethod ||
             config().combine_free_functions_into_file_participants()) {
             ostr << indent(1) << "* "
                  << common::generators::mermaid::to_mermaid(message_t::kCall)
@@ -722,7 +727,7 @@ void generator::generate_to_sequences(std::ostream &ostr) const
         const auto &from =
             model().get_participant<model::function>(from_activity_id);
 
-        if (from.value().type_name() == "method" ||
+        if (from.value().kind() == element_kind_t::kParticipantMethod ||
             config().combine_free_functions_into_file_participants()) {
             generate_participant(ostr, from_activity_id);
             ostr << indent(1) << "* "
@@ -785,7 +790,8 @@ void generator::generate_from_to_sequences(
                     const auto &from = model().get_participant<model::function>(
                         from_activity_id);
 
-                    if (from.value().type_name() == "method" ||
+                    if (from.value().kind() ==
+                            element_kind_t::kParticipantMethod ||
                         config()
                             .combine_free_functions_into_file_participants()) {
                         if (!star_participant_generated) {
@@ -18,6 +18,8 @@
 
 #include "activity.h"
 
+#include <algorithm>
+
 namespace clanguml::sequence_diagram::model {
 
 activity::activity(eid_t id)
@@ -42,4 +44,89 @@ void activity::set_callers(std::set<eid_t> callers)
     callers_ = std::move(callers);
 }
 
+bool activity_map::insert(value_type &&value)
+{
+    if (index_.count(value.first) > 0)
+        return false;
+
+    const auto position = storage_.size();
+
+    if (!order_.empty() && value.first < storage_[order_.back()].first)
+        sorted_ = false;
+
+    index_.emplace(value.first, position);
+    order_.push_back(position);
+    storage_.emplace_back(std::move(value));
+
+    return true;
+}
+
+bool activity_map::contains(eid_t id) const { return index_.count(id) > 0; }
+
+std::size_t activity_map::count(eid_t id) const { return index_.count(id); }
+
+activity &activity_map::at(eid_t id)
+{
+    return storage_[index_.at(id)].second;
+}
+
+const activity &activity_map::at(eid_t id) const
+{
+    return storage_[index_.at(id)].second;
+}
+
+activity *activity_map::get(eid_t id)
+{
+    auto it = index_.find(id);
+    if (it == index_.end())
+        return nullptr;
+
+    return &storage_[it->second].second;
+}
+
+const activity *activity_map::get(eid_t id) const
+{
+    auto it = index_.find(id);
+    if (it == index_.end())
+        return nullptr;
+
+    return &storage_[it->second].second;
+}
+
+std::size_t activity_map::size() const { return storage_.size(); }
+
+bool activity_map::empty() const { return storage_.empty(); }
+
+void activity_map::ensure_sorted() const
+{
+    if (sorted_)
+        return;
+
+    std::sort(order_.begin(), order_.end(),
+        [this](std::size_t a, std::size_t b) {
+            return storage_[a].first < storage_[b].first;
+        });
+
+    sorted_ = true;
+}
+
+activity_map::iterator activity_map::begin()
+{
+    ensure_sorted();
+    return {this, 0};
+}
+
+activity_map::iterator activity_map::end() { return {this, order_.size()}; }
+
+activity_map::const_iterator activity_map::begin() const
+{
+    ensure_sorted();
+    return {this, 0};
+}
+
+activity_map::const_iterator activity_map::end() const
+{
+    return {this, order_.size()};
+}
+
 } // namespace clanguml::sequence_diagram::model
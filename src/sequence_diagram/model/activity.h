@@ -19,7 +19,9 @@
 
 #include "message.h"
 #include "participant.h"
+#include "util/flat_hash_map.h"
 
+#include <deque>
 #include <string>
 #include <vector>
 
@@ -92,4 +94,160 @@ private:
     std::set<eid_t> callers_;
 };
 
+/**
+ * @brief Container of all activities in a sequence diagram
+ *
+ * Activities are stored contiguously in insertion order, with a hash table
+ * mapping activity id to its index in the storage. References to stored
+ * activities remain valid after adding new activities.
+ *
+ * Iteration is performed in the order of activity id's, consistent with
+ * the `std::map` which was used previously, so that the generated diagrams
+ * do not depend on the order in which translation units were visited.
+ */
+class activity_map {
+public:
+    using value_type = std::pair<const eid_t, activity>;
+
+    /**
+     * @brief Iterator over activities in the order of their id's
+     *
+     * The iterator remains valid when new activities are added to the
+     * container while iterating.
+     */
+    template <typename MapT, typename ValueT> class iterator_t {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = ValueT;
+        using difference_type = std::ptrdiff_t;
+        using pointer = ValueT *;
+        using reference = ValueT &;
+
+        iterator_t(MapT *map, std::size_t position)
+            : map_{map}
+            , position_{position}
+        {
+        }
+
+        reference operator*() const
+        {
+            return map_->storage_[map_->order_[position_]];
+        }
+
+        pointer operator->() const { return &(**this); }
+
+        iterator_t &operator++()
+        {
+            ++position_;
+            return *this;
+        }
+
+        iterator_t operator++(int)
+        {
+            auto tmp = *this;
+            ++position_;
+            return tmp;
+        }
+
+        bool operator==(const iterator_t &r) const
+        {
+            return map_ == r.map_ && position_ == r.position_;
+        }
+
+        bool operator!=(const iterator_t &r) const { return !(*this == r); }
+
+    private:
+        MapT *map_;
+        std::size_t position_;
+    };
+
+    using iterator = iterator_t<activity_map, value_type>;
+    using const_iterator = iterator_t<const activity_map, const value_type>;
+
+    /**
+     * @brief Add activity to the container, unless it already exists
+     *
+     * @param value Pair of activity id and activity
+     * @return True, if the activity was added
+     */
+    bool insert(value_type &&value);
+
+    /**
+     * @brief Check if activity with specified id exists
+     *
+     * @param id Activity id
+     * @return True, if activity exists
+     */
+    bool contains(eid_t id) const;
+
+    /**
+     * @brief Return number of activities with id (0 or 1)
+     *
+     * @param id Activity id
+     * @return Number of activities
+     */
+    std::size_t count(eid_t id) const;
+
+    /**
+     * @brief Get activity by id
+     *
+     * @throws std::out_of_range If activity does not exist
+     * @param id Activity id
+     * @return Reference to the activity
+     */
+    activity &at(eid_t id);
+
+    /**
+     * @brief Get activity by id
+     *
+     * @throws std::out_of_range If activity does not exist
+     * @param id Activity id
+     * @return Reference to the activity
+     */
+    const activity &at(eid_t id) const;
+
+    /**
+     * @brief Get pointer to activity by id
+     *
+     * @param id Activity id
+     * @return Pointer to activity or nullptr if it doesn't exist
+     */
+    activity *get(eid_t id);
+
+    /**
+     * @brief Get pointer to activity by id
+     *
+     * @param id Activity id
+     * @return Pointer to activity or nullptr if it doesn't exist
+     */
+    const activity *get(eid_t id) const;
+
+    std::size_t size() const;
+
+    bool empty() const;
+
+    iterator begin();
+    iterator end();
+
+    const_iterator begin() const;
+    const_iterator end() const;
+
+private:
+    struct eid_hash {
+        std::size_t operator()(const eid_t &id) const
+        {
+            return std::hash<eid_t::type>{}(id.value());
+        }
+    };
+
+    void ensure_sorted() const;
+
+    std::deque<value_type> storage_;
+    util::flat_hash_map<eid_t, std::size_t, eid_hash> index_;
+
+    // Indexes into storage_ ordered by activity id, sorted lazily
+    mutable std::vector<std::size_t> order_;
+    mutable bool sorted_{true};
+};
+
 } // namespace clanguml::sequence_diagram::model
@@ -22,6 +22,7 @@
 
 #include <functional>
 #include <memory>
+#include <unordered_set>
 
 namespace clanguml::sequence_diagram::model {
 
@@ -97,11 +98,9 @@ void diagram::add_participant(std::unique_ptr<participant> p)
     assert(participant_id.is_global());
 
     if (participants_.find(participant_id) == participants_.end()) {
+        const auto *m = common::model::element_cast<method>(p.get());
         LOG_DBG("Adding '{}' participant: {}, {} [{}]", p->type_name(),
-            p->full_name(false), p->id(),
-            p->type_name() == "method"
-                ? dynamic_cast<method *>(p.get())->method_name()
-                : "");
+            p->full_name(false), p->id(), m != nullptr ? m->method_name() : "");
 
         participants_.emplace(participant_id, std::move(p));
     }
@@ -126,12 +125,12 @@ void diagram::add_message(model::message &&message)
     const auto caller_id = message.from();
     const auto callee_id = message.to();
 
-    if (activities_.find(caller_id) == activities_.end()) {
+    if (!activities_.contains(caller_id)) {
         activity a{caller_id};
         activities_.insert({caller_id, std::move(a)});
     }
 
-    if (activities_.find(callee_id) == activities_.end()) {
+    if (!activities_.contains(callee_id)) {
         activity a{callee_id};
         activities_.insert({callee_id, std::move(a)});
     }
@@ -150,7 +149,7 @@ void diagram::end_block_message(
 {
     const auto caller_id = message.from();
 
-    if (activities_.find(caller_id) != activities_.end()) {
+    if (activities_.contains(caller_id)) {
         auto &current_messages = get_activity(caller_id).messages();
 
         fold_or_end_block_statement(
@@ -163,7 +162,7 @@ void diagram::add_case_stmt_message(model::message &&m)
     using clanguml::common::model::message_t;
     const auto caller_id = m.from();
 
-    if (activities_.find(caller_id) != activities_.end()) {
+    if (activities_.contains(caller_id)) {
         auto &current_messages = get_activity(caller_id).messages();
 
         if (current_messages.back().type() == message_t::kCase) {
@@ -175,9 +174,9 @@ void diagram::add_case_stmt_message(model::message &&m)
     }
 }
 
-std::map<eid_t, activity> &diagram::sequences() { return activities_; }
+activity_map &diagram::sequences() { return activities_; }
 
-const std::map<eid_t, activity> &diagram::sequences() const
+const activity_map &diagram::sequences() const
 {
     return activities_;
 }
@@ -431,11 +430,66 @@ bool diagram::is_empty() const
     return activities_.empty() || participants_.empty();
 }
 
+void diagram::estimate_memory_usage(common::model::memory_usage &usage) const
+{
+    using common::model::element_kind_t;
+
+    for (const auto &[id, p] : participants_) {
+        switch (p->kind()) {
+        case element_kind_t::kParticipantClass:
+            usage.add_element(*p, sizeof(class_));
+            break;
+        case element_kind_t::kParticipantFunction:
+            usage.add_element(*p, sizeof(function));
+            break;
+        case element_kind_t::kParticipantMethod:
+            usage.add_element(*p, sizeof(method));
+            break;
+        case element_kind_t::kParticipantObjCMethod:
+            usage.add_element(*p, sizeof(objc_method));
+            break;
+        case element_kind_t::kParticipantFunctionTemplate:
+            usage.add_element(*p, sizeof(function_template));
+            break;
+        default:
+            usage.add_element(*p, sizeof(participant));
+            break;
+        }
+
+        usage.add_template_params(p->template_params());
+
+        if (const auto *f = common::model::element_cast<function>(p.get());
+            f != nullptr) {
+            usage.add_string(f->return_type());
+            usage.add_strings(f->parameters());
+        }
+    }
+
+    // Message details are shared between copies of a message, so each of
+    // them is counted only once
+    std::unordered_set<const message::details *> counted_details;
+
+    for (const auto &[id, a] : activities_) {
+        for (const auto &m : a.messages()) {
+            usage.add_message(m, sizeof(message));
+
+            const auto *details = m.shared_details();
+            if (details == nullptr || !counted_details.insert(details).second)
+                continue;
+
+            usage.messages += sizeof(message::details);
+            usage.add_comment(details->comment);
+            if (details->condition_text)
+                usage.add_string(*details->condition_text);
+        }
+    }
+}
+
 void diagram::inline_lambda_operator_calls()
 {
     using namespace std::string_literals;
 
-    std::map<eid_t, activity> activities;
+    activity_map activities;
     std::map<eid_t, std::unique_ptr<participant>> participants;
     std::set<eid_t> active_participants;
 
@@ -479,14 +533,14 @@ void diagram::inline_lambda_operator_calls()
     for (auto &&[id, p] : this->participants()) {
         // Skip participants which are lambda classes
         if (const auto *maybe_class =
-                dynamic_cast<const model::class_ *>(p.get());
+                common::model::element_cast<model::class_>(p.get());
             maybe_class != nullptr && maybe_class->is_lambda()) {
             continue;
         }
 
         // Skip participants which are lambda operator methods
         if (const auto *maybe_method =
-                dynamic_cast<const model::method *>(p.get());
+                common::model::element_cast<model::method>(p.get());
             maybe_method != nullptr) {
             auto maybe_class =
                 get_participant<model::class_>(maybe_method->class_id());
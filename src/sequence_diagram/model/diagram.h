@@ -97,12 +97,13 @@ public:
     template <typename T>
     common::optional_ref<T> get_participant(eid_t id) const
     {
-        if (participants_.find(id) == participants_.end()) {
+        const auto it = participants_.find(id);
+        if (it == participants_.end()) {
             return {};
         }
 
         return common::optional_ref<T>(
-            dynamic_cast<T *>(participants_.at(id).get()));
+            common::model::element_cast<T>(it->second.get()));
     }
 
     /**
@@ -182,14 +183,14 @@ public:
      *
      * @return Map of sequences in the diagram
      */
-    std::map<eid_t, activity> &sequences();
+    activity_map &sequences();
 
     /**
      * @brief Get all sequences in the diagram
      *
      * @return Map of sequences in the diagram
      */
-    const std::map<eid_t, activity> &sequences() const;
+    const activity_map &sequences() const;
 
     /**
      * @brief Get map of all participants in the diagram
@@ -318,6 +319,14 @@ public:
      */
     bool is_empty() const override;
 
+    /**
+     * @brief Estimate memory used by the diagram model
+     *
+     * @param usage Memory usage to which the diagram model is added
+     */
+    void estimate_memory_usage(
+        common::model::memory_usage &usage) const override;
+
     /**
      * If option to inline lambda calls is enabled, we need to modify the
      * sequences to skip the lambda calls. In case lambda call does not lead
@@ -370,7 +379,7 @@ private:
         return block_end_types.count(mt) > 0;
     };
 
-    std::map<eid_t, activity> activities_;
+    activity_map activities_;
 
     std::map<eid_t, std::unique_ptr<participant>> participants_;
 
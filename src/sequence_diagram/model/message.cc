@@ -28,10 +28,25 @@ message::message(common::model::message_t type, eid_t from)
 
 bool message::operator==(const message &other) const noexcept
 {
-    return from_ == other.from_ && to_ == other.to_ && type_ == other.type_ &&
-        scope_ == other.scope_ && message_name_ == other.message_name_ &&
-        return_type_ == other.return_type_ &&
-        condition_text_ == other.condition_text_ && comment_ == other.comment_;
+    if (!(from_ == other.from_ && to_ == other.to_ && type_ == other.type_ &&
+            scope_ == other.scope_ && message_name_ == other.message_name_ &&
+            return_type_ == other.return_type_))
+        return false;
+
+    if (details_ == other.details_)
+        return true;
+
+    return condition_text() == other.condition_text() &&
+        comment() == other.comment();
+}
+
+message::details &message::mutable_details()
+{
+    // Copy on write - details can be shared with copies of this message
+    auto d = details_ ? std::make_shared<details>(*details_)
+                      : std::make_shared<details>();
+    details_ = d;
+    return *d;
 }
 
 void message::set_type(common::model::message_t t) { type_ = t; }
@@ -48,18 +63,29 @@ eid_t message::to() const { return to_; }
 
 void message::set_message_name(std::string name)
 {
-    message_name_ = std::move(name);
+    message_name_ = util::interned_string{name};
 }
 
-const std::string &message::message_name() const { return message_name_; }
+const std::string &message::message_name() const
+{
+    return message_name_.str();
+}
 
-void message::set_return_type(std::string t) { return_type_ = std::move(t); }
+void message::set_return_type(std::string t)
+{
+    return_type_ = util::interned_string{t};
+}
 
-const std::string &message::return_type() const { return return_type_; }
+const std::string &message::return_type() const { return return_type_.str(); }
 
 const std::optional<common::model::comment_t> &message::comment() const
 {
-    return comment_;
+    static const std::optional<common::model::comment_t> kNoComment;
+
+    if (!details_)
+        return kNoComment;
+
+    return details_->comment;
 }
 
 void message::set_comment(
@@ -85,7 +111,7 @@ void message::set_comment(unsigned int id, std::string comment)
 void message::set_comment(common::model::comment_t c)
 {
     if (!c.empty())
-        comment_ = std::move(c);
+        mutable_details().comment = std::move(c);
 }
 
 void message::set_comment(const std::optional<common::model::comment_t> &c)
@@ -103,15 +129,26 @@ common::model::message_scope_t message::message_scope() const { return scope_; }
 
 void message::condition_text(const std::string &condition_text)
 {
-    if (condition_text.empty())
-        condition_text_ = std::nullopt;
-    else
-        condition_text_ = condition_text;
+    if (condition_text.empty()) {
+        if (details_ && details_->condition_text)
+            mutable_details().condition_text = std::nullopt;
+    }
+    else {
+        mutable_details().condition_text = condition_text;
+    }
 }
 
 std::optional<std::string> message::condition_text() const
 {
-    return condition_text_;
+    if (!details_)
+        return std::nullopt;
+
+    return details_->condition_text;
+}
+
+const message::details *message::shared_details() const
+{
+    return details_.get();
 }
 
 bool message::in_static_declaration_context() const
@@ -19,7 +19,9 @@
 
 #include "common/model/enums.h"
 #include "participant.h"
+#include "util/string_pool.h"
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -27,9 +29,26 @@ namespace clanguml::sequence_diagram::model {
 
 /**
  * @brief Model of a sequence diagram message.
+ *
+ * Large sequence diagrams can contain millions of messages, so message
+ * names and return types are interned, and rarely used properties such as
+ * block condition text and comments are stored out of line and shared
+ * between copies of the message.
  */
 class message : public common::model::diagram_element {
 public:
+    /**
+     * @brief Rarely set message properties
+     *
+     * Instances are immutable once assigned to a message, so they can be
+     * shared by copies of the message.
+     */
+    struct details {
+        std::optional<std::string> condition_text;
+
+        std::optional<common::model::comment_t> comment;
+    };
+
     message() = default;
 
     /**
@@ -160,31 +179,38 @@ public:
      */
     std::optional<std::string> condition_text() const;
 
+    /**
+     * @brief Get the rarely set properties, shared by copies of the message
+     *
+     * @return Pointer to message details or nullptr, if none were set
+     */
+    const details *shared_details() const;
+
     bool in_static_declaration_context() const;
 
     void in_static_declaration_context(bool v);
 
 private:
+    details &mutable_details();
+
     common::model::message_t type_{common::model::message_t::kNone};
 
+    common::model::message_scope_t scope_{
+        common::model::message_scope_t::kNormal};
+
+    bool in_static_declaration_context_{false};
+
     eid_t from_{};
 
     eid_t to_{};
 
-    common::model::message_scope_t scope_{
-        common::model::message_scope_t::kNormal};
-
     // This is only for better verbose messages, we cannot rely on this
     // always
-    std::string message_name_{};
-
-    std::string return_type_{};
+    util::interned_string message_name_{};
 
-    std::optional<std::string> condition_text_;
+    util::interned_string return_type_{};
 
-    std::optional<common::model::comment_t> comment_;
-
-    bool in_static_declaration_context_{false};
+    std::shared_ptr<const details> details_;
 };
 
 } // namespace clanguml::sequence_diagram::model
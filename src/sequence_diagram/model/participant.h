@@ -65,6 +65,17 @@ struct participant : public common::model::template_element,
      */
     std::string type_name() const override { return "participant"; }
 
+    common::model::element_kind_t kind() const override
+    {
+        return common::model::element_kind_t::kParticipant;
+    }
+
+    static bool is_kind(common::model::element_kind_t kind)
+    {
+        return kind >= common::model::element_kind_t::kParticipant &&
+            kind <= common::model::element_kind_t::kParticipantFunctionTemplate;
+    }
+
     /**
      * @brief Create a string representation of the participant
      *
@@ -105,6 +116,16 @@ public:
         return "class";
     }
 
+    common::model::element_kind_t kind() const override
+    {
+        return common::model::element_kind_t::kParticipantClass;
+    }
+
+    static bool is_kind(common::model::element_kind_t kind)
+    {
+        return kind == common::model::element_kind_t::kParticipantClass;
+    }
+
     /**
      * @brief Check if class is a struct.
      *
@@ -246,6 +267,17 @@ struct function : public participant {
      */
     std::string type_name() const override { return "function"; }
 
+    common::model::element_kind_t kind() const override
+    {
+        return common::model::element_kind_t::kParticipantFunction;
+    }
+
+    static bool is_kind(common::model::element_kind_t kind)
+    {
+        return kind >= common::model::element_kind_t::kParticipantFunction &&
+            kind <= common::model::element_kind_t::kParticipantFunctionTemplate;
+    }
+
     /**
      * Return elements full name but without namespace.
      *
@@ -430,6 +462,16 @@ struct method : public function {
      */
     std::string type_name() const override { return "method"; }
 
+    common::model::element_kind_t kind() const override
+    {
+        return common::model::element_kind_t::kParticipantMethod;
+    }
+
+    static bool is_kind(common::model::element_kind_t kind)
+    {
+        return kind == common::model::element_kind_t::kParticipantMethod;
+    }
+
     /**
      * @brief Get method name
      * @return Method name
@@ -567,6 +609,16 @@ struct objc_method : public function {
      */
     std::string type_name() const override { return "objc_method"; }
 
+    common::model::element_kind_t kind() const override
+    {
+        return common::model::element_kind_t::kParticipantObjCMethod;
+    }
+
+    static bool is_kind(common::model::element_kind_t kind)
+    {
+        return kind == common::model::element_kind_t::kParticipantObjCMethod;
+    }
+
     /**
      * @brief Get method name
      * @return Method name
@@ -662,6 +714,17 @@ struct function_template : public function {
      */
     std::string type_name() const override { return "function_template"; }
 
+    common::model::element_kind_t kind() const override
+    {
+        return common::model::element_kind_t::kParticipantFunctionTemplate;
+    }
+
+    static bool is_kind(common::model::element_kind_t kind)
+    {
+        return kind ==
+            common::model::element_kind_t::kParticipantFunctionTemplate;
+    }
+
     /**
      * Return elements full name but without namespace.
      *
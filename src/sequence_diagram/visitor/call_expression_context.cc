@@ -18,6 +18,8 @@
 
 #include "call_expression_context.h"
 
+#include <algorithm>
+
 namespace clanguml::sequence_diagram::visitor {
 
 call_expression_context::call_expression_context() = default;
@@ -35,6 +37,56 @@ void call_expression_context::reset()
     objc_protocol_decl_ = nullptr;
 }
 
+void call_expression_context::push_scope()
+{
+    frames_.push_back({current_class_decl_, current_class_template_decl_,
+        current_class_template_specialization_decl_, current_method_decl_,
+        current_objc_method_decl_, current_function_decl_,
+        current_function_template_decl_, objc_interface_decl_,
+        objc_protocol_decl_, current_caller_id_,
+        current_lambda_caller_id_.size(), call_expr_stack_.size(),
+        if_stmt_stack_.size(), elseif_stmt_stack_.size(),
+        loop_stmt_stack_.size(), try_stmt_stack_.size(),
+        switch_stmt_stack_.size(), conditional_operator_stack_.size()});
+}
+
+void call_expression_context::pop_scope()
+{
+    assert(!frames_.empty());
+
+    const auto &f = frames_.back();
+
+    current_class_decl_ = f.class_decl;
+    current_class_template_decl_ = f.class_template_decl;
+    current_class_template_specialization_decl_ =
+        f.class_template_specialization_decl;
+    current_method_decl_ = f.method_decl;
+    current_objc_method_decl_ = f.objc_method_decl;
+    current_function_decl_ = f.function_decl;
+    current_function_template_decl_ = f.function_template_decl;
+    objc_interface_decl_ = f.objc_interface_decl;
+    objc_protocol_decl_ = f.objc_protocol_decl;
+    current_caller_id_ = f.caller_id;
+
+    // Statements, which were entered but not left in this scope, are dropped
+    current_lambda_caller_id_.resize(
+        std::min(current_lambda_caller_id_.size(), f.lambda_caller_id_depth));
+    call_expr_stack_.resize(
+        std::min(call_expr_stack_.size(), f.call_expr_depth));
+    if_stmt_stack_.resize(std::min(if_stmt_stack_.size(), f.if_stmt_depth));
+    elseif_stmt_stack_.resize(
+        std::min(elseif_stmt_stack_.size(), f.elseif_stmt_depth));
+    loop_stmt_stack_.resize(
+        std::min(loop_stmt_stack_.size(), f.loop_stmt_depth));
+    try_stmt_stack_.resize(std::min(try_stmt_stack_.size(), f.try_stmt_depth));
+    switch_stmt_stack_.resize(
+        std::min(switch_stmt_stack_.size(), f.switch_stmt_depth));
+    conditional_operator_stack_.resize(std::min(
+        conditional_operator_stack_.size(), f.conditional_operator_depth));
+
+    frames_.pop_back();
+}
+
 void call_expression_context::dump()
 {
     LOG_DBG("current_caller_id_ = {}", current_caller_id_);
@@ -188,7 +240,7 @@ std::optional<eid_t> call_expression_context::lambda_caller_id() const
     if (current_lambda_caller_id_.empty())
         return {};
 
-    return current_lambda_caller_id_.top();
+    return current_lambda_caller_id_.back();
 }
 
 void call_expression_context::set_caller_id(eid_t id)
@@ -203,7 +255,7 @@ void call_expression_context::enter_lambda_expression(eid_t id)
 
     assert(id.value() != 0);
 
-    current_lambda_caller_id_.emplace(id);
+    current_lambda_caller_id_.emplace_back(id);
 }
 
 void call_expression_context::leave_lambda_expression()
@@ -212,9 +264,9 @@ void call_expression_context::leave_lambda_expression()
         return;
 
     LOG_DBG("Leaving current lambda expression id to {}",
-        current_lambda_caller_id_.top());
+        current_lambda_caller_id_.back());
 
-    current_lambda_caller_id_.pop();
+    current_lambda_caller_id_.pop_back();
 }
 
 clang::IfStmt *call_expression_context::current_ifstmt() const
@@ -222,19 +274,23 @@ clang::IfStmt *call_expression_context::current_ifstmt() const
     if (if_stmt_stack_.empty())
         return nullptr;
 
-    return if_stmt_stack_.top();
+    return if_stmt_stack_.back();
 }
 
 void call_expression_context::enter_ifstmt(clang::IfStmt *stmt)
 {
-    if_stmt_stack_.emplace(stmt);
+    if_stmt_stack_.emplace_back(stmt);
 }
 
 void call_expression_context::leave_ifstmt()
 {
     if (!if_stmt_stack_.empty()) {
-        elseif_stmt_stacks_.erase(current_ifstmt());
-        if_stmt_stack_.pop();
+        auto *ifstmt = current_ifstmt();
+        elseif_stmt_stack_.erase(
+            std::remove_if(elseif_stmt_stack_.begin(), elseif_stmt_stack_.end(),
+                [ifstmt](const auto &e) { return e.first == ifstmt; }),
+            elseif_stmt_stack_.end());
+        if_stmt_stack_.pop_back();
     }
 }
 
@@ -242,18 +298,22 @@ void call_expression_context::enter_elseifstmt(clang::IfStmt *stmt)
 {
     assert(current_ifstmt() != nullptr);
 
-    elseif_stmt_stacks_[current_ifstmt()].emplace(stmt);
+    elseif_stmt_stack_.emplace_back(current_ifstmt(), stmt);
 }
 
 clang::IfStmt *call_expression_context::current_elseifstmt() const
 {
     assert(current_ifstmt() != nullptr);
 
-    if (elseif_stmt_stacks_.count(current_ifstmt()) == 0 ||
-        elseif_stmt_stacks_.at(current_ifstmt()).empty())
+    auto *ifstmt = current_ifstmt();
+    const auto it = std::find_if(elseif_stmt_stack_.rbegin(),
+        elseif_stmt_stack_.rend(),
+        [ifstmt](const auto &e) { return e.first == ifstmt; });
+
+    if (it == elseif_stmt_stack_.rend())
         return nullptr;
 
-    return elseif_stmt_stacks_.at(current_ifstmt()).top();
+    return it->second;
 }
 
 clang::Stmt *call_expression_context::current_loopstmt() const
@@ -261,18 +321,18 @@ clang::Stmt *call_expression_context::current_loopstmt() const
     if (loop_stmt_stack_.empty())
         return nullptr;
 
-    return loop_stmt_stack_.top();
+    return loop_stmt_stack_.back();
 }
 
 void call_expression_context::enter_loopstmt(clang::Stmt *stmt)
 {
-    loop_stmt_stack_.emplace(stmt);
+    loop_stmt_stack_.emplace_back(stmt);
 }
 
 void call_expression_context::leave_loopstmt()
 {
     if (!loop_stmt_stack_.empty())
-        return loop_stmt_stack_.pop();
+        return loop_stmt_stack_.pop_back();
 }
 
 call_expression_context::callexpr_stack_t
@@ -281,48 +341,48 @@ call_expression_context::current_callexpr() const
     if (call_expr_stack_.empty())
         return {};
 
-    return call_expr_stack_.top();
+    return call_expr_stack_.back();
 }
 
 void call_expression_context::enter_callexpr(clang::CallExpr *expr)
 {
-    call_expr_stack_.emplace(expr);
+    call_expr_stack_.emplace_back(expr);
 }
 
 void call_expression_context::enter_callexpr(clang::CXXConstructExpr *expr)
 {
-    call_expr_stack_.emplace(expr);
+    call_expr_stack_.emplace_back(expr);
 }
 
 void call_expression_context::enter_callexpr(clang::ObjCMessageExpr *expr)
 {
-    call_expr_stack_.emplace(expr);
+    call_expr_stack_.emplace_back(expr);
 }
 
 void call_expression_context::enter_callexpr(clang::ReturnStmt *stmt)
 {
-    call_expr_stack_.emplace(stmt);
+    call_expr_stack_.emplace_back(stmt);
 }
 
 void call_expression_context::enter_callexpr(clang::CoreturnStmt *stmt)
 {
-    call_expr_stack_.emplace(stmt);
+    call_expr_stack_.emplace_back(stmt);
 }
 
 void call_expression_context::enter_callexpr(clang::CoyieldExpr *expr)
 {
-    call_expr_stack_.emplace(expr);
+    call_expr_stack_.emplace_back(expr);
 }
 
 void call_expression_context::enter_callexpr(clang::CoawaitExpr *expr)
 {
-    call_expr_stack_.emplace(expr);
+    call_expr_stack_.emplace_back(expr);
 }
 
 void call_expression_context::leave_callexpr()
 {
     if (!call_expr_stack_.empty()) {
-        return call_expr_stack_.pop();
+        return call_expr_stack_.pop_back();
     }
 }
 
@@ -331,18 +391,18 @@ clang::Stmt *call_expression_context::current_trystmt() const
     if (try_stmt_stack_.empty())
         return nullptr;
 
-    return try_stmt_stack_.top();
+    return try_stmt_stack_.back();
 }
 
 void call_expression_context::enter_trystmt(clang::Stmt *stmt)
 {
-    try_stmt_stack_.emplace(stmt);
+    try_stmt_stack_.emplace_back(stmt);
 }
 
 void call_expression_context::leave_trystmt()
 {
-    if (try_stmt_stack_.empty())
-        try_stmt_stack_.pop();
+    if (!try_stmt_stack_.empty())
+        try_stmt_stack_.pop_back();
 }
 
 clang::SwitchStmt *call_expression_context::current_switchstmt() const
@@ -350,18 +410,18 @@ clang::SwitchStmt *call_expression_context::current_switchstmt() const
     if (switch_stmt_stack_.empty())
         return nullptr;
 
-    return switch_stmt_stack_.top();
+    return switch_stmt_stack_.back();
 }
 
 void call_expression_context::enter_switchstmt(clang::SwitchStmt *stmt)
 {
-    switch_stmt_stack_.emplace(stmt);
+    switch_stmt_stack_.emplace_back(stmt);
 }
 
 void call_expression_context::leave_switchstmt()
 {
-    if (switch_stmt_stack_.empty())
-        switch_stmt_stack_.pop();
+    if (!switch_stmt_stack_.empty())
+        switch_stmt_stack_.pop_back();
 }
 
 clang::ConditionalOperator *
@@ -370,19 +430,19 @@ call_expression_context::current_conditionaloperator() const
     if (conditional_operator_stack_.empty())
         return nullptr;
 
-    return conditional_operator_stack_.top();
+    return conditional_operator_stack_.back();
 }
 
 void call_expression_context::enter_conditionaloperator(
     clang::ConditionalOperator *stmt)
 {
-    conditional_operator_stack_.emplace(stmt);
+    conditional_operator_stack_.emplace_back(stmt);
 }
 
 void call_expression_context::leave_conditionaloperator()
 {
     if (!conditional_operator_stack_.empty())
-        conditional_operator_stack_.pop();
+        conditional_operator_stack_.pop_back();
 }
 
 bool call_expression_context::is_expr_in_current_control_statement_condition(
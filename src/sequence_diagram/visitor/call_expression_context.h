@@ -24,7 +24,7 @@
 #include <clang/AST/RecursiveASTVisitor.h>
 #include <clang/Basic/SourceManager.h>
 
-#include <stack>
+#include <vector>
 
 namespace clanguml::sequence_diagram::visitor {
 
@@ -37,6 +37,12 @@ using clanguml::common::eid_t;
  * the current context, for instance whether we are in a `for` loop or
  * an `if` block, as well as the current parent of the call expression
  * e.g. a class method or function.
+ *
+ * All statement stacks are kept in vectors, which retain their capacity, and
+ * nested declaration scopes (e.g. a function traversed while traversing
+ * another function) are tracked using a stack of frames, so entering and
+ * leaving a scope does not allocate any memory once the stacks have grown
+ * to the maximum nesting depth.
  */
 struct call_expression_context {
     /**
@@ -57,6 +63,22 @@ struct call_expression_context {
      */
     void reset();
 
+    /**
+     * @brief Enter a new declaration scope.
+     *
+     * Saves the current declaration context and the depth of all statement
+     * stacks, so that they can be restored by @ref pop_scope().
+     */
+    void push_scope();
+
+    /**
+     * @brief Leave current declaration scope.
+     *
+     * Restores the declaration context saved by the matching
+     * @ref push_scope() and drops all statements entered in this scope.
+     */
+    void pop_scope();
+
     /**
      * @brief Verify that the context is in a valid state.
      *
@@ -337,18 +359,49 @@ struct call_expression_context {
     clang::ObjCProtocolDecl *objc_protocol_decl_{nullptr};
 
 private:
+    /**
+     * @brief Declaration context and statement stack depths saved on
+     *        entering a scope
+     */
+    struct frame {
+        clang::CXXRecordDecl *class_decl{nullptr};
+        clang::ClassTemplateDecl *class_template_decl{nullptr};
+        clang::ClassTemplateSpecializationDecl
+            *class_template_specialization_decl{nullptr};
+        clang::CXXMethodDecl *method_decl{nullptr};
+        clang::ObjCMethodDecl *objc_method_decl{nullptr};
+        clang::FunctionDecl *function_decl{nullptr};
+        clang::FunctionTemplateDecl *function_template_decl{nullptr};
+        clang::ObjCInterfaceDecl *objc_interface_decl{nullptr};
+        clang::ObjCProtocolDecl *objc_protocol_decl{nullptr};
+        eid_t caller_id{};
+
+        std::size_t lambda_caller_id_depth{0};
+        std::size_t call_expr_depth{0};
+        std::size_t if_stmt_depth{0};
+        std::size_t elseif_stmt_depth{0};
+        std::size_t loop_stmt_depth{0};
+        std::size_t try_stmt_depth{0};
+        std::size_t switch_stmt_depth{0};
+        std::size_t conditional_operator_depth{0};
+    };
+
     eid_t current_caller_id_{};
-    std::stack<eid_t> current_lambda_caller_id_;
+    std::vector<eid_t> current_lambda_caller_id_;
+
+    std::vector<callexpr_stack_t> call_expr_stack_;
 
-    std::stack<callexpr_stack_t> call_expr_stack_;
+    std::vector<clang::IfStmt *> if_stmt_stack_;
+    // Pairs of `if` statement and its `else if` statement
+    std::vector<std::pair<clang::IfStmt *, clang::IfStmt *>>
+        elseif_stmt_stack_;
 
-    std::stack<clang::IfStmt *> if_stmt_stack_;
-    std::map<clang::IfStmt *, std::stack<clang::IfStmt *>> elseif_stmt_stacks_;
+    std::vector<clang::Stmt *> loop_stmt_stack_;
+    std::vector<clang::Stmt *> try_stmt_stack_;
+    std::vector<clang::SwitchStmt *> switch_stmt_stack_;
+    std::vector<clang::ConditionalOperator *> conditional_operator_stack_;
 
-    std::stack<clang::Stmt *> loop_stmt_stack_;
-    std::stack<clang::Stmt *> try_stmt_stack_;
-    std::stack<clang::SwitchStmt *> switch_stmt_stack_;
-    std::stack<clang::ConditionalOperator *> conditional_operator_stack_;
+    std::vector<frame> frames_;
 };
 
-} // namespace clanguml::sequence_diagram::visitor
\ No newline at end of file
+} // namespace clanguml::sequence_diagram::visitor
@@ -156,12 +156,12 @@ bool translation_unit_visitor::VisitObjCInterfaceDecl(
 bool translation_unit_visitor::TraverseCXXRecordDecl(
     clang::CXXRecordDecl *declaration)
 {
-    auto context_backup = context();
+    context().push_scope();
 
     RecursiveASTVisitor<translation_unit_visitor>::TraverseCXXRecordDecl(
         declaration);
 
-    call_expression_context_ = context_backup;
+    context().pop_scope();
 
     return true;
 }
@@ -326,15 +326,15 @@ bool translation_unit_visitor::VisitClassTemplateSpecializationDecl(
 bool translation_unit_visitor::TraverseObjCMethodDecl(
     clang::ObjCMethodDecl *declaration)
 {
-    // We need to backup the context, since other methods or functions can
-    // be traversed during this traversal (e.g. template function/method
+    // We need to enter a new context scope, since other methods or functions
+    // can be traversed during this traversal (e.g. template function/method
     // specializations)
-    auto context_backup = context();
+    context().push_scope();
 
     RecursiveASTVisitor<translation_unit_visitor>::TraverseObjCMethodDecl(
         declaration);
 
-    call_expression_context_ = context_backup;
+    context().pop_scope();
 
     return true;
 }
@@ -381,15 +381,15 @@ bool translation_unit_visitor::VisitObjCMethodDecl(
 bool translation_unit_visitor::TraverseCXXMethodDecl(
     clang::CXXMethodDecl *declaration)
 {
-    // We need to backup the context, since other methods or functions can
-    // be traversed during this traversal (e.g. template function/method
+    // We need to enter a new context scope, since other methods or functions
+    // can be traversed during this traversal (e.g. template function/method
     // specializations)
-    auto context_backup = context();
+    context().push_scope();
 
     RecursiveASTVisitor<translation_unit_visitor>::TraverseCXXMethodDecl(
         declaration);
 
-    call_expression_context_ = context_backup;
+    context().pop_scope();
 
     return true;
 }
@@ -459,15 +459,15 @@ bool translation_unit_visitor::VisitCXXMethodDecl(
 bool translation_unit_visitor::TraverseFunctionDecl(
     clang::FunctionDecl *declaration)
 {
-    // We need to backup the context, since other methods or functions can
-    // be traversed during this traversal (e.g. template function/method
+    // We need to enter a new context scope, since other methods or functions
+    // can be traversed during this traversal (e.g. template function/method
     // specializations)
-    auto context_backup = context();
+    context().push_scope();
 
     RecursiveASTVisitor<translation_unit_visitor>::TraverseFunctionDecl(
         declaration);
 
-    call_expression_context_ = context_backup;
+    context().pop_scope();
 
     return true;
 }
@@ -553,15 +553,15 @@ bool translation_unit_visitor::VisitFunctionDecl(
 bool translation_unit_visitor::TraverseFunctionTemplateDecl(
     clang::FunctionTemplateDecl *declaration)
 {
-    // We need to backup the context, since other methods or functions can
-    // be traversed during this traversal (e.g. template function/method
+    // We need to enter a new context scope, since other methods or functions
+    // can be traversed during this traversal (e.g. template function/method
     // specializations)
-    auto context_backup = context();
+    context().push_scope();
 
     RecursiveASTVisitor<translation_unit_visitor>::TraverseFunctionTemplateDecl(
         declaration);
 
-    call_expression_context_ = context_backup;
+    context().pop_scope();
 
     return true;
 }
@@ -694,14 +694,14 @@ bool translation_unit_visitor::VisitLambdaExpr(clang::LambdaExpr *expr)
 
 bool translation_unit_visitor::TraverseLambdaExpr(clang::LambdaExpr *expr)
 {
-    auto context_backup = context();
+    context().push_scope();
 
     RecursiveASTVisitor<translation_unit_visitor>::TraverseLambdaExpr(expr);
 
     // lambda context is entered inside the visitor
     context().leave_lambda_expression();
 
-    call_expression_context_ = context_backup;
+    context().pop_scope();
 
     return true;
 }
@@ -2836,15 +2836,18 @@ void translation_unit_visitor::pop_message_to_diagram(clang::CallExpr *expr)
     assert(expr != nullptr);
 
     // Skip if no message was generated from this expr
-    if (call_expr_message_map_.find(expr) == call_expr_message_map_.end()) {
+    auto it = call_expr_message_map_.find(expr);
+    if (it == call_expr_message_map_.end()) {
         return;
     }
 
-    if (call_expr_message_map_.at(expr).empty())
+    auto &messages = it->second;
+
+    if (messages.empty())
         return;
 
-    while (!call_expr_message_map_.at(expr).empty()) {
-        auto msg = call_expr_message_map_.at(expr).front();
+    while (!messages.empty()) {
+        auto msg = messages.front();
 
         auto caller_id = msg.from();
 
@@ -2856,7 +2859,7 @@ void translation_unit_visitor::pop_message_to_diagram(clang::CallExpr *expr)
         else
             LOG_DBG("Skipping message due to missing activity: {}", caller_id);
 
-        call_expr_message_map_.at(expr).pop_front();
+        messages.pop_front();
     }
 
     call_expr_message_map_.erase(expr);
@@ -2868,12 +2871,12 @@ void translation_unit_visitor::pop_message_to_diagram(
     assert(expr != nullptr);
 
     // Skip if no message was generated from this expr
-    if (construct_expr_message_map_.find(expr) ==
-        construct_expr_message_map_.end()) {
+    auto it = construct_expr_message_map_.find(expr);
+    if (it == construct_expr_message_map_.end()) {
         return;
     }
 
-    auto msg = std::move(construct_expr_message_map_.at(expr));
+    auto msg = std::move(it->second);
 
     auto caller_id = msg.from();
     diagram().get_activity(caller_id).add_message(std::move(msg));
@@ -2886,11 +2889,12 @@ void translation_unit_visitor::pop_message_to_diagram(clang::ReturnStmt *stmt)
     assert(stmt != nullptr);
 
     // Skip if no message was generated from this expr
-    if (return_stmt_message_map_.find(stmt) == return_stmt_message_map_.end()) {
+    auto it = return_stmt_message_map_.find(stmt);
+    if (it == return_stmt_message_map_.end()) {
         return;
     }
 
-    auto msg = std::move(return_stmt_message_map_.at(stmt));
+    auto msg = std::move(it->second);
 
     auto caller_id = msg.from();
     diagram().get_activity(caller_id).add_message(std::move(msg));
@@ -2903,12 +2907,12 @@ void translation_unit_visitor::pop_message_to_diagram(clang::CoreturnStmt *stmt)
     assert(stmt != nullptr);
 
     // Skip if no message was generated from this expr
-    if (co_return_stmt_message_map_.find(stmt) ==
-        co_return_stmt_message_map_.end()) {
+    auto it = co_return_stmt_message_map_.find(stmt);
+    if (it == co_return_stmt_message_map_.end()) {
         return;
     }
 
-    auto msg = std::move(co_return_stmt_message_map_.at(stmt));
+    auto msg = std::move(it->second);
 
     auto caller_id = msg.from();
     diagram().get_activity(caller_id).add_message(std::move(msg));
@@ -2921,12 +2925,12 @@ void translation_unit_visitor::pop_message_to_diagram(clang::CoyieldExpr *expr)
     assert(expr != nullptr);
 
     // Skip if no message was generated from this expr
-    if (co_yield_stmt_message_map_.find(expr) ==
-        co_yield_stmt_message_map_.end()) {
+    auto it = co_yield_stmt_message_map_.find(expr);
+    if (it == co_yield_stmt_message_map_.end()) {
         return;
     }
 
-    auto msg = std::move(co_yield_stmt_message_map_.at(expr));
+    auto msg = std::move(it->second);
 
     auto caller_id = msg.from();
     diagram().get_activity(caller_id).add_message(std::move(msg));
@@ -2939,12 +2943,12 @@ void translation_unit_visitor::pop_message_to_diagram(clang::CoawaitExpr *expr)
     assert(expr != nullptr);
 
     // Skip if no message was generated from this expr
-    if (co_await_stmt_message_map_.find(expr) ==
-        co_await_stmt_message_map_.end()) {
+    auto it = co_await_stmt_message_map_.find(expr);
+    if (it == co_await_stmt_message_map_.end()) {
         return;
     }
 
-    auto msg = std::move(co_await_stmt_message_map_.at(expr));
+    auto msg = std::move(it->second);
 
     auto caller_id = msg.from();
     diagram().get_activity(caller_id).add_message(std::move(msg));
@@ -2958,11 +2962,12 @@ void translation_unit_visitor::pop_message_to_diagram(
     assert(expr != nullptr);
 
     // Skip if no message was generated from this expr
-    if (objc_message_map_.find(expr) == objc_message_map_.end()) {
+    auto it = objc_message_map_.find(expr);
+    if (it == objc_message_map_.end()) {
         return;
     }
 
-    auto msg = std::move(objc_message_map_.at(expr));
+    auto msg = std::move(it->second);
 
     auto caller_id = msg.from();
     diagram().get_activity(caller_id).add_message(std::move(msg));
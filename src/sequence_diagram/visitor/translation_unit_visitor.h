@@ -22,6 +22,7 @@
 #include "common/visitor/translation_unit_visitor.h"
 #include "config/config.h"
 #include "sequence_diagram/model/diagram.h"
+#include "util/flat_hash_map.h"
 
 #include <clang/AST/Expr.h>
 #include <clang/AST/RecursiveASTVisitor.h>
@@ -578,16 +579,21 @@ private:
      * expressions (e.g. a(b(c(), d())), as they need to be added to the diagram
      * sequence after the visitor leaves the call expression AST node
      */
-    std::map<clang::CallExpr *, std::deque<model::message>>
+    util::flat_hash_map<clang::CallExpr *, std::deque<model::message>>
         call_expr_message_map_;
-    std::map<clang::ReturnStmt *, model::message> return_stmt_message_map_;
-    std::map<clang::CoreturnStmt *, model::message> co_return_stmt_message_map_;
-    std::map<clang::CoyieldExpr *, model::message> co_yield_stmt_message_map_;
-    std::map<clang::CoawaitExpr *, model::message> co_await_stmt_message_map_;
-
-    std::map<clang::CXXConstructExpr *, model::message>
+    util::flat_hash_map<clang::ReturnStmt *, model::message>
+        return_stmt_message_map_;
+    util::flat_hash_map<clang::CoreturnStmt *, model::message>
+        co_return_stmt_message_map_;
+    util::flat_hash_map<clang::CoyieldExpr *, model::message>
+        co_yield_stmt_message_map_;
+    util::flat_hash_map<clang::CoawaitExpr *, model::message>
+        co_await_stmt_message_map_;
+
+    util::flat_hash_map<clang::CXXConstructExpr *, model::message>
         construct_expr_message_map_;
-    std::map<clang::ObjCMessageExpr *, model::message> objc_message_map_;
+    util::flat_hash_map<clang::ObjCMessageExpr *, model::message>
+        objc_message_map_;
 
     std::map<eid_t, std::unique_ptr<clanguml::sequence_diagram::model::class_>>
         forward_declarations_;
@@ -0,0 +1,338 @@
+/**
+ * @file src/util/flat_hash_map.h
+ *
+ * Copyright (c) 2021-2025 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace clanguml::util {
+
+/**
+ * @brief Open addressing hash map with linear probing
+ *
+ * All entries are stored in a single contiguous array, which makes lookups
+ * of small keys (such as integers or pointers) considerably faster than in
+ * node based `std::map` or `std::unordered_map`. Removed entries are
+ * compacted using backward shift deletion, so the table never contains
+ * tombstones.
+ *
+ * `clear()` does not release the allocated table, which allows to reuse the
+ * map without reallocations.
+ *
+ * @note Any insertion or removal invalidates all iterators and references
+ *       to the map elements.
+ *
+ * @tparam Key Key type
+ * @tparam T Mapped type
+ * @tparam Hash Hash function for the key type
+ */
+template <typename Key, typename T, typename Hash = std::hash<Key>>
+class flat_hash_map {
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<Key, T>;
+
+    template <typename MapT, typename ValueT> class iterator_t {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = ValueT;
+        using pointer = ValueT *;
+        using reference = ValueT &;
+
+        iterator_t() = default;
+
+        iterator_t(MapT *map, std::size_t pos)
+            : map_{map}
+            , pos_{pos}
+        {
+            skip_empty();
+        }
+
+        reference operator*() const { return *map_->slots_[pos_]; }
+
+        pointer operator->() const { return &(*map_->slots_[pos_]); }
+
+        iterator_t &operator++()
+        {
+            ++pos_;
+            skip_empty();
+            return *this;
+        }
+
+        iterator_t operator++(int)
+        {
+            auto tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        bool operator==(const iterator_t &r) const { return pos_ == r.pos_; }
+
+        bool operator!=(const iterator_t &r) const { return pos_ != r.pos_; }
+
+    private:
+        void skip_empty()
+        {
+            while (pos_ < map_->slots_.size() && !map_->slots_[pos_])
+                ++pos_;
+        }
+
+        MapT *map_{nullptr};
+        std::size_t pos_{0};
+    };
+
+    using iterator = iterator_t<flat_hash_map, value_type>;
+    using const_iterator = iterator_t<const flat_hash_map, const value_type>;
+
+    flat_hash_map() = default;
+
+    flat_hash_map(const flat_hash_map &) = default;
+
+    flat_hash_map(flat_hash_map &&other) noexcept
+        : slots_{std::move(other.slots_)}
+        , size_{std::exchange(other.size_, 0)}
+        , shift_{std::exchange(other.shift_, kHashBits)}
+    {
+        other.slots_.clear();
+    }
+
+    flat_hash_map &operator=(const flat_hash_map &) = default;
+
+    flat_hash_map &operator=(flat_hash_map &&other) noexcept
+    {
+        if (this != &other) {
+            slots_ = std::move(other.slots_);
+            size_ = std::exchange(other.size_, 0);
+            shift_ = std::exchange(other.shift_, kHashBits);
+            other.slots_.clear();
+        }
+        return *this;
+    }
+
+    ~flat_hash_map() = default;
+
+    iterator begin() { return {this, 0}; }
+    iterator end() { return {this, slots_.size()}; }
+    const_iterator begin() const { return {this, 0}; }
+    const_iterator end() const { return {this, slots_.size()}; }
+
+    std::size_t size() const { return size_; }
+
+    bool empty() const { return size_ == 0; }
+
+    /**
+     * @brief Number of slots in the table
+     *
+     * @return Allocated capacity
+     */
+    std::size_t capacity() const { return slots_.size(); }
+
+    /**
+     * @brief Make sure that at least `n` elements fit without rehashing
+     *
+     * @param n Number of elements
+     */
+    void reserve(std::size_t n)
+    {
+        std::size_t capacity{kMinCapacity};
+        while (capacity * kMaxLoadNum < n * kMaxLoadDen)
+            capacity *= 2;
+
+        if (capacity > slots_.size())
+            rehash(capacity);
+    }
+
+    /**
+     * @brief Remove all elements, keeping the allocated table
+     */
+    void clear()
+    {
+        if (size_ == 0)
+            return;
+
+        for (auto &slot : slots_)
+            slot.reset();
+
+        size_ = 0;
+    }
+
+    iterator find(const Key &key) { return {this, find_slot(key)}; }
+
+    const_iterator find(const Key &key) const
+    {
+        return {this, find_slot(key)};
+    }
+
+    bool contains(const Key &key) const
+    {
+        return find_slot(key) != slots_.size();
+    }
+
+    std::size_t count(const Key &key) const { return contains(key) ? 1 : 0; }
+
+    T &at(const Key &key)
+    {
+        const auto pos = find_slot(key);
+        if (pos == slots_.size())
+            throw std::out_of_range("flat_hash_map::at");
+
+        return slots_[pos]->second;
+    }
+
+    const T &at(const Key &key) const
+    {
+        const auto pos = find_slot(key);
+        if (pos == slots_.size())
+            throw std::out_of_range("flat_hash_map::at");
+
+        return slots_[pos]->second;
+    }
+
+    T &operator[](const Key &key) { return emplace(key, T{}).first->second; }
+
+    /**
+     * @brief Insert a new element, if the key does not exist in the map
+     *
+     * @param key Element key
+     * @param value Element value
+     * @return Iterator to the element with key and whether it was inserted
+     */
+    template <typename V>
+    std::pair<iterator, bool> emplace(const Key &key, V &&value)
+    {
+        if (auto pos = find_slot(key); pos != slots_.size())
+            return {{this, pos}, false};
+
+        if ((size_ + 1) * kMaxLoadDen > slots_.size() * kMaxLoadNum)
+            rehash(slots_.empty() ? kMinCapacity : slots_.size() * 2);
+
+        auto pos = bucket(key);
+        while (slots_[pos])
+            pos = next(pos);
+
+        slots_[pos].emplace(key, std::forward<V>(value));
+        ++size_;
+
+        return {{this, pos}, true};
+    }
+
+    /**
+     * @brief Remove element with key, if exists
+     *
+     * @param key Element key
+     * @return Number of removed elements
+     */
+    std::size_t erase(const Key &key)
+    {
+        auto pos = find_slot(key);
+        if (pos == slots_.size())
+            return 0;
+
+        // Shift back the following elements from the same probe sequence,
+        // so that lookups never need to skip over removed entries
+        auto hole = pos;
+        for (auto it = next(pos); slots_[it]; it = next(it)) {
+            const auto home = bucket(slots_[it]->first);
+            if (distance(home, it) >= distance(hole, it)) {
+                slots_[hole] = std::move(slots_[it]);
+                hole = it;
+            }
+        }
+
+        slots_[hole].reset();
+        --size_;
+
+        return 1;
+    }
+
+private:
+    static constexpr std::size_t kMinCapacity{16};
+    // Maximum load factor 7/8
+    static constexpr std::size_t kMaxLoadNum{7};
+    static constexpr std::size_t kMaxLoadDen{8};
+
+    std::size_t bucket(const Key &key) const
+    {
+        // Scramble the hash, as std::hash is an identity function for
+        // integers and pointers in most standard library implementations
+        constexpr uint64_t kFibonacciMultiplier{0x9E3779B97F4A7C15ULL};
+        const auto h =
+            static_cast<uint64_t>(Hash{}(key)) * kFibonacciMultiplier;
+
+        return static_cast<std::size_t>(h >> shift_);
+    }
+
+    std::size_t next(std::size_t pos) const
+    {
+        return (pos + 1) & (slots_.size() - 1);
+    }
+
+    std::size_t distance(std::size_t from, std::size_t to) const
+    {
+        return (to - from) & (slots_.size() - 1);
+    }
+
+    std::size_t find_slot(const Key &key) const
+    {
+        if (size_ == 0)
+            return slots_.size();
+
+        for (auto pos = bucket(key); slots_[pos]; pos = next(pos)) {
+            if (slots_[pos]->first == key)
+                return pos;
+        }
+
+        return slots_.size();
+    }
+
+    void rehash(std::size_t capacity)
+    {
+        std::vector<std::optional<value_type>> slots(capacity);
+        std::swap(slots, slots_);
+
+        shift_ = kHashBits;
+        for (auto c = capacity; c > 1; c >>= 1U)
+            --shift_;
+
+        for (auto &slot : slots) {
+            if (!slot)
+                continue;
+
+            auto pos = bucket(slot->first);
+            while (slots_[pos])
+                pos = next(pos);
+
+            slots_[pos] = std::move(slot);
+        }
+    }
+
+    static constexpr unsigned kHashBits{64};
+
+    std::vector<std::optional<value_type>> slots_;
+    std::size_t size_{0};
+    unsigned shift_{kHashBits};
+};
+
+} // namespace clanguml::util
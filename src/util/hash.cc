@@ -0,0 +1,166 @@
+/**
+ * @file src/util/hash.cc
+ *
+ * Copyright (c) 2021-2025 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hash.h"
+
+#include <algorithm>
+
+namespace clanguml::util {
+
+namespace {
+constexpr uint64_t kPrime1{0x9E3779B185EBCA87ULL};
+constexpr uint64_t kPrime2{0xC2B2AE3D27D4EB4FULL};
+constexpr uint64_t kPrime3{0x165667B19E3779F9ULL};
+constexpr uint64_t kPrime4{0x85EBCA77C2B2AE63ULL};
+constexpr uint64_t kPrime5{0x27D4EB2F165667C5ULL};
+
+constexpr uint64_t rotl(uint64_t x, int r)
+{
+    return (x << r) | (x >> (64 - r)); // NOLINT
+}
+
+// Read input in little-endian order, so that the result does not depend
+// on the host byte order
+uint64_t read64(const unsigned char *p)
+{
+    uint64_t result{0};
+    for (auto i = 0U; i < 8U; i++)
+        result |= static_cast<uint64_t>(p[i]) << (8U * i); // NOLINT
+    return result;
+}
+
+uint64_t read32(const unsigned char *p)
+{
+    uint64_t result{0};
+    for (auto i = 0U; i < 4U; i++)
+        result |= static_cast<uint64_t>(p[i]) << (8U * i); // NOLINT
+    return result;
+}
+
+uint64_t round(uint64_t acc, uint64_t input)
+{
+    acc += input * kPrime2;
+    acc = rotl(acc, 31); // NOLINT
+    return acc * kPrime1;
+}
+
+uint64_t merge_round(uint64_t acc, uint64_t val)
+{
+    acc ^= round(0, val);
+    return acc * kPrime1 + kPrime4;
+}
+
+void consume_stripe(std::array<uint64_t, 4> &acc, const unsigned char *p)
+{
+    for (auto i = 0U; i < 4U; i++)
+        acc[i] = round(acc[i], read64(p + 8U * i)); // NOLINT
+}
+} // namespace
+
+hash64::hash64(uint64_t seed)
+    : seed_{seed}
+    , acc_{seed + kPrime1 + kPrime2, seed + kPrime2, seed, seed - kPrime1}
+{
+}
+
+hash64 &hash64::update(std::string_view data)
+{
+    const auto *p = reinterpret_cast<const unsigned char *>(data.data());
+    const auto *const end = p + data.size();
+
+    total_size_ += data.size();
+
+    // Complete the partially filled stripe from previous calls first
+    if (buffer_size_ > 0) {
+        const auto n = std::min<std::size_t>(kStripeSize - buffer_size_,
+            static_cast<std::size_t>(end - p));
+        std::copy(p, p + n, buffer_.begin() + buffer_size_);
+        buffer_size_ += n;
+        p += n;
+
+        if (buffer_size_ < kStripeSize)
+            return *this;
+
+        consume_stripe(acc_, buffer_.data());
+        buffer_size_ = 0;
+    }
+
+    while (static_cast<std::size_t>(end - p) >= kStripeSize) {
+        consume_stripe(acc_, p);
+        p += kStripeSize;
+    }
+
+    std::copy(p, end, buffer_.begin());
+    buffer_size_ = static_cast<std::size_t>(end - p);
+
+    return *this;
+}
+
+uint64_t hash64::digest() const
+{
+    uint64_t h{0};
+
+    if (total_size_ >= kStripeSize) {
+        h = rotl(acc_[0], 1) + rotl(acc_[1], 7) + rotl(acc_[2], 12) + // NOLINT
+            rotl(acc_[3], 18);                                          // NOLINT
+        for (const auto v : acc_)
+            h = merge_round(h, v);
+    }
+    else {
+        h = seed_ + kPrime5;
+    }
+
+    h += total_size_;
+
+    const auto *p = buffer_.data();
+    const auto *const end = p + buffer_size_;
+
+    while (p + 8 <= end) {
+        h ^= round(0, read64(p));
+        h = rotl(h, 27) * kPrime1 + kPrime4; // NOLINT
+        p += 8;
+    }
+
+    if (p + 4 <= end) {
+        h ^= read32(p) * kPrime1;
+        h = rotl(h, 23) * kPrime2 + kPrime3; // NOLINT
+        p += 4;
+    }
+
+    while (p < end) {
+        h ^= *p * kPrime5;
+        h = rotl(h, 11) * kPrime1; // NOLINT
+        p++;
+    }
+
+    // Final avalanche
+    h ^= h >> 33U; // NOLINT
+    h *= kPrime2;
+    h ^= h >> 29U; // NOLINT
+    h *= kPrime3;
+    h ^= h >> 32U; // NOLINT
+
+    return h;
+}
+
+uint64_t hash64::of(std::string_view data, uint64_t seed)
+{
+    return hash64{seed}.update(data).digest();
+}
+
+} // namespace clanguml::util
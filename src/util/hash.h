@@ -0,0 +1,76 @@
+/**
+ * @file src/util/hash.h
+ *
+ * Copyright (c) 2021-2025 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace clanguml::util {
+
+/**
+ * @brief Stable, seedable 64-bit hash
+ *
+ * Implementation of the XXH64 algorithm, which produces the same values
+ * regardless of platform, compiler or standard library. Unlike
+ * `std::hash<std::string>`, the values can be therefore stored on disk
+ * or compared between different runs of clang-uml.
+ *
+ * The hash can be computed incrementally using `update()` - feeding the
+ * input in several parts yields the same value as hashing the
+ * concatenated input at once.
+ */
+class hash64 {
+public:
+    explicit hash64(uint64_t seed = 0);
+
+    /**
+     * @brief Append data to the hashed input
+     *
+     * @param data Input data
+     * @return Reference to this hasher
+     */
+    hash64 &update(std::string_view data);
+
+    /**
+     * @brief Compute the hash of all data passed so far to `update()`
+     *
+     * @return 64-bit hash value
+     */
+    uint64_t digest() const;
+
+    /**
+     * @brief Compute the hash of a complete input
+     *
+     * @param data Input data
+     * @param seed Hash seed
+     * @return 64-bit hash value
+     */
+    static uint64_t of(std::string_view data, uint64_t seed = 0);
+
+private:
+    static constexpr std::size_t kStripeSize{32};
+
+    uint64_t seed_;
+    std::array<uint64_t, 4> acc_;
+    std::array<unsigned char, kStripeSize> buffer_{};
+    std::size_t buffer_size_{0};
+    uint64_t total_size_{0};
+};
+
+} // namespace clanguml::util
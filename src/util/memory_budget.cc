@@ -0,0 +1,251 @@
+/**
+ * @file src/util/memory_budget.cc
+ *
+ * Copyright (c) 2021-2025 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "memory_budget.h"
+
+#include "util/logging.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+namespace clanguml::util {
+
+namespace {
+// Expected memory usage of a task before any task has completed
+constexpr uint64_t kInitialEstimate{512ULL * 1024ULL * 1024ULL};
+
+// Memory usage changes without any notification, so waiting tasks have
+// to check it periodically
+constexpr auto kPollInterval = std::chrono::milliseconds{100};
+
+uint64_t saturating_sub(uint64_t a, uint64_t b) { return a > b ? a - b : 0; }
+} // namespace
+
+memory_budget::ticket::ticket(memory_budget *budget, uint64_t id)
+    : budget_{budget}
+    , id_{id}
+{
+}
+
+memory_budget::ticket::ticket(ticket &&other) noexcept
+    : budget_{other.budget_}
+    , id_{other.id_}
+{
+    other.budget_ = nullptr;
+}
+
+memory_budget::ticket &memory_budget::ticket::operator=(
+    ticket &&other) noexcept
+{
+    if (this != &other) {
+        release();
+        budget_ = other.budget_;
+        id_ = other.id_;
+        other.budget_ = nullptr;
+    }
+
+    return *this;
+}
+
+memory_budget::ticket::~ticket() { release(); }
+
+void memory_budget::ticket::release()
+{
+    if (budget_ != nullptr)
+        budget_->release(id_);
+
+    budget_ = nullptr;
+}
+
+memory_budget &memory_budget::instance()
+{
+    static memory_budget budget;
+    return budget;
+}
+
+memory_budget::memory_budget(std::function<uint64_t()> rss_reader)
+    : rss_reader_{std::move(rss_reader)}
+    , estimate_{kInitialEstimate}
+{
+}
+
+void memory_budget::set_limit(uint64_t limit)
+{
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        limit_ = limit;
+    }
+
+    released_.notify_all();
+}
+
+bool memory_budget::enabled() const
+{
+    std::lock_guard<std::mutex> l(mutex_);
+    return limit_ > 0;
+}
+
+memory_budget::ticket memory_budget::admit(const std::string &key)
+{
+    bool waited{false};
+
+    while (true) {
+        if (auto result = try_admit(key); result) {
+            if (waited)
+                LOG_DBG("Task {} admitted by memory budget", key);
+            return std::move(*result);
+        }
+
+        if (!waited) {
+            LOG_DBG("Task {} waiting for memory budget - expected usage {} "
+                    "bytes",
+                key, estimate(key));
+            waited = true;
+        }
+
+        std::unique_lock<std::mutex> l(mutex_);
+        released_.wait_for(l, kPollInterval);
+    }
+}
+
+std::optional<memory_budget::ticket> memory_budget::try_admit(
+    const std::string &key)
+{
+    std::lock_guard<std::mutex> l(mutex_);
+
+    if (limit_ == 0)
+        return ticket{};
+
+    const auto rss = rss_reader_();
+    update_peaks(rss);
+
+    const auto expected_usage = estimate_impl(key);
+
+    if (!running_.empty()) {
+        // Memory, which running tasks are still expected to allocate
+        uint64_t pending{0};
+        for (const auto &[id, t] : running_) {
+            pending += saturating_sub(
+                t.expected_usage, saturating_sub(t.peak_rss, t.start_rss));
+        }
+
+        if (rss + pending + expected_usage > limit_)
+            return std::nullopt;
+    }
+
+    const auto id = next_id_++;
+    running_.emplace(id, task{key, expected_usage, rss, rss});
+
+    return ticket{this, id};
+}
+
+void memory_budget::sample()
+{
+    std::lock_guard<std::mutex> l(mutex_);
+
+    if (limit_ == 0 || running_.empty())
+        return;
+
+    update_peaks(rss_reader_());
+}
+
+uint64_t memory_budget::estimate(const std::string &key) const
+{
+    std::lock_guard<std::mutex> l(mutex_);
+
+    return estimate_impl(key);
+}
+
+uint64_t memory_budget::resident_set_size()
+{
+#if defined(__linux__)
+    // Second field of /proc/self/statm is the resident set size in pages
+    std::ifstream statm{"/proc/self/statm"};
+    uint64_t size{0};
+    uint64_t resident{0};
+    if (!(statm >> size >> resident))
+        return 0;
+
+    return resident * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+#else
+    return 0;
+#endif
+}
+
+uint64_t memory_budget::peak_resident_set_size()
+{
+#if defined(__linux__)
+    // VmHWM entry of /proc/self/status is the peak resident set size in kB
+    std::ifstream status{"/proc/self/status"};
+    std::string token;
+    while (status >> token) {
+        uint64_t peak_kb{0};
+        if (token == "VmHWM:")
+            return (status >> peak_kb) ? peak_kb * 1024 : 0;
+    }
+
+    return 0;
+#else
+    return 0;
+#endif
+}
+
+void memory_budget::release(uint64_t id)
+{
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+
+        auto it = running_.find(id);
+        if (it == running_.end())
+            return;
+
+        auto &t = it->second;
+        t.peak_rss = std::max(t.peak_rss, rss_reader_());
+        const auto usage = saturating_sub(t.peak_rss, t.start_rss);
+
+        usage_[t.key] = usage;
+
+        // Follow peaks immediately, but decrease the estimate slowly
+        estimate_ = std::max(usage, estimate_ - estimate_ / 8);
+
+        running_.erase(it);
+    }
+
+    released_.notify_all();
+}
+
+uint64_t memory_budget::estimate_impl(const std::string &key) const
+{
+    if (auto it = usage_.find(key); it != usage_.end())
+        return it->second;
+
+    return estimate_;
+}
+
+void memory_budget::update_peaks(uint64_t rss)
+{
+    for (auto &[id, t] : running_)
+        t.peak_rss = std::max(t.peak_rss, rss);
+}
+
+} // namespace clanguml::util
@@ -0,0 +1,177 @@
+/**
+ * @file src/util/memory_budget.h
+ *
+ * Copyright (c) 2021-2025 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace clanguml::util {
+
+/**
+ * @brief Process-wide memory budget for parsing translation units
+ *
+ * Before a translation unit is parsed, the parsing thread has to be
+ * admitted by the budget. A task is admitted only if the current resident
+ * set size of the process, increased by the expected memory usage of the
+ * new task and of already admitted tasks, which have not yet allocated
+ * their memory, fits in the limit. A task is always admitted if no other
+ * task is running, so translation units which do not fit in the budget
+ * together with others are parsed one at a time.
+ *
+ * The expected memory usage of a task is the peak usage observed for the
+ * same task key (e.g. translation unit path) in the past, or an estimate
+ * learned from the peak usage of all completed tasks.
+ */
+class memory_budget {
+public:
+    /**
+     * @brief Admission of a single task, released on destruction
+     */
+    class ticket {
+    public:
+        ticket() = default;
+
+        ticket(memory_budget *budget, uint64_t id);
+
+        ticket(const ticket &) = delete;
+        ticket(ticket &&other) noexcept;
+        ticket &operator=(const ticket &) = delete;
+        ticket &operator=(ticket &&other) noexcept;
+
+        ~ticket();
+
+        /**
+         * @brief Release the admission before the ticket is destroyed
+         */
+        void release();
+
+    private:
+        memory_budget *budget_{nullptr};
+        uint64_t id_{0};
+    };
+
+    /**
+     * @brief Get the process-wide memory budget instance
+     *
+     * @return Reference to the memory budget
+     */
+    static memory_budget &instance();
+
+    /**
+     * @brief Constructor
+     *
+     * @param rss_reader Function returning current resident set size of the
+     *                   process in bytes
+     */
+    explicit memory_budget(
+        std::function<uint64_t()> rss_reader = resident_set_size);
+
+    /**
+     * @brief Set the memory limit
+     *
+     * @param limit Memory limit in bytes, 0 disables the budget
+     */
+    void set_limit(uint64_t limit);
+
+    /**
+     * @brief Whether the memory limit is set
+     *
+     * @return True, if tasks have to be admitted by the budget
+     */
+    bool enabled() const;
+
+    /**
+     * @brief Wait until a task fits in the memory budget
+     *
+     * @param key Key identifying the task, e.g. translation unit path
+     * @return Ticket, which has to be kept until the task is finished
+     */
+    ticket admit(const std::string &key);
+
+    /**
+     * @brief Admit a task if it fits in the memory budget without waiting
+     *
+     * @param key Key identifying the task, e.g. translation unit path
+     * @return Ticket or std::nullopt, if the task does not fit in the budget
+     */
+    std::optional<ticket> try_admit(const std::string &key);
+
+    /**
+     * @brief Record current memory usage as a candidate for peak usage of
+     *        all running tasks
+     *
+     * Should be called at points where the memory usage of a task is
+     * expected to be the highest, e.g. after a translation unit is parsed.
+     */
+    void sample();
+
+    /**
+     * @brief Get expected memory usage of a task
+     *
+     * @param key Key identifying the task
+     * @return Expected memory usage in bytes
+     */
+    uint64_t estimate(const std::string &key) const;
+
+    /**
+     * @brief Read resident set size of the current process
+     *
+     * @return Resident set size in bytes, 0 if it cannot be determined
+     */
+    static uint64_t resident_set_size();
+
+    /**
+     * @brief Read peak resident set size of the current process
+     *
+     * @return Peak resident set size in bytes, 0 if it cannot be determined
+     */
+    static uint64_t peak_resident_set_size();
+
+private:
+    struct task {
+        std::string key;
+        uint64_t expected_usage{0};
+        uint64_t start_rss{0};
+        uint64_t peak_rss{0};
+    };
+
+    void release(uint64_t id);
+
+    uint64_t estimate_impl(const std::string &key) const;
+
+    void update_peaks(uint64_t rss);
+
+    std::function<uint64_t()> rss_reader_;
+    uint64_t limit_{0};
+    uint64_t estimate_;
+    uint64_t next_id_{1};
+
+    std::map<uint64_t, task> running_;
+    std::unordered_map<std::string, uint64_t> usage_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable released_;
+};
+
+} // namespace clanguml::util
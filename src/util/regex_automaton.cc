@@ -0,0 +1,744 @@
+/**
+ * @file src/util/regex_automaton.cc
+ *
+ * Copyright (c) 2021-2025 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "regex_automaton.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace clanguml::util {
+
+namespace {
+constexpr uint32_t kUnbounded{std::numeric_limits<uint32_t>::max()};
+constexpr uint32_t kMaxRepeat{1000};
+constexpr std::size_t kMaxProgramSize{1U << 16U};
+
+/**
+ * @brief Node of a parsed regular expression
+ */
+struct node {
+    enum class kind_t {
+        kChar,
+        kClass,
+        kBegin,
+        kEnd,
+        kConcat,
+        kAlternate,
+        kRepeat
+    };
+
+    explicit node(kind_t k)
+        : kind{k}
+    {
+    }
+
+    kind_t kind;
+    unsigned char ch{0};
+    std::bitset<256> cls;
+    uint32_t min{0};
+    uint32_t max{0};
+    std::vector<std::unique_ptr<node>> children;
+};
+
+using node_ptr = std::unique_ptr<node>;
+
+bool is_digit(char c) { return c >= '0' && c <= '9'; }
+
+bool is_alnum(char c)
+{
+    return is_digit(c) || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+int hex_value(char c)
+{
+    if (is_digit(c))
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+std::bitset<256> class_escape(char c)
+{
+    std::bitset<256> result;
+    const auto set_range = [&result](unsigned char lo, unsigned char hi) {
+        for (auto i = lo; i <= hi; i++)
+            result.set(i);
+    };
+
+    switch (c) {
+    case 'd':
+    case 'D':
+        set_range('0', '9');
+        break;
+    case 'w':
+    case 'W':
+        set_range('0', '9');
+        set_range('a', 'z');
+        set_range('A', 'Z');
+        result.set('_');
+        break;
+    default: // 's' or 'S'
+        for (const auto ws : {' ', '\t', '\n', '\v', '\f', '\r'})
+            result.set(static_cast<unsigned char>(ws));
+        break;
+    }
+
+    if (c == 'D' || c == 'W' || c == 'S')
+        result.flip();
+
+    return result;
+}
+
+/**
+ * @brief Recursive descent parser of the supported subset of ECMAScript
+ *        regular expressions
+ *
+ * The parser bails out on any construct, which is not supported or
+ * which could be interpreted differently than by `std::regex`.
+ */
+class parser {
+public:
+    explicit parser(std::string_view pattern)
+        : pattern_{pattern}
+    {
+    }
+
+    node_ptr parse()
+    {
+        auto result = parse_alternate();
+        if (!ok_ || !at_end())
+            return {};
+
+        return result;
+    }
+
+private:
+    /**
+     * @brief Single character or character class
+     */
+    struct class_atom {
+        bool is_class{false};
+        unsigned char ch{0};
+        std::bitset<256> cls;
+    };
+
+    bool at_end() const { return pos_ >= pattern_.size(); }
+
+    char peek(std::size_t offset = 0) const
+    {
+        return pos_ + offset < pattern_.size() ? pattern_[pos_ + offset]
+                                               : '\0';
+    }
+
+    node_ptr fail()
+    {
+        ok_ = false;
+        return {};
+    }
+
+    node_ptr parse_alternate()
+    {
+        auto first = parse_concat();
+        if (!ok_ || at_end() || peek() != '|')
+            return first;
+
+        auto result = std::make_unique<node>(node::kind_t::kAlternate);
+        result->children.emplace_back(std::move(first));
+
+        while (ok_ && !at_end() && peek() == '|') {
+            pos_++;
+            result->children.emplace_back(parse_concat());
+        }
+
+        return ok_ ? std::move(result) : node_ptr{};
+    }
+
+    node_ptr parse_concat()
+    {
+        auto result = std::make_unique<node>(node::kind_t::kConcat);
+
+        while (ok_ && !at_end() && peek() != '|' && peek() != ')') {
+            auto item = parse_repeat();
+            if (!item)
+                return fail();
+
+            result->children.emplace_back(std::move(item));
+        }
+
+        return ok_ ? std::move(result) : node_ptr{};
+    }
+
+    node_ptr parse_repeat()
+    {
+        auto atom = parse_atom();
+        if (!atom || at_end())
+            return atom;
+
+        uint32_t min{0};
+        uint32_t max{kUnbounded};
+        switch (peek()) {
+        case '*':
+            pos_++;
+            break;
+        case '+':
+            min = 1;
+            pos_++;
+            break;
+        case '?':
+            max = 1;
+            pos_++;
+            break;
+        case '{':
+            if (!parse_bounds(min, max))
+                return fail();
+            break;
+        default:
+            return atom;
+        }
+
+        // Lazy quantifiers do not change the set of matched strings
+        if (peek() == '?')
+            pos_++;
+
+        // Repeated quantifiers and quantified assertions are not supported
+        if (peek() == '*' || peek() == '+' || peek() == '?' ||
+            peek() == '{' || atom->kind == node::kind_t::kBegin ||
+            atom->kind == node::kind_t::kEnd)
+            return fail();
+
+        auto result = std::make_unique<node>(node::kind_t::kRepeat);
+        result->min = min;
+        result->max = max;
+        result->children.emplace_back(std::move(atom));
+
+        return result;
+    }
+
+    bool parse_bound(uint32_t &value)
+    {
+        if (!is_digit(peek()))
+            return false;
+
+        value = 0;
+        while (is_digit(peek())) {
+            value = value * 10 + static_cast<uint32_t>(peek() - '0');
+            if (value > kMaxRepeat)
+                return false;
+            pos_++;
+        }
+
+        return true;
+    }
+
+    bool parse_bounds(uint32_t &min, uint32_t &max)
+    {
+        pos_++; // '{'
+
+        if (!parse_bound(min))
+            return false;
+
+        max = min;
+        if (peek() == ',') {
+            pos_++;
+            max = kUnbounded;
+            if (peek() != '}' && !parse_bound(max))
+                return false;
+        }
+
+        if (peek() != '}' || min > max)
+            return false;
+
+        pos_++;
+
+        return true;
+    }
+
+    node_ptr parse_atom()
+    {
+        const auto c = peek();
+
+        switch (c) {
+        case '(': {
+            pos_++;
+            if (peek() == '?') {
+                // Only non-capturing groups are supported
+                if (peek(1) != ':')
+                    return fail();
+                pos_ += 2;
+            }
+
+            auto result = parse_alternate();
+            if (!ok_ || peek() != ')')
+                return fail();
+
+            pos_++;
+
+            return result;
+        }
+        case '.': {
+            pos_++;
+            auto result = std::make_unique<node>(node::kind_t::kClass);
+            result->cls.set();
+            result->cls.reset('\n');
+            result->cls.reset('\r');
+            return result;
+        }
+        case '[':
+            return parse_bracket();
+        case '\\': {
+            pos_++;
+            class_atom atom;
+            if (!parse_escape(false, atom))
+                return fail();
+
+            return make_atom_node(atom);
+        }
+        case '^':
+            pos_++;
+            return std::make_unique<node>(node::kind_t::kBegin);
+        case '$':
+            pos_++;
+            return std::make_unique<node>(node::kind_t::kEnd);
+        case '*':
+        case '+':
+        case '?':
+        case '{':
+        case '}':
+        case ']':
+        case ')':
+        case '|':
+            return fail();
+        default: {
+            pos_++;
+            auto result = std::make_unique<node>(node::kind_t::kChar);
+            result->ch = static_cast<unsigned char>(c);
+            return result;
+        }
+        }
+    }
+
+    static node_ptr make_atom_node(const class_atom &atom)
+    {
+        if (atom.is_class) {
+            auto result = std::make_unique<node>(node::kind_t::kClass);
+            result->cls = atom.cls;
+            return result;
+        }
+
+        auto result = std::make_unique<node>(node::kind_t::kChar);
+        result->ch = atom.ch;
+        return result;
+    }
+
+    bool parse_escape(bool in_bracket, class_atom &atom)
+    {
+        if (at_end())
+            return false;
+
+        const auto c = pattern_[pos_++];
+
+        switch (c) {
+        case 'd':
+        case 'D':
+        case 'w':
+        case 'W':
+        case 's':
+        case 'S':
+            atom.is_class = true;
+            atom.cls = class_escape(c);
+            return true;
+        case 't':
+            atom.ch = '\t';
+            return true;
+        case 'n':
+            atom.ch = '\n';
+            return true;
+        case 'r':
+            atom.ch = '\r';
+            return true;
+        case 'f':
+            atom.ch = '\f';
+            return true;
+        case 'v':
+            atom.ch = '\v';
+            return true;
+        case '0':
+            atom.ch = '\0';
+            return !is_digit(peek());
+        case 'x': {
+            const auto hi = hex_value(peek());
+            const auto lo = hex_value(peek(1));
+            if (hi < 0 || lo < 0)
+                return false;
+            pos_ += 2;
+            atom.ch = static_cast<unsigned char>(hi * 16 + lo);
+            return true;
+        }
+        case 'b':
+            // Backspace in bracket expressions, word boundary otherwise
+            atom.ch = '\b';
+            return in_bracket;
+        default:
+            // Backreferences and other escapes are not supported
+            if (is_alnum(c))
+                return false;
+
+            atom.ch = static_cast<unsigned char>(c);
+            return true;
+        }
+    }
+
+    bool parse_class_atom(class_atom &atom)
+    {
+        const auto c = peek();
+
+        // Character ranges with non-ASCII characters depend on the
+        // signedness of char, and POSIX classes are not supported
+        if (static_cast<unsigned char>(c) > 127U ||
+            (c == '[' &&
+                (peek(1) == ':' || peek(1) == '.' || peek(1) == '=')))
+            return false;
+
+        pos_++;
+
+        if (c == '\\')
+            return parse_escape(true, atom);
+
+        atom.ch = static_cast<unsigned char>(c);
+
+        return true;
+    }
+
+    node_ptr parse_bracket()
+    {
+        pos_++; // '['
+
+        bool negate{false};
+        if (peek() == '^') {
+            negate = true;
+            pos_++;
+        }
+
+        // Empty bracket expressions are not supported
+        if (peek() == ']')
+            return fail();
+
+        auto result = std::make_unique<node>(node::kind_t::kClass);
+
+        while (true) {
+            if (at_end())
+                return fail();
+
+            if (peek() == ']') {
+                pos_++;
+                break;
+            }
+
+            class_atom lo;
+            if (!parse_class_atom(lo))
+                return fail();
+
+            if (lo.is_class) {
+                result->cls |= lo.cls;
+                continue;
+            }
+
+            if (peek() == '-' && peek(1) != ']' && !at_end()) {
+                pos_++; // '-'
+
+                class_atom hi;
+                if (!parse_class_atom(hi) || hi.is_class || hi.ch < lo.ch)
+                    return fail();
+
+                for (unsigned i = lo.ch; i <= hi.ch; i++)
+                    result->cls.set(i);
+            }
+            else {
+                result->cls.set(lo.ch);
+            }
+        }
+
+        if (negate)
+            result->cls.flip();
+
+        return result;
+    }
+
+    std::string_view pattern_;
+    std::size_t pos_{0};
+    bool ok_{true};
+};
+
+/**
+ * @brief Per-thread buffers for simulating the automaton
+ */
+struct simulation_state {
+    std::vector<uint32_t> current;
+    std::vector<uint32_t> next;
+    std::vector<uint32_t> stack;
+    std::vector<uint64_t> marks;
+    uint64_t generation{0};
+};
+
+simulation_state &thread_simulation_state()
+{
+    thread_local simulation_state state;
+    return state;
+}
+} // namespace
+
+/**
+ * @brief Compiler of parsed regular expressions into automaton program
+ */
+class regex_automaton::compiler {
+public:
+    explicit compiler(regex_automaton &automaton)
+        : automaton_{automaton}
+    {
+    }
+
+    bool compile(const std::vector<node_ptr> &patterns)
+    {
+        if (patterns.empty()) {
+            // Empty pattern list does not match anything
+            automaton_.classes_.emplace_back();
+            emit(op_t::kClass, 0);
+        }
+        else {
+            emit_alternate(patterns);
+        }
+
+        emit(op_t::kMatch);
+
+        return ok_;
+    }
+
+private:
+    uint32_t pc() const
+    {
+        return static_cast<uint32_t>(automaton_.program_.size());
+    }
+
+    uint32_t emit(op_t op, uint32_t x = 0, uint32_t y = 0)
+    {
+        if (automaton_.program_.size() >= kMaxProgramSize)
+            ok_ = false;
+
+        automaton_.program_.push_back({op, x, y});
+
+        return pc() - 1;
+    }
+
+    void emit_alternate(const std::vector<node_ptr> &alternatives)
+    {
+        std::vector<uint32_t> jumps;
+
+        for (auto i = 0U; i < alternatives.size() && ok_; i++) {
+            if (i + 1 == alternatives.size()) {
+                emit_node(*alternatives[i]);
+                break;
+            }
+
+            const auto split = emit(op_t::kSplit, pc() + 1);
+            emit_node(*alternatives[i]);
+            jumps.push_back(emit(op_t::kJump));
+            automaton_.program_[split].y = pc();
+        }
+
+        for (const auto jump : jumps)
+            automaton_.program_[jump].x = pc();
+    }
+
+    void emit_repeat(const node &n)
+    {
+        const auto &child = *n.children.front();
+
+        for (auto i = 0U; i < n.min && ok_; i++)
+            emit_node(child);
+
+        if (n.max == kUnbounded) {
+            const auto split = emit(op_t::kSplit, pc() + 1);
+            emit_node(child);
+            emit(op_t::kJump, split);
+            automaton_.program_[split].y = pc();
+            return;
+        }
+
+        std::vector<uint32_t> splits;
+        for (auto i = n.min; i < n.max && ok_; i++) {
+            splits.push_back(emit(op_t::kSplit, pc() + 1));
+            emit_node(child);
+        }
+
+        for (const auto split : splits)
+            automaton_.program_[split].y = pc();
+    }
+
+    void emit_node(const node &n)
+    {
+        if (!ok_)
+            return;
+
+        switch (n.kind) {
+        case node::kind_t::kChar:
+            emit(op_t::kChar, n.ch);
+            break;
+        case node::kind_t::kClass:
+            automaton_.classes_.emplace_back(n.cls);
+            emit(op_t::kClass,
+                static_cast<uint32_t>(automaton_.classes_.size() - 1));
+            break;
+        case node::kind_t::kBegin:
+            emit(op_t::kAssertBegin);
+            break;
+        case node::kind_t::kEnd:
+            emit(op_t::kAssertEnd);
+            break;
+        case node::kind_t::kConcat:
+            for (const auto &child : n.children)
+                emit_node(*child);
+            break;
+        case node::kind_t::kAlternate:
+            emit_alternate(n.children);
+            break;
+        case node::kind_t::kRepeat:
+            emit_repeat(n);
+            break;
+        }
+    }
+
+    regex_automaton &automaton_;
+    bool ok_{true};
+};
+
+std::shared_ptr<const regex_automaton> regex_automaton::compile(
+    const std::vector<std::string> &patterns)
+{
+    std::vector<node_ptr> nodes;
+    nodes.reserve(patterns.size());
+
+    for (const auto &pattern : patterns) {
+        auto n = parser{pattern}.parse();
+        if (!n)
+            return {};
+
+        nodes.emplace_back(std::move(n));
+    }
+
+    auto result = std::make_shared<regex_automaton>();
+    if (!compiler{*result}.compile(nodes))
+        return {};
+
+    return result;
+}
+
+bool regex_automaton::match(std::string_view input) const
+{
+    return run(input, true);
+}
+
+bool regex_automaton::search(std::string_view input) const
+{
+    return run(input, false);
+}
+
+bool regex_automaton::run(std::string_view input, bool anchored) const
+{
+    auto &state = thread_simulation_state();
+    if (state.marks.size() < program_.size())
+        state.marks.resize(program_.size(), 0);
+
+    // Adds all instructions reachable from pc without consuming input
+    const auto add_thread = [this, &state, &input](std::vector<uint32_t> &list,
+                                uint32_t pc, std::size_t pos) {
+        state.stack.push_back(pc);
+
+        while (!state.stack.empty()) {
+            pc = state.stack.back();
+            state.stack.pop_back();
+
+            if (state.marks[pc] == state.generation)
+                continue;
+
+            state.marks[pc] = state.generation;
+
+            const auto &in = program_[pc];
+            switch (in.op) {
+            case op_t::kJump:
+                state.stack.push_back(in.x);
+                break;
+            case op_t::kSplit:
+                state.stack.push_back(in.y);
+                state.stack.push_back(in.x);
+                break;
+            case op_t::kAssertBegin:
+                if (pos == 0)
+                    state.stack.push_back(pc + 1);
+                break;
+            case op_t::kAssertEnd:
+                if (pos == input.size())
+                    state.stack.push_back(pc + 1);
+                break;
+            default:
+                list.push_back(pc);
+                break;
+            }
+        }
+    };
+
+    const auto has_match = [this](const std::vector<uint32_t> &list) {
+        return std::any_of(list.begin(), list.end(),
+            [this](auto pc) { return program_[pc].op == op_t::kMatch; });
+    };
+
+    state.current.clear();
+    state.generation++;
+    add_thread(state.current, 0, 0);
+
+    for (std::size_t pos = 0; pos < input.size(); pos++) {
+        if (!anchored && has_match(state.current))
+            return true;
+
+        if (anchored && state.current.empty())
+            return false;
+
+        const auto c = static_cast<unsigned char>(input[pos]);
+
+        state.next.clear();
+        state.generation++;
+
+        for (const auto pc : state.current) {
+            const auto &in = program_[pc];
+            if ((in.op == op_t::kChar && in.x == c) ||
+                (in.op == op_t::kClass && classes_[in.x].test(c)))
+                add_thread(state.next, pc + 1, pos + 1);
+        }
+
+        if (!anchored)
+            add_thread(state.next, 0, pos + 1);
+
+        std::swap(state.current, state.next);
+    }
+
+    return has_match(state.current);
+}
+
+} // namespace clanguml::util
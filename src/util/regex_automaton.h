@@ -0,0 +1,103 @@
+/**
+ * @file src/util/regex_automaton.h
+ *
+ * Copyright (c) 2021-2025 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <bitset>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace clanguml::util {
+
+/**
+ * @brief Regular expression matcher based on a finite automaton
+ *
+ * Patterns are compiled into a nondeterministic finite automaton, which is
+ * simulated over all its states at once, so matching an input of length n
+ * against an automaton with m states takes O(n * m) time, without the
+ * exponential backtracking of `std::regex`.
+ *
+ * Only a subset of the ECMAScript syntax is supported, i.e. literals, `.`,
+ * bracket expressions, `\d`, `\w`, `\s` (and their negations), groups,
+ * alternation, greedy and lazy quantifiers and `^`/`$` anchors. Patterns
+ * with other constructs (e.g. backreferences, lookahead or word boundaries)
+ * cannot be compiled, and have to be matched using `std::regex`.
+ *
+ * Several patterns can be compiled into a single automaton, which matches
+ * an input if any of the patterns matches it.
+ */
+class regex_automaton {
+public:
+    /**
+     * @brief Compile regular expression patterns into a single automaton
+     *
+     * @param patterns List of ECMAScript regular expression patterns
+     * @return Compiled automaton or nullptr, if any of the patterns is not
+     *         supported
+     */
+    static std::shared_ptr<const regex_automaton> compile(
+        const std::vector<std::string> &patterns);
+
+    /**
+     * @brief Check if any of the patterns matches the entire input
+     *
+     * Equivalent of `std::regex_match()`.
+     *
+     * @param input Input string
+     * @return True, if the input matches
+     */
+    bool match(std::string_view input) const;
+
+    /**
+     * @brief Check if any of the patterns matches a part of the input
+     *
+     * Equivalent of `std::regex_search()`.
+     *
+     * @param input Input string
+     * @return True, if any substring of the input matches
+     */
+    bool search(std::string_view input) const;
+
+private:
+    class compiler;
+
+    enum class op_t : uint8_t {
+        kChar,
+        kClass,
+        kSplit,
+        kJump,
+        kAssertBegin,
+        kAssertEnd,
+        kMatch
+    };
+
+    struct instruction {
+        op_t op;
+        uint32_t x{0}; // Character, class index or jump target
+        uint32_t y{0}; // Second jump target of kSplit
+    };
+
+    bool run(std::string_view input, bool anchored) const;
+
+    std::vector<instruction> program_;
+    std::vector<std::bitset<256>> classes_;
+};
+
+} // namespace clanguml::util
@@ -0,0 +1,73 @@
+/**
+ * @file src/util/string_pool.cc
+ *
+ * Copyright (c) 2021-2025 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "string_pool.h"
+
+#include <mutex>
+
+namespace clanguml::util {
+
+namespace {
+const std::string &empty_string()
+{
+    static const std::string empty;
+    return empty;
+}
+} // namespace
+
+string_pool &string_pool::instance()
+{
+    static string_pool pool;
+    return pool;
+}
+
+const std::string *string_pool::intern(const std::string &s)
+{
+    if (s.empty())
+        return &empty_string();
+
+    {
+        std::shared_lock<std::shared_mutex> l(mutex_);
+        if (auto it = strings_.find(s); it != strings_.end())
+            return &(*it);
+    }
+
+    std::unique_lock<std::shared_mutex> l(mutex_);
+
+    // std::unordered_set is node based, so pointers to its elements remain
+    // valid after rehashing
+    return &(*strings_.emplace(s).first);
+}
+
+std::size_t string_pool::size() const
+{
+    std::shared_lock<std::shared_mutex> l(mutex_);
+    return strings_.size();
+}
+
+interned_string::interned_string()
+    : value_{&empty_string()}
+{
+}
+
+interned_string::interned_string(const std::string &s)
+    : value_{string_pool::instance().intern(s)}
+{
+}
+
+} // namespace clanguml::util
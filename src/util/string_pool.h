@@ -0,0 +1,98 @@
+/**
+ * @file src/util/string_pool.h
+ *
+ * Copyright (c) 2021-2025 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <shared_mutex>
+#include <string>
+#include <unordered_set>
+
+namespace clanguml::util {
+
+/**
+ * @brief Thread-safe pool of interned strings
+ *
+ * Strings added to the pool are never removed, so references to them
+ * remain valid for the lifetime of the process. This allows diagram
+ * elements, relationships and messages to share a single copy of strings
+ * which are repeated many times across the model, such as source file paths.
+ */
+class string_pool {
+public:
+    /**
+     * @brief Get the process-wide string pool instance
+     *
+     * @return Reference to the string pool
+     */
+    static string_pool &instance();
+
+    /**
+     * @brief Return a pointer to the pooled copy of `s`
+     *
+     * @param s String to intern
+     * @return Pointer to a string with the same value, owned by the pool
+     */
+    const std::string *intern(const std::string &s);
+
+    /**
+     * @brief Number of unique strings in the pool
+     *
+     * @return Number of strings
+     */
+    std::size_t size() const;
+
+private:
+    mutable std::shared_mutex mutex_;
+    std::unordered_set<std::string> strings_;
+};
+
+/**
+ * @brief Lightweight handle to a string stored in the global string pool
+ *
+ * Interned strings with equal values share the same storage, so copying
+ * and comparing them is equivalent to copying and comparing a pointer.
+ */
+class interned_string {
+public:
+    interned_string();
+
+    explicit interned_string(const std::string &s);
+
+    /**
+     * @brief Get the interned string value
+     *
+     * @return Reference to the pooled string
+     */
+    const std::string &str() const { return *value_; }
+
+    bool empty() const { return value_->empty(); }
+
+    friend bool operator==(const interned_string &l, const interned_string &r)
+    {
+        return l.value_ == r.value_;
+    }
+
+    friend bool operator!=(const interned_string &l, const interned_string &r)
+    {
+        return l.value_ != r.value_;
+    }
+
+private:
+    const std::string *value_;
+};
+
+} // namespace clanguml::util
@@ -0,0 +1,162 @@
+/**
+ * @file src/util/trace.cc
+ *
+ * Copyright (c) 2021-2025 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "trace.h"
+
+#include "util/logging.h"
+
+#include <fstream>
+
+namespace clanguml::util {
+
+tracer &tracer::instance()
+{
+    static tracer t;
+    return t;
+}
+
+void tracer::enable(std::string output_path)
+{
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        output_path_ = std::move(output_path);
+        start_ = clock::now();
+        events_.clear();
+    }
+
+    enabled_ = true;
+}
+
+void tracer::disable()
+{
+    enabled_ = false;
+
+    std::lock_guard<std::mutex> l(mutex_);
+    output_path_.clear();
+    events_.clear();
+}
+
+void tracer::add_span(std::string_view category, std::string_view name,
+    clock::time_point start, clock::time_point end, args_t args)
+{
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+
+    const auto thread = thread_index();
+
+    std::lock_guard<std::mutex> l(mutex_);
+
+    events_.push_back({std::string{category}, std::string{name},
+        duration_cast<microseconds>(start - start_).count(),
+        duration_cast<microseconds>(end - start).count(), thread,
+        std::move(args)});
+}
+
+nlohmann::json tracer::to_json() const
+{
+    std::lock_guard<std::mutex> l(mutex_);
+
+    auto events = nlohmann::json::array();
+    for (const auto &e : events_) {
+        nlohmann::json event{{"name", e.name}, {"cat", e.category},
+            {"ph", "X"}, {"ts", e.start_us}, {"dur", e.duration_us},
+            {"pid", 1}, {"tid", e.thread}};
+
+        if (!e.args.empty()) {
+            auto &args = event["args"];
+            for (const auto &[key, value] : e.args)
+                args[key] = value;
+        }
+
+        events.emplace_back(std::move(event));
+    }
+
+    return {{"traceEvents", std::move(events)}, {"displayTimeUnit", "ms"}};
+}
+
+void tracer::write() const
+{
+    if (!enabled())
+        return;
+
+    std::string output_path;
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        output_path = output_path_;
+    }
+
+    // The tracer could have been disabled in the meantime
+    if (output_path.empty())
+        return;
+
+    std::ofstream ofs{output_path, std::ofstream::out | std::ofstream::trunc};
+    if (!ofs) {
+        LOG_ERROR("Failed to open trace output file {}", output_path);
+        return;
+    }
+
+    ofs << to_json().dump();
+
+    LOG_INFO("Written trace to {}", output_path);
+}
+
+uint32_t tracer::thread_index()
+{
+    static std::atomic<uint32_t> next_index{1};
+    thread_local const uint32_t index{next_index++};
+
+    return index;
+}
+
+trace_span::trace_span(const char *category, const char *name,
+    std::initializer_list<std::pair<const char *, std::string_view>> args)
+    : category_{category}
+    , name_{name}
+{
+    if (!tracer::instance().enabled())
+        return;
+
+    active_ = true;
+
+    args_.reserve(args.size());
+    for (const auto &[key, value] : args)
+        args_.emplace_back(key, value);
+
+    start_ = tracer::clock::now();
+}
+
+trace_span::~trace_span()
+{
+    if (!active_)
+        return;
+
+    tracer::instance().add_span(category_, name_, start_,
+        tracer::clock::now(), std::move(args_));
+}
+
+trace_writer::~trace_writer()
+{
+    try {
+        tracer::instance().write();
+    }
+    catch (const std::exception &e) {
+        LOG_ERROR("Failed to write trace: {}", e.what());
+    }
+}
+
+} // namespace clanguml::util
@@ -0,0 +1,165 @@
+/**
+ * @file src/util/trace.h
+ *
+ * Copyright (c) 2021-2025 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <initializer_list>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace clanguml::util {
+
+/**
+ * @brief Process-wide recorder of timed spans
+ *
+ * Spans are recorded per thread and written in the Chrome trace event
+ * format, which can be opened in `chrome://tracing` or Perfetto UI. Unless
+ * the tracer is enabled, spans are not recorded at all.
+ */
+class tracer {
+public:
+    using clock = std::chrono::steady_clock;
+    using args_t = std::vector<std::pair<std::string, std::string>>;
+
+    /**
+     * @brief Get the process-wide tracer instance
+     *
+     * @return Reference to the tracer
+     */
+    static tracer &instance();
+
+    /**
+     * @brief Start recording spans
+     *
+     * @param output_path Path of the file, where the trace will be written
+     */
+    void enable(std::string output_path);
+
+    /**
+     * @brief Stop recording spans and drop the recorded ones
+     */
+    void disable();
+
+    /**
+     * @brief Whether spans are recorded
+     *
+     * @return True, if the tracer is enabled
+     */
+    bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Record a complete span
+     *
+     * @param category Span category
+     * @param name Span name
+     * @param start Start time of the span
+     * @param end End time of the span
+     * @param args Additional span arguments (e.g. diagram name)
+     */
+    void add_span(std::string_view category, std::string_view name,
+        clock::time_point start, clock::time_point end, args_t args);
+
+    /**
+     * @brief Convert recorded spans to Chrome trace event format
+     *
+     * @return JSON object with the trace
+     */
+    nlohmann::json to_json() const;
+
+    /**
+     * @brief Write recorded spans to the output path, if enabled
+     */
+    void write() const;
+
+private:
+    struct event {
+        std::string category;
+        std::string name;
+        int64_t start_us{0};
+        int64_t duration_us{0};
+        uint32_t thread{0};
+        args_t args;
+    };
+
+    static uint32_t thread_index();
+
+    std::atomic<bool> enabled_{false};
+    std::string output_path_;
+    clock::time_point start_;
+
+    mutable std::mutex mutex_;
+    std::vector<event> events_;
+};
+
+/**
+ * @brief Span recorded by @ref tracer from construction to destruction
+ *
+ * If the tracer is not enabled, the span only checks a flag.
+ */
+class trace_span {
+public:
+    /**
+     * @brief Start a span
+     *
+     * @param category Span category
+     * @param name Span name
+     * @param args Additional span arguments, copied only if the tracer is
+     *             enabled
+     */
+    trace_span(const char *category, const char *name,
+        std::initializer_list<std::pair<const char *, std::string_view>> args =
+            {});
+
+    trace_span(const trace_span &) = delete;
+    trace_span(trace_span &&) = delete;
+    trace_span &operator=(const trace_span &) = delete;
+    trace_span &operator=(trace_span &&) = delete;
+
+    ~trace_span();
+
+private:
+    const char *category_;
+    const char *name_;
+    bool active_{false};
+    tracer::clock::time_point start_;
+    tracer::args_t args_;
+};
+
+/**
+ * @brief Writes the trace when leaving the scope, also on error
+ */
+class trace_writer {
+public:
+    trace_writer() = default;
+
+    trace_writer(const trace_writer &) = delete;
+    trace_writer(trace_writer &&) = delete;
+    trace_writer &operator=(const trace_writer &) = delete;
+    trace_writer &operator=(trace_writer &&) = delete;
+
+    ~trace_writer();
+};
+
+} // namespace clanguml::util
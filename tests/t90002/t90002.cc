@@ -0,0 +1,52 @@
+#include "t90002.h"
+
+namespace clanguml {
+namespace t90002 {
+namespace ns3 {
+
+class C {
+public:
+    C() = default;
+
+    void add(ns2::B *b)
+    {
+        if (b != nullptr)
+            bs_.push_back(b);
+    }
+
+    int sum() const
+    {
+        int result{0};
+        for (const auto *b : bs_)
+            result += ns1::square(*b);
+        return result;
+    }
+
+    ns1::Box<ns1::A> box() const { return {}; }
+
+private:
+    std::vector<ns2::B *> bs_;
+    ns1::Box<std::vector<int>> values_;
+    std::map<std::string, ns1::Color> colors_;
+};
+
+struct D : public C {
+    ns1::Box<ns2::B> *b{nullptr};
+
+    auto count() const { return b != nullptr ? 1 : 0; }
+
+    constexpr int value() const { return 42; }
+};
+
+int run(D &d)
+{
+    ns2::B b;
+    b.set(ns1::A{});
+    d.add(&b);
+
+    return d.sum() + d.count() + d.value();
+}
+
+} // namespace ns3
+} // namespace t90002
+} // namespace clanguml
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace clanguml {
+namespace t90002 {
+namespace ns1 {
+
+enum class Color { red, green, blue };
+
+struct A {
+    int a{};
+
+    int get() const { return a; }
+};
+
+template <typename T> struct Box {
+    T value;
+
+    const T &get() const { return value; }
+};
+
+template <typename T> struct Box<std::vector<T>> {
+    std::vector<T> values;
+
+    std::size_t size() const
+    {
+        std::size_t result{0};
+        for (const auto &v : values) {
+            (void)v;
+            result++;
+        }
+        return result;
+    }
+};
+
+inline int square(const A &a)
+{
+    Box<A> box{a};
+    return box.get().get() * box.get().get();
+}
+
+} // namespace ns1
+
+namespace ns2 {
+
+class B : public ns1::A {
+public:
+    void set(const ns1::A &a) { a_ = std::make_unique<ns1::A>(a); }
+
+    ns1::Color color() const
+    {
+        if (a_ && a_->get() > 0)
+            return ns1::Color::green;
+        return ns1::Color::red;
+    }
+
+private:
+    std::unique_ptr<ns1::A> a_;
+};
+
+} // namespace ns2
+} // namespace t90002
+} // namespace clanguml
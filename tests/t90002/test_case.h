@@ -0,0 +1,97 @@
+/**
+ * tests/t90002/test_case.h
+ *
+ * Copyright (c) 2021-2025 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+TEST_CASE("t90002")
+{
+    using namespace clanguml::test;
+    using clanguml::config::skip_function_bodies_t;
+
+    auto [cfg, db] = load_config("t90002");
+
+    const auto &config = *cfg;
+
+    // Diagrams generated with function bodies skipped must be identical
+    // to the diagrams generated from complete translation units
+    auto generate_class_json = [&db = db](auto diagram) {
+        auto model = generate_class_diagram(*db, diagram);
+        return render_class_diagram<json_t>(diagram, *model).src;
+    };
+
+    auto generate_package_json = [&db = db](auto diagram) {
+        auto model = generate_package_diagram(*db, diagram);
+        return render_package_diagram<json_t>(diagram, *model).src;
+    };
+
+    auto generate_include_json = [&db = db](auto diagram) {
+        auto model = generate_include_diagram(*db, diagram);
+        return render_include_diagram<json_t>(diagram, *model).src;
+    };
+
+    {
+        auto diagram = config.diagrams.at("t90002_class");
+
+        REQUIRE(diagram->function_bodies_to_skip() ==
+            skip_function_bodies_t::never);
+
+        const auto expected = generate_class_json(diagram);
+
+        REQUIRE(expected["elements"].size() > 0);
+        REQUIRE(expected["relationships"].size() > 0);
+
+        diagram->skip_function_bodies.set(
+            skip_function_bodies_t::outside_main_file);
+        CHECK(generate_class_json(diagram) == expected);
+
+        diagram->skip_function_bodies.set(skip_function_bodies_t::always);
+        CHECK(generate_class_json(diagram) == expected);
+    }
+
+    {
+        auto diagram = config.diagrams.at("t90002_package");
+
+        REQUIRE(diagram->function_bodies_to_skip() ==
+            skip_function_bodies_t::never);
+
+        const auto expected = generate_package_json(diagram);
+
+        REQUIRE(expected["elements"].size() > 0);
+        REQUIRE(expected["relationships"].size() > 0);
+
+        diagram->skip_function_bodies.set(
+            skip_function_bodies_t::outside_main_file);
+        CHECK(generate_package_json(diagram) == expected);
+
+        diagram->skip_function_bodies.set(skip_function_bodies_t::always);
+        CHECK(generate_package_json(diagram) == expected);
+    }
+
+    {
+        auto diagram = config.diagrams.at("t90002_include");
+
+        // Include diagrams skip function bodies by default
+        REQUIRE(diagram->function_bodies_to_skip() ==
+            skip_function_bodies_t::always);
+
+        const auto expected = generate_include_json(diagram);
+
+        REQUIRE(expected["elements"].size() > 0);
+
+        diagram->skip_function_bodies.set(skip_function_bodies_t::never);
+        CHECK(generate_include_json(diagram) == expected);
+    }
+}
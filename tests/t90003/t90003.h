@@ -0,0 +1,47 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace clanguml {
+namespace t90003 {
+
+struct Item {
+    std::string name;
+    int value{};
+};
+
+template <typename T> class Registry {
+public:
+    void add(const std::string &key, T item)
+    {
+        items_.emplace(key, std::move(item));
+    }
+
+    std::size_t size() const { return items_.size(); }
+
+private:
+    std::map<std::string, T> items_;
+};
+
+class Producer {
+public:
+    std::vector<Item> produce(int count) const;
+};
+
+class Consumer {
+public:
+    int consume(const std::vector<Item> &items);
+
+    const Registry<Item> &registry() const { return registry_; }
+
+private:
+    Registry<Item> registry_;
+};
+
+int tmain();
+
+} // namespace t90003
+} // namespace clanguml
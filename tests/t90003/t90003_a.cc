@@ -0,0 +1,25 @@
+#include "t90003.h"
+
+namespace clanguml {
+namespace t90003 {
+
+std::vector<Item> Producer::produce(int count) const
+{
+    std::vector<Item> result;
+    for (int i = 0; i < count; i++)
+        result.push_back({std::to_string(i), i});
+    return result;
+}
+
+int Consumer::consume(const std::vector<Item> &items)
+{
+    int result{0};
+    for (const auto &item : items) {
+        registry_.add(item.name, item);
+        result += item.value;
+    }
+    return result;
+}
+
+} // namespace t90003
+} // namespace clanguml
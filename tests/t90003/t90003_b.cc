@@ -0,0 +1,19 @@
+#include "t90003.h"
+
+namespace clanguml {
+namespace t90003 {
+
+struct Pipeline {
+    Producer producer;
+    std::unique_ptr<Consumer> consumer;
+};
+
+int tmain()
+{
+    Pipeline pipeline{Producer{}, std::make_unique<Consumer>()};
+
+    return pipeline.consumer->consume(pipeline.producer.produce(3));
+}
+
+} // namespace t90003
+} // namespace clanguml
@@ -0,0 +1,70 @@
+/**
+ * tests/t90003/test_case.h
+ *
+ * Copyright (c) 2021-2025 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+TEST_CASE("t90003")
+{
+    using namespace clanguml::test;
+    using clanguml::generators::preamble_cache;
+
+    auto [cfg, db] = load_config("t90003");
+
+    const auto &config = *cfg;
+
+    // Diagrams generated with precompiled preambles must be identical
+    // to the diagrams generated by parsing complete translation units
+    auto generate_class_json = [&db = db](auto diagram) {
+        auto model = generate_class_diagram(*db, diagram);
+        return render_class_diagram<json_t>(diagram, *model).src;
+    };
+
+    auto generate_sequence_json = [&db = db](auto diagram) {
+        auto model = generate_sequence_diagram(*db, diagram);
+        return render_sequence_diagram<json_t>(diagram, *model).src;
+    };
+
+    auto &preambles = preamble_cache::instance();
+
+    REQUIRE(!preambles.enabled());
+
+    auto class_diagram = config.diagrams.at("t90003_class");
+    auto sequence_diagram = config.diagrams.at("t90003_sequence");
+
+    const auto expected_class = generate_class_json(class_diagram);
+    const auto expected_sequence = generate_sequence_json(sequence_diagram);
+
+    REQUIRE(expected_class["elements"].size() > 0);
+    REQUIRE(expected_class["relationships"].size() > 0);
+    REQUIRE(expected_sequence["sequences"].size() > 0);
+
+    const auto stats_before = preambles.stats();
+
+    preambles.enable();
+    const auto class_json = generate_class_json(class_diagram);
+    const auto sequence_json = generate_sequence_json(sequence_diagram);
+    preambles.disable();
+
+    const auto stats = preambles.stats();
+
+    CHECK(class_json == expected_class);
+    CHECK(sequence_json == expected_sequence);
+
+    // Both translation units start with the same include, so the preamble
+    // is built once and then reused by the other translation unit
+    CHECK(stats.built > stats_before.built);
+    CHECK(stats.reused > stats_before.reused);
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace clanguml {
+namespace t90004 {
+namespace ns1 {
+
+class Base {
+public:
+    virtual ~Base() = default;
+
+    virtual int get() const = 0;
+};
+
+} // namespace ns1
+
+namespace ns2 {
+
+template <typename T> struct Holder {
+    std::vector<std::unique_ptr<T>> items;
+};
+
+} // namespace ns2
+} // namespace t90004
+} // namespace clanguml
@@ -0,0 +1,23 @@
+#include "t90004.h"
+
+namespace clanguml {
+namespace t90004 {
+namespace {
+struct Helper {
+    int value{};
+};
+} // namespace
+
+namespace ns1 {
+
+class A : public Base {
+public:
+    int get() const override { return helper_.value; }
+
+private:
+    Helper helper_;
+};
+
+} // namespace ns1
+} // namespace t90004
+} // namespace clanguml
@@ -0,0 +1,25 @@
+#include "t90004.h"
+
+namespace clanguml {
+namespace t90004 {
+namespace {
+// Conflicts with Helper from t90004_a.cc when both files are included in
+// the same unity translation unit
+struct Helper {
+    double value{};
+};
+} // namespace
+
+namespace ns1 {
+
+class B : public Base {
+public:
+    int get() const override { return static_cast<int>(helper_.value); }
+
+private:
+    Helper helper_;
+};
+
+} // namespace ns1
+} // namespace t90004
+} // namespace clanguml
@@ -0,0 +1,24 @@
+#include "t90004.h"
+
+namespace clanguml {
+namespace t90004 {
+namespace ns2 {
+
+class C {
+public:
+    int sum() const
+    {
+        int result{0};
+        for (const auto &item : bases_.items)
+            result += item->get();
+        return result;
+    }
+
+private:
+    Holder<ns1::Base> bases_;
+    std::string name_;
+};
+
+} // namespace ns2
+} // namespace t90004
+} // namespace clanguml
@@ -0,0 +1,16 @@
+#include "t90004.h"
+
+namespace clanguml {
+namespace t90004 {
+namespace ns2 {
+
+struct D : public ns1::Base {
+    int get() const override { return value; }
+
+    int value{};
+    Holder<D> children;
+};
+
+} // namespace ns2
+} // namespace t90004
+} // namespace clanguml
@@ -0,0 +1,75 @@
+/**
+ * tests/t90004/test_case.h
+ *
+ * Copyright (c) 2021-2025 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+TEST_CASE("t90004")
+{
+    using namespace clanguml::test;
+
+    auto [cfg, db] = load_config("t90004");
+
+    const auto &config = *cfg;
+
+    // Diagrams generated from unity translation units must be identical
+    // to the diagrams generated from separate translation units, also when
+    // a unity translation unit fails to compile and its files are parsed
+    // separately
+    auto generate_class_json = [&db = db](auto diagram) {
+        auto model = generate_class_diagram(*db, diagram);
+        return render_class_diagram<json_t>(diagram, *model).src;
+    };
+
+    auto generate_package_json = [&db = db](auto diagram) {
+        auto model = generate_package_diagram(*db, diagram);
+        return render_package_diagram<json_t>(diagram, *model).src;
+    };
+
+    {
+        auto diagram = config.diagrams.at("t90004_class");
+
+        REQUIRE(diagram->unity_batch_size() == 0);
+
+        const auto expected = generate_class_json(diagram);
+
+        REQUIRE(expected["elements"].size() > 0);
+        REQUIRE(expected["relationships"].size() > 0);
+
+        // t90004_a.cc and t90004_b.cc conflict in the first batch, which
+        // falls back to separate translation units
+        diagram->unity_batch_size.set(2);
+        CHECK(generate_class_json(diagram) == expected);
+
+        diagram->unity_batch_size.set(4);
+        CHECK(generate_class_json(diagram) == expected);
+    }
+
+    {
+        auto diagram = config.diagrams.at("t90004_package");
+
+        REQUIRE(diagram->unity_batch_size() == 0);
+
+        const auto expected = generate_package_json(diagram);
+
+        REQUIRE(expected["elements"].size() > 0);
+
+        diagram->unity_batch_size.set(2);
+        CHECK(generate_package_json(diagram) == expected);
+
+        diagram->unity_batch_size.set(4);
+        CHECK(generate_package_json(diagram) == expected);
+    }
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace clanguml {
+namespace t90005 {
+
+struct A {
+    int a{};
+};
+
+enum class Kind { first, second };
+
+template <typename T> struct Box {
+    T value;
+};
+
+template <typename K, typename V> struct Pair {
+    K key;
+    V value;
+};
+
+} // namespace t90005
+} // namespace clanguml
@@ -0,0 +1,17 @@
+#include "t90005.h"
+
+namespace clanguml {
+namespace t90005 {
+
+// Template instantiations used by P1 are processed first and stored in the
+// template instantiation cache, some of them after P1 already has the
+// relationships which they add
+struct P1 {
+    std::list<Box<A>> list;
+    std::vector<Box<A>> vector;
+    Pair<A, Kind> pair;
+    std::map<std::string, Pair<A, Kind>> map;
+};
+
+} // namespace t90005
+} // namespace clanguml
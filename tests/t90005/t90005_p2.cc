@@ -0,0 +1,15 @@
+#include "t90005.h"
+
+namespace clanguml {
+namespace t90005 {
+
+// The same template instantiations used by P2 are reused from the template
+// instantiation cache
+struct P2 {
+    std::vector<Box<A>> vector;
+    std::map<std::string, Pair<A, Kind>> map;
+    Pair<A, Kind> pair;
+};
+
+} // namespace t90005
+} // namespace clanguml
@@ -0,0 +1,82 @@
+/**
+ * tests/t90005/test_case.h
+ *
+ * Copyright (c) 2021-2025 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+TEST_CASE("t90005")
+{
+    using namespace clanguml::test;
+
+    auto [cfg, db] = load_config("t90005");
+
+    const auto &config = *cfg;
+
+    auto generate_class_json = [&db = db](auto diagram) {
+        auto model = generate_class_diagram(*db, diagram);
+        return render_class_diagram<json_t>(diagram, *model).src;
+    };
+
+    auto find_id = [](const nlohmann::json &j, const std::string &name) {
+        for (const auto &e : j["elements"]) {
+            if (e["name"] == name)
+                return e["id"].get<std::string>();
+        }
+        return std::string{};
+    };
+
+    auto relationships_from = [](const nlohmann::json &j,
+                                  const std::string &id) {
+        std::vector<nlohmann::json> result;
+        for (const auto &r : j["relationships"]) {
+            if (r["source"] == id)
+                result.push_back(r);
+        }
+        return result;
+    };
+
+    // In the diagram generated from both translation units, template
+    // instantiations used by P2 are reused from the template instantiation
+    // cache. The result must be the same as in the diagrams generated from
+    // a single translation unit, where nothing is reused.
+    const auto both = generate_class_json(config.diagrams.at("t90005_class"));
+
+    for (const auto &[diagram_name, parent_name] :
+        std::vector<std::pair<std::string, std::string>>{
+            {"t90005_class_p1", "P1"}, {"t90005_class_p2", "P2"}}) {
+        const auto single =
+            generate_class_json(config.diagrams.at(diagram_name));
+
+        const auto parent_id = find_id(single, parent_name);
+        REQUIRE(!parent_id.empty());
+        REQUIRE(find_id(both, parent_name) == parent_id);
+
+        REQUIRE(!relationships_from(single, parent_id).empty());
+        CHECK(relationships_from(both, parent_id) ==
+            relationships_from(single, parent_id));
+
+        // Template instantiations can have more relationships in the
+        // diagram generated from both translation units, but none of the
+        // relationships found in a single translation unit can be missing
+        for (const auto &e : single["elements"]) {
+            const auto id = e["id"].get<std::string>();
+            const auto relationships = relationships_from(both, id);
+            for (const auto &r : relationships_from(single, id)) {
+                CHECK(std::find(relationships.begin(), relationships.end(),
+                          r) != relationships.end());
+            }
+        }
+    }
+}
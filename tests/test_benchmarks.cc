@@ -16,14 +16,23 @@
  * limitations under the License.
  */
 
+#include "common/types.h"
+#include "common/visitor/ast_id_mapper.h"
+#include "sequence_diagram/visitor/call_expression_context.h"
 #include "util/util.h"
 
+#include <clang/Tooling/Tooling.h>
+
 #define ANKERL_NANOBENCH_IMPLEMENT
 #include <nanobench/nanobench.h>
 
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include <doctest/doctest.h>
 
+#include <map>
+#include <stack>
+#include <type_traits>
+
 TEST_CASE("nanobench clanguml::util::is_relative_to")
 {
     using std::filesystem::path;
@@ -37,4 +46,296 @@ TEST_CASE("nanobench clanguml::util::is_relative_to")
 
     ankerl::nanobench::Bench().run(
         "is_relative_to negative", [&] { is_relative_to(child, base2); });
-}
\ No newline at end of file
+}
+
+TEST_CASE("nanobench clanguml::common::regex_set")
+{
+    using clanguml::common::regex;
+    using clanguml::common::regex_set;
+
+    // Typical namespace filter patterns matched against long qualified names
+    std::vector<regex> patterns;
+    for (auto i = 0; i < 20; i++) {
+        auto pattern = fmt::format("ns{}::(detail|impl)::.*::type_{}.*", i, i);
+        patterns.emplace_back(std::regex{pattern}, pattern);
+    }
+
+    const std::string infix{"::detail::some_template<std::vector<int>>::"};
+    std::vector<std::string> names;
+    for (auto i = 0; i < 1000; i++)
+        names.emplace_back(fmt::format("ns{}{}type_{}", i % 40, infix, i % 25));
+
+    regex_set regexes;
+    for (const auto &r : patterns)
+        regexes.add(r);
+    regexes.compile();
+
+    ankerl::nanobench::Bench bench;
+    bench.minEpochIterations(10);
+
+    bench.run("std::regex filter patterns", [&] {
+        for (const auto &name : names) {
+            ankerl::nanobench::doNotOptimizeAway(
+                std::any_of(patterns.begin(), patterns.end(),
+                    [&name](const auto &r) {
+                        return std::regex_match(name, r.regexp);
+                    }));
+        }
+    });
+
+    bench.run("regex_set filter patterns", [&] {
+        for (const auto &name : names)
+            ankerl::nanobench::doNotOptimizeAway(regexes %= name);
+    });
+
+    for (const auto &name : names) {
+        CHECK((regexes %= name) ==
+            std::any_of(patterns.begin(), patterns.end(),
+                [&name](const auto &r) {
+                    return std::regex_match(name, r.regexp);
+                }));
+    }
+}
+
+TEST_CASE("nanobench clanguml::common::visitor::ast_id_mapper")
+{
+    using clanguml::common::eid_t;
+    using clanguml::common::visitor::ast_id_mapper;
+
+    // Synthetic translation unit with 100k declarations, where Clang AST
+    // ids are increasing but sparse and global ids are name hashes
+    constexpr int64_t kDeclarationCount{100'000};
+    constexpr int64_t kAstIdStride{37};
+
+    std::vector<std::pair<int64_t, eid_t>> declarations;
+    declarations.reserve(kDeclarationCount);
+    for (int64_t i = 0; i < kDeclarationCount; i++) {
+        declarations.emplace_back(i * kAstIdStride,
+            eid_t{static_cast<uint64_t>(
+                std::hash<std::string>{}(std::to_string(i)))});
+    }
+
+    ankerl::nanobench::Bench bench;
+    bench.minEpochIterations(10);
+
+    bench.run("std::map id mapping", [&] {
+        std::map<int64_t, eid_t> id_map;
+        for (const auto &[ast_id, global_id] : declarations)
+            id_map[ast_id] = global_id;
+
+        for (const auto &[ast_id, global_id] : declarations) {
+            eid_t local_id{ast_id};
+            if (id_map.count(local_id.ast_local_value()) > 0)
+                ankerl::nanobench::doNotOptimizeAway(
+                    id_map.at(local_id.ast_local_value()));
+        }
+    });
+
+    bench.run("ast_id_mapper id mapping", [&] {
+        ast_id_mapper id_mapper;
+        for (const auto &[ast_id, global_id] : declarations)
+            id_mapper.add(ast_id, global_id);
+
+        for (const auto &[ast_id, global_id] : declarations) {
+            ankerl::nanobench::doNotOptimizeAway(
+                id_mapper.resolve_or(eid_t{ast_id}));
+        }
+    });
+
+    ast_id_mapper id_mapper;
+    for (const auto &[ast_id, global_id] : declarations)
+        id_mapper.add(ast_id, global_id);
+
+    CHECK(id_mapper.size() == declarations.size());
+    CHECK(id_mapper.resolve_or(eid_t{kAstIdStride}) == declarations[1].second);
+}
+
+namespace {
+/**
+ * @brief Replica of the call expression context layout used before
+ *        declaration scopes, i.e. with deque-backed stacks and a map of
+ *        `else if` stacks, which was copied on each traversed declaration
+ */
+struct copied_call_expression_context {
+    using callexpr_stack_t = clanguml::sequence_diagram::visitor::
+        call_expression_context::callexpr_stack_t;
+
+    void reset()
+    {
+        current_class_decl_ = nullptr;
+        current_class_template_decl_ = nullptr;
+        current_class_template_specialization_decl_ = nullptr;
+        current_method_decl_ = nullptr;
+        current_objc_method_decl_ = nullptr;
+        current_function_decl_ = nullptr;
+        current_function_template_decl_ = nullptr;
+        objc_interface_decl_ = nullptr;
+        objc_protocol_decl_ = nullptr;
+    }
+
+    void update(clang::FunctionDecl *function)
+    {
+        if (!function->isCXXClassMember())
+            reset();
+
+        current_function_decl_ = function;
+    }
+
+    clanguml::common::eid_t caller_id() const { return current_caller_id_; }
+
+    clang::IfStmt *current_ifstmt() const
+    {
+        if (if_stmt_stack_.empty())
+            return nullptr;
+
+        return if_stmt_stack_.top();
+    }
+
+    void enter_ifstmt(clang::IfStmt *stmt) { if_stmt_stack_.emplace(stmt); }
+
+    void leave_ifstmt()
+    {
+        if (!if_stmt_stack_.empty()) {
+            elseif_stmt_stacks_.erase(current_ifstmt());
+            if_stmt_stack_.pop();
+        }
+    }
+
+    void enter_callexpr(clang::CallExpr *expr)
+    {
+        call_expr_stack_.emplace(expr);
+    }
+
+    void leave_callexpr()
+    {
+        if (!call_expr_stack_.empty())
+            call_expr_stack_.pop();
+    }
+
+    clang::CXXRecordDecl *current_class_decl_{nullptr};
+    clang::ClassTemplateDecl *current_class_template_decl_{nullptr};
+    clang::ClassTemplateSpecializationDecl
+        *current_class_template_specialization_decl_{nullptr};
+    clang::CXXMethodDecl *current_method_decl_{nullptr};
+    clang::ObjCMethodDecl *current_objc_method_decl_{nullptr};
+    clang::FunctionDecl *current_function_decl_{nullptr};
+    clang::FunctionTemplateDecl *current_function_template_decl_{nullptr};
+    clang::ObjCInterfaceDecl *objc_interface_decl_{nullptr};
+    clang::ObjCProtocolDecl *objc_protocol_decl_{nullptr};
+
+    clanguml::common::eid_t current_caller_id_{};
+    std::stack<clanguml::common::eid_t> current_lambda_caller_id_;
+
+    std::stack<callexpr_stack_t> call_expr_stack_;
+
+    std::stack<clang::IfStmt *> if_stmt_stack_;
+    std::map<clang::IfStmt *, std::stack<clang::IfStmt *>> elseif_stmt_stacks_;
+
+    std::stack<clang::Stmt *> loop_stmt_stack_;
+    std::stack<clang::Stmt *> try_stmt_stack_;
+    std::stack<clang::SwitchStmt *> switch_stmt_stack_;
+    std::stack<clang::ConditionalOperator *> conditional_operator_stack_;
+};
+
+/**
+ * @brief Minimal visitor, which maintains call expression context the same
+ *        way as the sequence diagram translation unit visitor
+ *
+ * With `UseScopes` the context is saved and restored using scopes, otherwise
+ * the previous context layout is copied and restored on each function.
+ */
+template <bool UseScopes>
+class call_expression_context_visitor
+    : public clang::RecursiveASTVisitor<
+          call_expression_context_visitor<UseScopes>> {
+public:
+    using base_t =
+        clang::RecursiveASTVisitor<call_expression_context_visitor<UseScopes>>;
+    using context_t = std::conditional_t<UseScopes,
+        clanguml::sequence_diagram::visitor::call_expression_context,
+        copied_call_expression_context>;
+
+    bool TraverseFunctionDecl(clang::FunctionDecl *declaration)
+    {
+        if constexpr (UseScopes) {
+            context_.push_scope();
+            base_t::TraverseFunctionDecl(declaration);
+            context_.pop_scope();
+        }
+        else {
+            auto context_backup = context_;
+            base_t::TraverseFunctionDecl(declaration);
+            context_ = context_backup;
+        }
+
+        return true;
+    }
+
+    bool VisitFunctionDecl(clang::FunctionDecl *declaration)
+    {
+        context_.update(declaration);
+        return true;
+    }
+
+    bool TraverseIfStmt(clang::IfStmt *stmt)
+    {
+        context_.enter_ifstmt(stmt);
+        base_t::TraverseIfStmt(stmt);
+        context_.leave_ifstmt();
+        return true;
+    }
+
+    bool TraverseCallExpr(clang::CallExpr *expr)
+    {
+        context_.enter_callexpr(expr);
+        base_t::TraverseCallExpr(expr);
+        context_.leave_callexpr();
+        return true;
+    }
+
+    context_t context_;
+};
+} // namespace
+
+TEST_CASE("nanobench clanguml::sequence_diagram::visitor::"
+          "call_expression_context")
+{
+    using clanguml::sequence_diagram::visitor::call_expression_context;
+
+    // Synthetic translation unit with 100k small functions, each calling
+    // the previous one inside an if statement
+    constexpr int kFunctionCount{100'000};
+
+    std::string code{"int f0(int a) { return a; }\n"};
+    for (int i = 1; i < kFunctionCount; i++) {
+        code += fmt::format(
+            "int f{}(int a) {{ if (a > 0) return f{}(a - 1); return a; }}\n",
+            i, i - 1);
+    }
+
+    auto ast = clang::tooling::buildASTFromCode(code);
+    REQUIRE(ast);
+
+    auto *tu = ast->getASTContext().getTranslationUnitDecl();
+
+    ankerl::nanobench::Bench bench;
+    bench.minEpochIterations(2);
+
+    bench.run("call_expression_context copy (deque/map layout)", [&] {
+        call_expression_context_visitor<false> visitor;
+        visitor.TraverseDecl(tu);
+        ankerl::nanobench::doNotOptimizeAway(visitor.context_.caller_id());
+    });
+
+    bench.run("call_expression_context scope on function traversal", [&] {
+        call_expression_context_visitor<true> visitor;
+        visitor.TraverseDecl(tu);
+        ankerl::nanobench::doNotOptimizeAway(visitor.context_.caller_id());
+    });
+
+    call_expression_context_visitor<true> visitor;
+    visitor.TraverseDecl(tu);
+
+    CHECK(visitor.context_.current_ifstmt() == nullptr);
+    CHECK(visitor.context_.current_function_decl_ == nullptr);
+}
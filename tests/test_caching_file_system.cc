@@ -0,0 +1,168 @@
+/**
+ * @file tests/test_caching_file_system.cc
+ *
+ * Copyright (c) 2021-2025 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "doctest/doctest.h"
+
+#include "common/generators/caching_file_system.h"
+
+#include <filesystem>
+#include <fstream>
+
+using clanguml::generators::caching_file_system;
+using clanguml::generators::file_system_cache;
+
+namespace {
+void write_file(const std::filesystem::path &path, const std::string &contents)
+{
+    std::ofstream ofs{path};
+    ofs << contents;
+}
+
+std::string read_file(llvm::vfs::FileSystem &fs, const std::string &path)
+{
+    auto file = fs.openFileForRead(path);
+    REQUIRE(file);
+
+    auto buffer = (*file)->getBuffer(path);
+    REQUIRE(buffer);
+
+    return (*buffer)->getBuffer().str();
+}
+
+llvm::IntrusiveRefCntPtr<caching_file_system> make_caching_fs(
+    file_system_cache &cache)
+{
+    return llvm::IntrusiveRefCntPtr<caching_file_system>(
+        new caching_file_system(llvm::vfs::createPhysicalFileSystem(), cache));
+}
+} // namespace
+
+TEST_CASE("Test caching_file_system")
+{
+    const auto dir = std::filesystem::temp_directory_path() /
+        "clang-uml-test-caching-file-system";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+
+    const auto header = (dir / "a.h").string();
+    const auto missing = (dir / "b.h").string();
+
+    write_file(header, "struct A {};");
+
+    SUBCASE("File contents are shared between file systems")
+    {
+        file_system_cache cache;
+
+        auto fs1 = make_caching_fs(cache);
+        auto fs2 = make_caching_fs(cache);
+
+        CHECK(read_file(*fs1, header) == "struct A {};");
+
+        // Source files are assumed not to change during a single run
+        write_file(header, "struct B {};");
+
+        CHECK(read_file(*fs2, header) == "struct A {};");
+
+        const auto stats = cache.stats();
+        CHECK(stats.contents_count == 1);
+        CHECK(stats.contents_size == 12);
+        CHECK(stats.contents_hits == 1);
+        CHECK(stats.contents_misses == 1);
+
+        // Status of opened file is also cached
+        auto status = fs2->status(header);
+        REQUIRE(status);
+        CHECK(status->getSize() == 12);
+        CHECK(status->getName() == header);
+        CHECK(cache.stats().status_hits == 1);
+    }
+
+    SUBCASE("Relative and absolute paths share cache entries")
+    {
+        file_system_cache cache;
+
+        auto fs = make_caching_fs(cache);
+        REQUIRE_FALSE(fs->setCurrentWorkingDirectory(dir.string()));
+
+        CHECK(fs->status("./a.h"));
+        CHECK(fs->status(header));
+        CHECK(cache.stats().status_misses == 1);
+        CHECK(cache.stats().status_hits == 1);
+    }
+
+    SUBCASE("Missing files are cached")
+    {
+        file_system_cache cache;
+
+        auto fs = make_caching_fs(cache);
+
+        CHECK(fs->status(missing).getError() ==
+            std::make_error_code(std::errc::no_such_file_or_directory));
+
+        write_file(missing, "struct B {};");
+
+        CHECK_FALSE(fs->status(missing));
+        CHECK(cache.stats().status_hits == 1);
+    }
+
+    SUBCASE("File contents are not cached above size limit")
+    {
+        file_system_cache cache;
+        cache.set_size_limit(0);
+
+        auto fs = make_caching_fs(cache);
+
+        CHECK(read_file(*fs, header) == "struct A {};");
+        CHECK(read_file(*fs, header) == "struct A {};");
+
+        CHECK(cache.stats().contents_count == 0);
+        CHECK(cache.stats().contents_size == 0);
+    }
+
+    SUBCASE("Reserved contents do not exceed size limit")
+    {
+        file_system_cache cache;
+        cache.set_size_limit(20);
+
+        CHECK(cache.reserve_contents(12));
+        CHECK_FALSE(cache.reserve_contents(12));
+        CHECK(cache.stats().contents_size == 12);
+
+        cache.release_contents(12);
+        CHECK(cache.stats().contents_size == 0);
+
+        cache.set_size_limit(file_system_cache::kNoLimit);
+        CHECK(cache.reserve_contents(12));
+
+        // Another reader added the same file in the meantime
+        auto fs = make_caching_fs(cache);
+        CHECK(read_file(*fs, header) == "struct A {};");
+        CHECK(cache.stats().contents_size == 24);
+
+        auto buffer = llvm::MemoryBuffer::getMemBufferCopy("struct A {};");
+        auto status = fs->status(header);
+        REQUIRE(status);
+        cache.add_contents(header, *status, std::move(buffer), 12);
+
+        CHECK(cache.stats().contents_count == 1);
+        CHECK(cache.stats().contents_size == 12);
+    }
+
+    std::filesystem::remove_all(dir);
+}
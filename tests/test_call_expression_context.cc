@@ -0,0 +1,194 @@
+/**
+ * @file tests/test_call_expression_context.cc
+ *
+ * Copyright (c) 2021-2025 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "doctest/doctest.h"
+
+#include "sequence_diagram/visitor/call_expression_context.h"
+
+#include <clang/Tooling/Tooling.h>
+
+#include <vector>
+
+using clanguml::common::eid_t;
+using clanguml::sequence_diagram::visitor::call_expression_context;
+
+namespace {
+/**
+ * @brief Collect function declarations and statements from a test AST
+ */
+struct statements_collector
+    : public clang::RecursiveASTVisitor<statements_collector> {
+    bool VisitFunctionDecl(clang::FunctionDecl *declaration)
+    {
+        functions.push_back(declaration);
+        return true;
+    }
+
+    bool VisitIfStmt(clang::IfStmt *stmt)
+    {
+        ifs.push_back(stmt);
+        return true;
+    }
+
+    bool VisitCXXTryStmt(clang::CXXTryStmt *stmt)
+    {
+        trys.push_back(stmt);
+        return true;
+    }
+
+    bool VisitSwitchStmt(clang::SwitchStmt *stmt)
+    {
+        switches.push_back(stmt);
+        return true;
+    }
+
+    std::vector<clang::FunctionDecl *> functions;
+    std::vector<clang::IfStmt *> ifs;
+    std::vector<clang::Stmt *> trys;
+    std::vector<clang::SwitchStmt *> switches;
+};
+
+constexpr auto kTestCode = R"(
+int f(int a) {
+    try { if (a) return 1; } catch (...) { }
+    switch (a) { default: break; }
+    return a;
+}
+
+int g(int a) {
+    try { if (a) return 2; } catch (...) { }
+    switch (a) { default: break; }
+    return f(a);
+}
+)";
+} // namespace
+
+TEST_CASE("Test call_expression_context leave statements on empty stacks")
+{
+    auto ast = clang::tooling::buildASTFromCode(kTestCode);
+    REQUIRE(ast);
+
+    statements_collector stmts;
+    stmts.TraverseDecl(ast->getASTContext().getTranslationUnitDecl());
+    REQUIRE(stmts.trys.size() == 2);
+    REQUIRE(stmts.switches.size() == 2);
+
+    call_expression_context context;
+
+    // Leaving a statement which was never entered is a no-op
+    context.leave_trystmt();
+    context.leave_switchstmt();
+    CHECK(context.current_trystmt() == nullptr);
+    CHECK(context.current_switchstmt() == nullptr);
+
+    context.enter_trystmt(stmts.trys[0]);
+    context.enter_switchstmt(stmts.switches[0]);
+    CHECK(context.current_trystmt() == stmts.trys[0]);
+    CHECK(context.current_switchstmt() == stmts.switches[0]);
+
+    context.leave_trystmt();
+    context.leave_switchstmt();
+    context.leave_trystmt();
+    context.leave_switchstmt();
+    CHECK(context.current_trystmt() == nullptr);
+    CHECK(context.current_switchstmt() == nullptr);
+
+    // Stacks are still usable after unbalanced leaves
+    context.enter_trystmt(stmts.trys[1]);
+    context.enter_switchstmt(stmts.switches[1]);
+    CHECK(context.current_trystmt() == stmts.trys[1]);
+    CHECK(context.current_switchstmt() == stmts.switches[1]);
+}
+
+TEST_CASE("Test call_expression_context push_scope and pop_scope")
+{
+    auto ast = clang::tooling::buildASTFromCode(kTestCode);
+    REQUIRE(ast);
+
+    statements_collector stmts;
+    stmts.TraverseDecl(ast->getASTContext().getTranslationUnitDecl());
+    REQUIRE(stmts.functions.size() == 2);
+    REQUIRE(stmts.ifs.size() == 2);
+
+    call_expression_context context;
+
+    context.update(stmts.functions[0]);
+    context.set_caller_id(eid_t{int64_t{1}});
+    context.enter_trystmt(stmts.trys[0]);
+    context.enter_ifstmt(stmts.ifs[0]);
+
+    SUBCASE("Declarations and statements entered in scope are dropped")
+    {
+        context.push_scope();
+
+        context.update(stmts.functions[1]);
+        context.set_caller_id(eid_t{int64_t{2}});
+        context.enter_trystmt(stmts.trys[1]);
+        context.enter_ifstmt(stmts.ifs[1]);
+        context.enter_switchstmt(stmts.switches[1]);
+
+        CHECK(context.current_function_decl_ == stmts.functions[1]);
+        CHECK(context.caller_id() == eid_t{int64_t{2}});
+        CHECK(context.current_ifstmt() == stmts.ifs[1]);
+
+        context.pop_scope();
+
+        CHECK(context.current_function_decl_ == stmts.functions[0]);
+        CHECK(context.caller_id() == eid_t{int64_t{1}});
+        CHECK(context.current_trystmt() == stmts.trys[0]);
+        CHECK(context.current_ifstmt() == stmts.ifs[0]);
+        CHECK(context.current_switchstmt() == nullptr);
+    }
+
+    SUBCASE("Statements left in scope below the saved depth stay left")
+    {
+        context.push_scope();
+
+        context.leave_ifstmt();
+        context.leave_trystmt();
+
+        context.pop_scope();
+
+        CHECK(context.current_function_decl_ == stmts.functions[0]);
+        CHECK(context.current_trystmt() == nullptr);
+        CHECK(context.current_ifstmt() == nullptr);
+    }
+
+    SUBCASE("Nested scopes are restored in reverse order")
+    {
+        context.push_scope();
+        context.update(stmts.functions[1]);
+        context.enter_switchstmt(stmts.switches[0]);
+
+        context.push_scope();
+        context.enter_switchstmt(stmts.switches[1]);
+        context.reset();
+        CHECK(context.current_function_decl_ == nullptr);
+        context.pop_scope();
+
+        CHECK(context.current_function_decl_ == stmts.functions[1]);
+        CHECK(context.current_switchstmt() == stmts.switches[0]);
+
+        context.pop_scope();
+
+        CHECK(context.current_function_decl_ == stmts.functions[0]);
+        CHECK(context.current_switchstmt() == nullptr);
+        CHECK(context.current_ifstmt() == stmts.ifs[0]);
+    }
+}
@@ -21,6 +21,7 @@
 #include "cli/cli_handler.h"
 #include "common/compilation_database.h"
 #include "common/generators/generators.h"
+#include "common/generators/preamble_cache.h"
 #include "util/util.h"
 
 #include <spdlog/spdlog.h>
@@ -729,6 +730,10 @@ void CHECK_INCLUDE_DIAGRAM(const clanguml::config::config &config,
 ///
 #include "t90000/test_case.h"
 #include "t90001/test_case.h"
+#include "t90002/test_case.h"
+#include "t90003/test_case.h"
+#include "t90004/test_case.h"
+#include "t90005/test_case.h"
 
 ///
 /// Main test function
@@ -22,6 +22,8 @@
 
 #include "doctest/doctest.h"
 
+#include <llvm/Config/llvm-config.h>
+
 #include <random>
 #include <spdlog/sinks/ostream_sink.h>
 #include <spdlog/spdlog.h>
@@ -607,4 +609,21 @@ TEST_CASE("Test cli handler fail when print_to or print_from do not have "
     auto res = cli.handle_options(argv.size(), argv.data());
 
     REQUIRE(res == cli_flow_t::kError);
-}
\ No newline at end of file
+}
+#if LLVM_VERSION_MAJOR < 17
+TEST_CASE("Test cli handler fail when preamble directory is not supported")
+{
+    using clanguml::cli::cli_flow_t;
+    using clanguml::cli::cli_handler;
+
+    std::vector<const char *> argv = {"clang-uml", "--precompiled-preambles",
+        "--preamble-dir", "/tmp/clang-uml-preambles"};
+
+    std::ostringstream ostr;
+    cli_handler cli{ostr, make_sstream_logger(ostr)};
+
+    auto res = cli.handle_options(argv.size(), argv.data());
+
+    REQUIRE(res == cli_flow_t::kError);
+}
+#endif
@@ -21,6 +21,7 @@
 
 #include "cli/cli_handler.h"
 #include "common/compilation_database.h"
+#include "common/generators/clang_tool.h"
 #include "util/util.h"
 
 #include <spdlog/sinks/ostream_sink.h>
@@ -80,6 +81,14 @@ TEST_CASE("Test compile_commands.json should work")
             !contains(ccs.at(0).CommandLine, "-Wno-deprecated-declarations"));
 
         REQUIRE_EQ(db->count_matching_commands({class_path.string()}), 1);
+
+        // Compile commands are indexed by normalized absolute paths
+        auto class_path_not_normalized = cfg.root_directory() /
+            path("src/class_diagram/../class_diagram/model/class.cc");
+        REQUIRE(db->is_indexed(class_path_not_normalized.string()));
+        REQUIRE_EQ(
+            db->getCompileCommands(class_path_not_normalized.string()).size(),
+            1);
     }
     catch (clanguml::error::compilation_database_error &e) {
         REQUIRE(false);
@@ -140,6 +149,150 @@ TEST_CASE("Test compilation_database should throw")
         compilation_database_error);
 }
 
+TEST_CASE("Test compile_command_hash")
+{
+    using clanguml::generators::compile_command_hash;
+
+    const std::vector<std::string> debug{
+        "clang++", "-std=c++17", "-DDEBUG", "-Wall", "-fsyntax-only", "a.cc"};
+    const std::vector<std::string> debug_no_warnings{
+        "clang++", "-std=c++17", "-DDEBUG", "-w", "-fsyntax-only", "a.cc"};
+    const std::vector<std::string> release{
+        "clang++", "-std=c++17", "-DNDEBUG", "-Wall", "-fsyntax-only", "a.cc"};
+    const std::vector<std::string> debug_preprocessor{"clang++", "-std=c++17",
+        "-DDEBUG", "-Wp,-DX", "-fsyntax-only", "a.cc"};
+    const std::vector<std::string> debug_pedantic{"clang++", "-std=c++17",
+        "-DDEBUG", "-pedantic-errors", "-fsyntax-only", "a.cc"};
+
+    CHECK(compile_command_hash("/tmp", debug, false) ==
+        compile_command_hash("/tmp", debug, false));
+    CHECK(compile_command_hash("/tmp", debug, false) !=
+        compile_command_hash("/tmp/build", debug, false));
+    CHECK(compile_command_hash("/tmp", debug, false) !=
+        compile_command_hash("/tmp", debug_no_warnings, false));
+
+    CHECK(compile_command_hash("/tmp", debug, true) ==
+        compile_command_hash("/tmp", debug_no_warnings, true));
+    CHECK(compile_command_hash("/tmp", debug_no_warnings, true) ==
+        compile_command_hash("/tmp", debug_pedantic, true));
+    CHECK(compile_command_hash("/tmp", debug, true) !=
+        compile_command_hash("/tmp", release, true));
+    CHECK(compile_command_hash("/tmp", debug, true) !=
+        compile_command_hash("/tmp", debug_preprocessor, true));
+}
+
+TEST_CASE("Test merge_compile_commands")
+{
+    using clanguml::generators::merge_compile_commands;
+    using clang::tooling::CompileCommand;
+
+    const CompileCommand debug{"/build/debug", "a.cc",
+        {"clang++", "-std=c++17", "-DDEBUG", "-DLEVEL=1", "-Iinclude",
+            "-isystem", "/usr/include/x", "-c", "a.cc"},
+        "a.o"};
+    const CompileCommand release{"/build/release", "a.cc",
+        {"clang++", "-std=c++17", "-DNDEBUG", "-DLEVEL=2",
+            "-I/build/debug/include", "-Igenerated", "-isystem",
+            "/usr/include/x", "-isystem", "/usr/include/y", "-c", "a.cc"},
+        "a.o"};
+
+    CHECK(merge_compile_commands({debug}) == debug.CommandLine);
+
+    // Include paths already in the first command are not added again, and
+    // the first definition of a macro is used
+    CHECK(merge_compile_commands({debug, release}) ==
+        std::vector<std::string>{"clang++", "-std=c++17", "-DDEBUG",
+            "-DLEVEL=1", "-Iinclude", "-isystem", "/usr/include/x", "-c",
+            "a.cc", "-DNDEBUG", "-I", "/build/release/generated", "-isystem",
+            "/usr/include/y"});
+
+    // Merged options are added before the end of options marker
+    const CompileCommand with_inputs{"/build/debug", "a.cc",
+        {"clang++", "-DDEBUG", "--", "a.cc"}, "a.o"};
+    const CompileCommand other{"/build/debug", "a.cc",
+        {"clang++", "-DOTHER", "-Iother", "a.cc"}, "a.o"};
+
+    CHECK(merge_compile_commands({with_inputs, other}) ==
+        std::vector<std::string>{"clang++", "-DDEBUG", "-DOTHER", "-I",
+            "/build/debug/other", "--", "a.cc"});
+}
+
+TEST_CASE("Test make_unity_batches")
+{
+    using clanguml::generators::make_unity_batches;
+    using batches_t = std::vector<std::vector<std::string>>;
+
+    SUBCASE("Translation units are grouped by compile commands")
+    {
+        const auto result = make_unity_batches({"a.cc", "b.cc", "c.cc", "d.cc"},
+            {{"a.cc", "debug"}, {"b.cc", "release"}, {"c.cc", "debug"},
+                {"d.cc", "release"}},
+            4);
+
+        CHECK(result == batches_t{{"a.cc", "c.cc"}, {"b.cc", "d.cc"}});
+    }
+
+    SUBCASE("Groups are split into batches of limited size")
+    {
+        const auto result =
+            make_unity_batches({"a.cc", "b.cc", "c.cc", "d.cc", "e.cc"},
+                {{"a.cc", "debug"}, {"b.cc", "debug"}, {"c.cc", "debug"},
+                    {"d.cc", "debug"}, {"e.cc", "debug"}},
+                2);
+
+        CHECK(result ==
+            batches_t{{"a.cc", "b.cc"}, {"c.cc", "d.cc"}, {"e.cc"}});
+    }
+
+    SUBCASE("Translation units without group key are processed separately")
+    {
+        const auto result = make_unity_batches({"a.cc", "b.cc", "c.cc"},
+            {{"a.cc", "debug"}, {"c.cc", "debug"}}, 4);
+
+        CHECK(result == batches_t{{"a.cc", "c.cc"}, {"b.cc"}});
+    }
+
+    SUBCASE("Batches keep the order of their first translation unit")
+    {
+        const auto result =
+            make_unity_batches({"a.cc", "b.cc", "c.cc", "d.cc", "e.cc"},
+                {{"a.cc", "debug"}, {"c.cc", "debug"}, {"d.cc", "debug"},
+                    {"e.cc", "release"}},
+                2);
+
+        CHECK(result ==
+            batches_t{{"a.cc", "c.cc"}, {"b.cc"}, {"d.cc"}, {"e.cc"}});
+    }
+
+    SUBCASE("Single translation unit groups are processed separately")
+    {
+        const auto result = make_unity_batches({"a.cc", "b.cc", "c.cc"},
+            {{"a.cc", "debug"}, {"b.cc", "release"}, {"c.cc", "profile"}}, 4);
+
+        CHECK(result == batches_t{{"a.cc"}, {"b.cc"}, {"c.cc"}});
+    }
+
+    SUBCASE("Batch size smaller than 2 disables batching")
+    {
+        for (const unsigned batch_size : {0U, 1U}) {
+            const auto result = make_unity_batches({"a.cc", "b.cc"},
+                {{"a.cc", "debug"}, {"b.cc", "debug"}}, batch_size);
+
+            CHECK(result == batches_t{{"a.cc"}, {"b.cc"}});
+        }
+    }
+}
+
+TEST_CASE("Test is_unity_translation_unit")
+{
+    using clanguml::generators::is_unity_translation_unit;
+
+    CHECK(is_unity_translation_unit("/src/clang-uml-unity-0.cc"));
+    CHECK(is_unity_translation_unit("clang-uml-unity-1.cpp"));
+    CHECK_FALSE(is_unity_translation_unit("/src/a.cc"));
+    CHECK_FALSE(is_unity_translation_unit("/src/clang-uml-unity-0/a.cc"));
+}
+
 ///
 /// Main test function
 ///
@@ -649,6 +649,35 @@ TEST_CASE("Test config glob matching - explicit regex")
         clanguml::util::contains(res, to_string(visitor_cc.make_preferred())));
 }
 
+TEST_CASE("Test config glob matching - shared index")
+{
+    auto cfg = clanguml::config::load("./test_config_data/test_glob.yml");
+
+    auto root_directory = cfg.root_directory();
+
+    std::vector<std::filesystem::path> db_paths = {
+        root_directory / "src/main.cc", root_directory / "src/util/util.cc",
+        root_directory / "src/no_such_file.cc",
+        root_directory /
+            "src/class_diagram/visitor/translation_unit_visitor.cc",
+        root_directory / "thirdparty/pugixml/pugixml.cpp"};
+
+    std::vector<std::string> db;
+    std::transform(db_paths.begin(), db_paths.end(), std::back_inserter(db),
+        [](const auto &p) { return p.string(); });
+
+    clanguml::config::translation_unit_index index{db};
+
+    // Results are the same for all diagrams sharing the index
+    for (int i = 0; i < 2; i++) {
+        for (const auto &[name, diagram] : cfg.diagrams) {
+            CHECK_MESSAGE(diagram->glob_translation_units(index) ==
+                    diagram->glob_translation_units(db),
+                name);
+        }
+    }
+}
+
 TEST_CASE("Test config user_data")
 {
     using clanguml::common::model::access_t;
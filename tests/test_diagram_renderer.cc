@@ -0,0 +1,214 @@
+/**
+ * @file tests/test_diagram_renderer.cc
+ *
+ * Copyright (c) 2021-2025 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#define DOCTEST_CONFIG_IMPLEMENT
+
+#include "doctest/doctest.h"
+
+#include "common/generators/diagram_renderer.h"
+#include "util/util.h"
+
+#include <spdlog/spdlog.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+using clanguml::common::generator_type_t;
+using clanguml::common::generators::diagram_renderer;
+using clanguml::common::generators::render_task;
+
+namespace {
+render_task make_task(const std::string &name, const std::string &cmd,
+    const std::string &batch_cmd)
+{
+    render_task task;
+    task.generator_type = generator_type_t::plantuml;
+    task.diagram_name = name;
+    task.cmd = cmd;
+    task.batch_cmd = batch_cmd;
+    task.path = std::filesystem::path{"diagrams"} / (name + ".puml");
+    return task;
+}
+
+#if !defined(_WIN32)
+/**
+ * Create a stub renderer script, which appends its arguments as a single
+ * line to a log file.
+ */
+std::filesystem::path make_stub_renderer(const std::filesystem::path &dir)
+{
+    std::filesystem::create_directories(dir);
+
+    const auto script = dir / "stub_renderer.sh";
+    std::ofstream ofs{script};
+    ofs << "#!/bin/sh\n"
+        << "echo \"$@\" >> \"" << (dir / "render.log").string() << "\"\n";
+    ofs.close();
+
+    std::filesystem::permissions(script,
+        std::filesystem::perms::owner_all,
+        std::filesystem::perm_options::replace);
+
+    return script;
+}
+
+std::vector<std::string> read_lines(const std::filesystem::path &path)
+{
+    std::vector<std::string> result;
+    std::ifstream ifs{path};
+    std::string line;
+    while (std::getline(ifs, line))
+        result.emplace_back(line);
+    return result;
+}
+#endif
+} // namespace
+
+TEST_CASE("Test diagram_renderer batch command")
+{
+    std::vector<render_task> batch;
+    batch.emplace_back(make_task("A", "", "plantuml -tsvg {}"));
+    batch.emplace_back(make_task("B", "", "plantuml -tsvg {}"));
+
+    const auto a = (std::filesystem::path{"diagrams"} / "A.puml").string();
+    const auto b = (std::filesystem::path{"diagrams"} / "B.puml").string();
+
+    CHECK(diagram_renderer::make_batch_command("plantuml -tsvg {}", batch) ==
+        "plantuml -tsvg \"" + a + "\" \"" + b + "\"");
+}
+
+#if !defined(_WIN32)
+TEST_CASE("Test diagram_renderer with stub renderer")
+{
+    const auto dir = std::filesystem::temp_directory_path() /
+        "clang-uml-test-diagram-renderer";
+    std::filesystem::remove_all(dir);
+
+    const auto script = make_stub_renderer(dir);
+    const auto log = dir / "render.log";
+
+    SUBCASE("Batch rendering")
+    {
+        const unsigned int kDiagramCount = 20;
+
+        // All tasks are added long before the batch delay elapses, so they
+        // have to be rendered in a single batch when the renderer is stopped
+        diagram_renderer renderer{1, 0, std::chrono::minutes{1}};
+
+        for (auto i = 0U; i < kDiagramCount; i++) {
+            renderer.add(make_task(
+                fmt::format("d{}", i), "", script.string() + " {}"));
+        }
+
+        CHECK(renderer.wait().empty());
+
+        // Each diagram has to be rendered exactly once
+        std::stringstream all;
+        for (const auto &line : read_lines(log))
+            all << line << ' ';
+
+        for (auto i = 0U; i < kDiagramCount; i++) {
+            const auto path = (std::filesystem::path{"diagrams"} /
+                fmt::format("d{}.puml", i))
+                                  .string();
+            const auto output = all.str();
+            const auto pos = output.find(path + " ");
+            REQUIRE(pos != std::string::npos);
+            CHECK(output.find(path + " ", pos + 1) == std::string::npos);
+        }
+
+        CHECK(renderer.invocation_count() < kDiagramCount);
+        CHECK(renderer.invocation_count() == 1);
+        CHECK(read_lines(log).size() == renderer.invocation_count());
+    }
+
+    SUBCASE("Batch size limit")
+    {
+        diagram_renderer renderer{1, 2, std::chrono::minutes{1}};
+
+        for (auto i = 0U; i < 5; i++) {
+            renderer.add(make_task(
+                fmt::format("d{}", i), "", script.string() + " {}"));
+        }
+
+        CHECK(renderer.wait().empty());
+
+        for (const auto &line : read_lines(log))
+            CHECK(clanguml::util::split(line, " ").size() <= 2);
+
+        CHECK(renderer.invocation_count() == 3);
+    }
+
+    SUBCASE("Per diagram rendering")
+    {
+        diagram_renderer renderer{1, 0};
+
+        renderer.add(make_task("A", script.string() + " {}", ""));
+        renderer.add(make_task("B", script.string() + " {}", ""));
+
+        CHECK(renderer.wait().empty());
+
+        CHECK(read_lines(log) == std::vector<std::string>{"A", "B"});
+        CHECK(renderer.invocation_count() == 2);
+    }
+
+    SUBCASE("Batch delay")
+    {
+        diagram_renderer renderer{1, 0, std::chrono::milliseconds{10}};
+
+        renderer.add(make_task("A", "", script.string() + " {}"));
+
+        // The batch is rendered after the delay, without stopping the
+        // renderer
+        for (auto i = 0; i < 500 && renderer.invocation_count() == 0; i++)
+            std::this_thread::sleep_for(std::chrono::milliseconds{10});
+
+        CHECK(renderer.invocation_count() == 1);
+        CHECK(renderer.wait().empty());
+    }
+
+    SUBCASE("Renderer failure")
+    {
+        diagram_renderer renderer{1, 0};
+
+        renderer.add(make_task("A", "", "exit 1 {}"));
+
+        CHECK(renderer.wait().size() == 1);
+    }
+
+    std::filesystem::remove_all(dir);
+}
+#endif
+
+///
+/// Main test function
+///
+int main(int argc, char *argv[])
+{
+    doctest::Context context;
+
+    context.applyCommandLine(argc, argv);
+
+    // Register a logger without any sinks, the renderer logs each invocation
+    std::vector<spdlog::sink_ptr> sinks;
+    spdlog::register_logger(std::make_shared<spdlog::logger>(
+        "clanguml-logger", begin(sinks), end(sinks)));
+
+    return context.run();
+}
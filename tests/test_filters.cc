@@ -19,8 +19,10 @@
 
 #include "doctest/doctest.h"
 
+#include "class_diagram/generators/json/class_diagram_generator.h"
 #include "class_diagram/model/class.h"
 #include "class_diagram/model/enum.h"
+#include "class_diagram/visitor/translation_unit_visitor.h"
 #include "cli/cli_handler.h"
 #include "common/model/filters/diagram_filter_factory.h"
 #include "common/model/source_file.h"
@@ -28,7 +30,11 @@
 #include "include_diagram/model/diagram.h"
 #include "sequence_diagram/model/diagram.h"
 
+#include <clang/Tooling/Tooling.h>
+
+#include <algorithm>
 #include <filesystem>
+#include <sstream>
 
 TEST_CASE("Test diagram paths filter")
 {
@@ -57,6 +63,73 @@ TEST_CASE("Test diagram paths filter")
         make_path("sequence_diagram/visitor/translation_unit_visitor.h")));
 }
 
+TEST_CASE("Test cached paths filter verdicts")
+{
+    using clanguml::common::model::diagram_filter_factory;
+    using clanguml::common::model::filter_t;
+    using clanguml::common::model::paths_filter;
+    using clanguml::common::model::source_file;
+    using clanguml::common::model::source_location;
+
+    auto cfg = clanguml::config::load("./test_config_data/filters.yml");
+
+    auto &config = *cfg.diagrams["include_test"];
+    clanguml::include_diagram::model::diagram diagram;
+
+    const std::vector<std::pair<std::string, bool>> files{
+        {"class_diagram/visitor/translation_unit_visitor.h", true},
+        {"main.cc", true}, {"util/util.cc", true}, {"util/error.h", false},
+        {"sequence_diagram/visitor/translation_unit_visitor.h", false}};
+
+    SUBCASE("diagram_filter::should_include_source_file")
+    {
+        auto filter = diagram_filter_factory::create(diagram, config);
+
+        for (const auto &[file, expected] : files) {
+            const auto path = (config.root_directory() / file).string();
+
+            // Filter without any cached verdicts
+            const auto uncached =
+                diagram_filter_factory::create(diagram, config)
+                    ->should_include(source_file{path});
+
+            CHECK(uncached == expected);
+            CHECK(filter->should_include_source_file(path) == uncached);
+            CHECK(filter->should_include_source_file(path) == uncached);
+        }
+    }
+
+    SUBCASE("paths_filter::match")
+    {
+        const std::vector<std::string> paths{"util/*.h", "main.cc"};
+        const paths_filter filter{
+            filter_t::kInclusive, paths, config.root_directory()};
+
+        for (const auto &[file, expected] : files) {
+            const source_location location{
+                (config.root_directory() / file).string(), 1};
+
+            const auto uncached =
+                paths_filter{
+                    filter_t::kInclusive, paths, config.root_directory()}
+                    .match(diagram, location);
+
+            CHECK(filter.match(diagram, location) == uncached);
+            CHECK(filter.match(diagram, location) == uncached);
+        }
+
+        const source_location included{
+            (config.root_directory() / "util/error.h").string(), 1};
+        const source_location excluded{
+            (config.root_directory() / "util/util.cc").string(), 1};
+
+        CHECK(clanguml::common::model::tvl::is_true(
+            filter.match(diagram, included)));
+        CHECK(clanguml::common::model::tvl::is_false(
+            filter.match(diagram, excluded)));
+    }
+}
+
 TEST_CASE("Test method_types include filter")
 {
     using clanguml::class_diagram::model::class_method;
@@ -310,6 +383,93 @@ TEST_CASE("Test namespaces regexp filter")
     CHECK(filter.should_include(p));
 }
 
+TEST_CASE("Test traversal pruning of excluded namespaces")
+{
+    using clanguml::class_diagram::model::diagram;
+    using clanguml::common::model::diagram_filter_factory;
+
+    auto cfg = clanguml::config::load("./test_config_data/filters.yml");
+
+    constexpr auto kCode = R"(
+namespace ns1 {
+namespace detail {
+struct B { };
+struct C : B { };
+}
+struct A { detail::B *b; };
+struct D : detail::C { };
+}
+namespace ns2 {
+struct E { };
+}
+)";
+
+    auto ast = clang::tooling::buildASTFromCode(kCode);
+    REQUIRE(ast);
+
+    // Build the class diagram model the same way the diagram AST consumer
+    // does and render it to JSON
+    auto generate = [&](const std::string &diagram_name,
+                        uint64_t &skipped_declarations) {
+        auto &config = dynamic_cast<clanguml::config::class_diagram &>(
+            *cfg.diagrams[diagram_name]);
+
+        diagram d;
+        d.set_name("namespace_pruning");
+        d.set_filter(diagram_filter_factory::create(d, config));
+
+        clanguml::class_diagram::visitor::translation_unit_visitor visitor{
+            ast->getSourceManager(), d, config};
+        {
+            clanguml::common::printing_cache::scope printing_cache_scope{
+                visitor.printing_cache(), ast->getASTContext()};
+
+            visitor.TraverseDecl(ast->getASTContext().getTranslationUnitDecl());
+            visitor.finalize();
+        }
+
+        skipped_declarations = visitor.skipped_declarations();
+
+        d.set_complete(true);
+        d.finalize();
+
+        std::stringstream ss;
+        ss << clanguml::class_diagram::generators::json::generator(config, d);
+
+        auto j = nlohmann::json::parse(ss.str());
+        j.erase("metadata");
+
+        return j;
+    };
+
+    uint64_t pruned_skipped_declarations{0};
+    const auto pruned =
+        generate("namespace_pruning_test", pruned_skipped_declarations);
+
+    // Regular expressions in namespace filters disable namespace pruning
+    uint64_t skipped_declarations{0};
+    const auto not_pruned =
+        generate("namespace_no_pruning_test", skipped_declarations);
+
+    // Only `ns1::detail` and `ns2` namespaces are not traversed
+    CHECK(pruned_skipped_declarations == 2);
+    CHECK(skipped_declarations == 0);
+
+    CHECK(pruned == not_pruned);
+
+    const auto &elements = pruned["elements"];
+    const auto has_element = [&elements](const std::string &name) {
+        return std::any_of(elements.begin(), elements.end(),
+            [&name](const auto &e) { return e["name"] == name; });
+    };
+
+    CHECK(has_element("A"));
+    CHECK(has_element("D"));
+    CHECK_FALSE(has_element("B"));
+    CHECK_FALSE(has_element("C"));
+    CHECK_FALSE(has_element("E"));
+}
+
 TEST_CASE("Test subclasses regexp filter")
 {
     using clanguml::class_diagram::model::class_method;
@@ -20,10 +20,15 @@
 #include "doctest/doctest.h"
 
 #include "class_diagram/model/class.h"
+#include "common/model/memory_usage.h"
 #include "common/model/namespace.h"
 #include "common/model/package.h"
 #include "common/model/path.h"
+#include "common/model/template_instantiation_cache.h"
 #include "common/model/template_parameter.h"
+#include "sequence_diagram/model/activity.h"
+#include "sequence_diagram/model/diagram.h"
+#include "sequence_diagram/model/participant.h"
 
 TEST_CASE("Test namespace_")
 {
@@ -489,4 +494,291 @@ TEST_CASE("Test path_type")
     auto p2 = path{"A/B/C/D", path_type::kFilesystem};
 
     REQUIRE_THROWS_AS(p1 = p2, std::runtime_error);
-}
\ No newline at end of file
+}
+
+TEST_CASE("Test sequence_diagram::model::message")
+{
+    using clanguml::common::eid_t;
+    using clanguml::common::model::message_t;
+    using clanguml::sequence_diagram::model::message;
+
+    message m1{message_t::kIf, eid_t{uint64_t{1}}};
+    m1.set_message_name("a");
+    m1.set_return_type("void");
+    CHECK(!m1.condition_text().has_value());
+    CHECK(!m1.comment().has_value());
+
+    message m2{m1};
+    CHECK(m1 == m2);
+    CHECK(&m1.message_name() == &m2.message_name());
+
+    // Modifying a copy must not affect the original message
+    m2.condition_text("x > 0");
+    m2.set_comment(1, "comment");
+    CHECK(m2.condition_text().value() == "x > 0");
+    CHECK(m2.comment().value()["comment"] == "comment");
+    CHECK(!m1.condition_text().has_value());
+    CHECK(!m1.comment().has_value());
+    CHECK_FALSE(m1 == m2);
+
+    message m3{m2};
+    m3.condition_text("");
+    CHECK(!m3.condition_text().has_value());
+    CHECK(m3.comment().has_value());
+    CHECK(m2.condition_text().has_value());
+}
+
+TEST_CASE("Test sequence_diagram::model::activity_map")
+{
+    using clanguml::common::eid_t;
+    using clanguml::sequence_diagram::model::activity;
+    using clanguml::sequence_diagram::model::activity_map;
+
+    activity_map am;
+    CHECK(am.empty());
+
+    for (const uint64_t id : {5, 3, 9, 1}) {
+        CHECK(am.insert({eid_t{id}, activity{eid_t{id}}}));
+    }
+    CHECK_FALSE(am.insert({eid_t{uint64_t{3}}, activity{eid_t{uint64_t{3}}}}));
+
+    CHECK(am.size() == 4);
+    CHECK(am.contains(eid_t{uint64_t{9}}));
+    CHECK(am.count(eid_t{uint64_t{7}}) == 0);
+    CHECK(am.get(eid_t{uint64_t{7}}) == nullptr);
+    CHECK(am.at(eid_t{uint64_t{5}}).from() == eid_t{uint64_t{5}});
+    CHECK_THROWS_AS(am.at(eid_t{uint64_t{7}}), std::out_of_range);
+
+    // Iteration is ordered by activity id
+    std::vector<uint64_t> ids;
+    for (const auto &[id, act] : am)
+        ids.push_back(id.value());
+    CHECK(ids == std::vector<uint64_t>{1, 3, 5, 9});
+
+    // References remain valid after adding new activities
+    auto &a5 = am.at(eid_t{uint64_t{5}});
+    for (uint64_t id = 100; id < 1000; id++)
+        am.insert({eid_t{id}, activity{eid_t{id}}});
+    CHECK(&a5 == &am.at(eid_t{uint64_t{5}}));
+    CHECK(am.size() == 904);
+}
+
+TEST_CASE("Test template_instantiation_cache")
+{
+    using clanguml::common::eid_t;
+    using clanguml::common::model::relationship;
+    using clanguml::common::model::relationship_t;
+    using clanguml::common::model::template_instantiation_cache;
+    using clanguml::common::model::template_parameter;
+
+    template_instantiation_cache cache;
+
+    CHECK(cache.get(1) == nullptr);
+
+    template_instantiation_cache::entry e;
+    e.template_params.emplace_back(template_parameter::make_argument("int"));
+    e.relationships.emplace_back(
+        relationship_t::kDependency, eid_t{uint64_t{100}});
+    cache.add(1, std::move(e));
+
+    // Existing entries are not replaced
+    template_instantiation_cache::entry e2;
+    cache.add(1, std::move(e2));
+
+    const auto cached = cache.get(1);
+    REQUIRE(cached);
+    CHECK(cache.size() == 1);
+    REQUIRE(cached->template_params.size() == 1);
+    CHECK(cached->template_params.front().type().value() == "int");
+    REQUIRE(cached->relationships.size() == 1);
+    CHECK(cached->relationships.front().destination() == eid_t{uint64_t{100}});
+}
+
+TEST_CASE("Test element_cast")
+{
+    using clanguml::class_diagram::model::class_;
+    using clanguml::common::model::diagram_element;
+    using clanguml::common::model::element;
+    using clanguml::common::model::element_cast;
+    using clanguml::common::model::element_kind_t;
+    using clanguml::common::model::namespace_;
+    using clanguml::common::model::package;
+    using clanguml::sequence_diagram::model::function;
+    using clanguml::sequence_diagram::model::function_template;
+    using clanguml::sequence_diagram::model::method;
+
+    namespace_ using_namespace{};
+    package pkg{using_namespace};
+    class_ cls{using_namespace};
+    method m{using_namespace};
+
+    const diagram_element *e = &pkg;
+    CHECK(e->kind() == element_kind_t::kPackage);
+    CHECK(element_cast<package>(e) == &pkg);
+    CHECK(element_cast<class_>(e) == nullptr);
+
+    element *el = &cls;
+    CHECK(element_cast<class_>(el) == &cls);
+    CHECK(element_cast<package>(el) == nullptr);
+
+    el = &m;
+    CHECK(element_cast<function>(el) == &m);
+    CHECK(element_cast<method>(el) == &m);
+    CHECK(element_cast<function_template>(el) == nullptr);
+}
+
+TEST_CASE("Test diagram_element relationships")
+{
+    using clanguml::common::eid_t;
+    using clanguml::common::model::namespace_;
+    using clanguml::common::model::package;
+    using clanguml::common::model::relationship;
+    using clanguml::common::model::relationship_t;
+
+    namespace_ using_namespace{};
+    package pkg{using_namespace};
+    pkg.set_id(eid_t{uint64_t{1}});
+
+    const eid_t a_local{int64_t{10}};
+    const eid_t a{uint64_t{100}};
+    const eid_t b{uint64_t{200}};
+
+    // Duplicate relationships are rejected
+    pkg.add_relationship(relationship{relationship_t::kDependency, a});
+    pkg.add_relationship(relationship{relationship_t::kDependency, a});
+    pkg.add_relationship(relationship{relationship_t::kAssociation, a});
+    pkg.add_relationship(
+        relationship{relationship_t::kAssociation, a, {}, "label"});
+    pkg.add_relationship(
+        relationship{relationship_t::kAssociation, a, {}, "label"});
+    pkg.add_relationship(
+        relationship{relationship_t::kInstantiation, pkg.id()});
+
+    CHECK(pkg.relationships().size() == 3);
+
+    // Relationships to local ids become duplicates after they are resolved
+    pkg.add_relationship(relationship{relationship_t::kDependency, a_local});
+    pkg.add_relationship(relationship{relationship_t::kDependency, b});
+    REQUIRE(pkg.relationships().size() == 5);
+
+    pkg.resolve_relationship_destinations(
+        [&](const relationship &r) -> std::optional<eid_t> {
+            if (r.destination() == a_local)
+                return a;
+            return {};
+        });
+
+    REQUIRE(pkg.relationships().size() == 4);
+    CHECK(std::none_of(pkg.relationships().begin(), pkg.relationships().end(),
+        [&](const auto &r) { return r.destination() == a_local; }));
+
+    // Duplicates are still rejected after relationships are removed
+    pkg.remove_relationships_if([&](const relationship &r) {
+        return r.type() == relationship_t::kAssociation;
+    });
+
+    REQUIRE(pkg.relationships().size() == 2);
+    CHECK(pkg.relationships()[0].destination() == a);
+    CHECK(pkg.relationships()[1].destination() == b);
+
+    pkg.add_relationship(relationship{relationship_t::kDependency, a});
+    pkg.add_relationship(relationship{relationship_t::kDependency, b});
+    CHECK(pkg.relationships().size() == 2);
+
+    pkg.add_relationship(relationship{relationship_t::kAssociation, a});
+    pkg.add_relationship(relationship{relationship_t::kAssociation, a});
+    CHECK(pkg.relationships().size() == 3);
+}
+
+TEST_CASE("Test memory_usage")
+{
+    using clanguml::common::eid_t;
+    using clanguml::common::model::memory_usage;
+    using clanguml::common::model::namespace_;
+    using clanguml::common::model::package;
+    using clanguml::common::model::relationship;
+    using clanguml::common::model::relationship_t;
+    using clanguml::common::model::source_location;
+    using clanguml::common::model::template_parameter;
+
+    {
+        memory_usage usage;
+
+        usage.add_string("short");
+        CHECK(usage.strings == 0);
+
+        usage.add_strings({"a_string_too_long_for_sso", "abc"});
+        CHECK(usage.strings == 26);
+    }
+
+    {
+        memory_usage usage;
+        namespace_ using_namespace{"ns1"};
+        package pkg{using_namespace};
+        pkg.set_name("a_package_with_a_long_name");
+        pkg.set_namespace(namespace_{"ns1::a_namespace_with_a_long_name"});
+        pkg.add_relationship(
+            relationship{relationship_t::kDependency, eid_t{uint64_t{1}}});
+
+        usage.add_element(pkg, sizeof(package));
+
+        CHECK(usage.element_count == 1);
+        CHECK(usage.elements == sizeof(package) - sizeof(source_location));
+        CHECK(usage.source_locations == sizeof(source_location));
+        CHECK(usage.relationship_count == 1);
+        CHECK(usage.relationships == sizeof(relationship));
+        CHECK(usage.strings == 27 + 29);
+        CHECK(usage.comments == 0);
+        CHECK(usage.total() ==
+            sizeof(package) + sizeof(relationship) + usage.strings);
+    }
+
+    {
+        memory_usage usage;
+        auto tp = template_parameter::make_template_type(
+            "std::unordered_map<std::string, int>");
+        tp.add_template_param(
+            template_parameter::make_argument("std::basic_string<char>"));
+        tp.add_template_param(template_parameter::make_argument("int"));
+
+        std::vector<template_parameter> params;
+        params.push_back(std::move(tp));
+        params.shrink_to_fit();
+
+        usage.add_template_params(params);
+
+        CHECK(usage.template_param_count == 3);
+        CHECK(usage.template_params >= 3 * sizeof(template_parameter));
+        CHECK(usage.strings >= 37 + 24);
+    }
+
+    {
+        using clanguml::common::model::message_t;
+        using clanguml::sequence_diagram::model::message;
+
+        memory_usage usage;
+        clanguml::sequence_diagram::model::diagram d;
+
+        message m{message_t::kCall, eid_t{uint64_t{1}}};
+        m.set_to(eid_t{uint64_t{2}});
+        m.set_message_name("a_message_name_too_long_for_sso");
+        m.condition_text("a_condition_too_long_for_sso");
+
+        // Copies of the message share the condition text
+        message m_copy{m};
+        message m_other{message_t::kCall, eid_t{uint64_t{1}}};
+        m_other.set_to(eid_t{uint64_t{3}});
+
+        d.add_message(std::move(m));
+        d.add_message(std::move(m_copy));
+        d.add_message(std::move(m_other));
+
+        d.estimate_memory_usage(usage);
+
+        CHECK(usage.message_count == 3);
+        CHECK(usage.messages ==
+            3 * (sizeof(message) - sizeof(source_location)) +
+                sizeof(message::details));
+        CHECK(usage.strings == 29);
+    }
+}
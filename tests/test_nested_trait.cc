@@ -336,6 +336,47 @@ end package
 )");
     }
 }
+
+TEST_CASE("Test nested trait remove elements")
+{
+    using clanguml::test::diagram_model_mock;
+    using clanguml::test::id;
+
+    diagram_model_mock d;
+
+    namespace_ using_namespace{};
+
+    auto p = std::make_unique<package>(using_namespace);
+    p->set_name("ns1");
+    p->set_id(id());
+    auto prel = p->path().relative_to(using_namespace);
+    REQUIRE(d.add_element(prel, std::move(p)));
+
+    auto c = std::make_unique<class_>(using_namespace);
+    c->set_name("A");
+    c->set_namespace(namespace_{"ns1"});
+    c->set_id(id());
+    const auto A_id = c->id();
+    prel = c->path().relative_to(using_namespace);
+    REQUIRE(d.add_element(prel, std::move(c)));
+
+    c = std::make_unique<class_>(using_namespace);
+    c->set_name("B");
+    c->set_namespace(namespace_{"ns1"});
+    c->set_id(id());
+    const auto B_id = c->id();
+    prel = c->path().relative_to(using_namespace);
+    REQUIRE(d.add_element(prel, std::move(c)));
+
+    const auto &ns1 = d.get_element<package>(namespace_{"ns1"}).value();
+    REQUIRE_EQ(ns1.parent_nested(), &d);
+
+    d.remove({A_id});
+
+    REQUIRE(!d.get_element(namespace_{"ns1::A"}));
+    REQUIRE_EQ(d.get_element(namespace_{"ns1::B"}).value().id(), B_id);
+    REQUIRE(!d.get_element(namespace_{"ns2::B"}));
+}
 ///
 /// Main test function
 ///
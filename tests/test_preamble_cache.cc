@@ -0,0 +1,149 @@
+/**
+ * @file tests/test_preamble_cache.cc
+ *
+ * Copyright (c) 2021-2025 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "doctest/doctest.h"
+
+#include "common/generators/preamble_cache.h"
+
+#include <clang/Frontend/FrontendActions.h>
+#include <clang/Tooling/CompilationDatabase.h>
+
+#include <filesystem>
+#include <fstream>
+
+using clanguml::generators::preamble_cache;
+using clanguml::generators::preamble_tool_action;
+
+namespace {
+void write_file(const std::filesystem::path &path, const std::string &contents)
+{
+    std::ofstream ofs{path};
+    ofs << contents;
+}
+
+bool run_syntax_only(preamble_cache &cache, const std::string &group_key,
+    const std::filesystem::path &directory,
+    const std::vector<std::string> &files)
+{
+    clang::tooling::FixedCompilationDatabase db{
+        directory.string(), {"-std=c++17"}};
+    clang::tooling::ClangTool tool{db, files};
+
+    auto factory =
+        clang::tooling::newFrontendActionFactory<clang::SyntaxOnlyAction>();
+    preamble_tool_action action{factory.get(), cache};
+    action.set_group_key(group_key);
+
+    return tool.run(&action) == 0;
+}
+} // namespace
+
+TEST_CASE("Test preamble_cache key")
+{
+    const auto key = preamble_cache::make_key("cmd", "#include \"a.h\"\n");
+
+    CHECK(key == preamble_cache::make_key("cmd", "#include \"a.h\"\n"));
+    CHECK(key != preamble_cache::make_key("cmd", "#include \"b.h\"\n"));
+    CHECK(key != preamble_cache::make_key("cmd2", "#include \"a.h\"\n"));
+
+    // Group key and preamble are separated, so that moving characters
+    // between them does not result in the same key
+    CHECK(preamble_cache::make_key("ab", "c") !=
+        preamble_cache::make_key("a", "bc"));
+}
+
+TEST_CASE("Test preamble_cache reuse")
+{
+    const auto dir = std::filesystem::temp_directory_path() /
+        "clang-uml-test-preamble-cache";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+
+    write_file(dir / "a.h", "struct A { int a; };\n");
+    write_file(dir / "b.h", "struct B { int b; };\n");
+    write_file(
+        dir / "a1.cc", "#include \"a.h\"\nint f1(A a) { return a.a; }\n");
+    write_file(
+        dir / "a2.cc", "#include \"a.h\"\nint f2(A a) { return a.a; }\n");
+    write_file(
+        dir / "b1.cc", "#include \"b.h\"\nint f3(B b) { return b.b; }\n");
+
+    preamble_cache cache;
+
+    CHECK(!cache.enabled());
+    cache.enable();
+    CHECK(cache.enabled());
+
+    SUBCASE("Translation units with the same preamble share it")
+    {
+        REQUIRE(run_syntax_only(cache, "cmd", dir,
+            {(dir / "a1.cc").string(), (dir / "a2.cc").string()}));
+
+        CHECK(cache.stats().built == 1);
+        CHECK(cache.stats().reused == 1);
+        CHECK(cache.stats().failed == 0);
+    }
+
+    SUBCASE("Translation units with different preambles do not share it")
+    {
+        REQUIRE(run_syntax_only(cache, "cmd", dir,
+            {(dir / "a1.cc").string(), (dir / "b1.cc").string()}));
+
+        CHECK(cache.stats().built == 2);
+        CHECK(cache.stats().reused == 0);
+    }
+
+    SUBCASE("Translation units from different groups do not share preamble")
+    {
+        REQUIRE(run_syntax_only(cache, "cmd", dir, {(dir / "a1.cc").string()}));
+        REQUIRE(
+            run_syntax_only(cache, "cmd2", dir, {(dir / "a2.cc").string()}));
+
+        CHECK(cache.stats().built == 2);
+        CHECK(cache.stats().reused == 0);
+    }
+
+    SUBCASE("Preamble is not reused after the header changes")
+    {
+        REQUIRE(run_syntax_only(cache, "cmd", dir, {(dir / "a1.cc").string()}));
+
+        write_file(dir / "a.h", "struct A { int a; int aa; };\n");
+
+        REQUIRE(run_syntax_only(cache, "cmd", dir, {(dir / "a2.cc").string()}));
+
+        CHECK(cache.stats().built == 1);
+        CHECK(cache.stats().reused == 0);
+    }
+
+    SUBCASE("Disabling the cache releases the preambles")
+    {
+        REQUIRE(run_syntax_only(cache, "cmd", dir, {(dir / "a1.cc").string()}));
+
+        cache.disable();
+        CHECK(!cache.enabled());
+        cache.enable();
+
+        REQUIRE(run_syntax_only(cache, "cmd", dir, {(dir / "a2.cc").string()}));
+
+        CHECK(cache.stats().built == 2);
+        CHECK(cache.stats().reused == 0);
+    }
+
+    std::filesystem::remove_all(dir);
+}
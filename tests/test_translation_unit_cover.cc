@@ -0,0 +1,94 @@
+/**
+ * @file tests/test_translation_unit_cover.cc
+ *
+ * Copyright (c) 2021-2025 Bartek Kryza <bkryza@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "doctest/doctest.h"
+
+#include "common/generators/translation_unit_cover.h"
+
+using clanguml::generators::select_covering_translation_units;
+
+TEST_CASE("Test select_covering_translation_units")
+{
+    using tus_t = std::vector<std::string>;
+
+    SUBCASE("Translation units with already covered files are skipped")
+    {
+        const tus_t tus{"a.cc", "b.cc", "c.cc"};
+
+        const std::map<std::string, std::vector<std::string>> files{
+            {"a.cc", {"a.cc", "x.h"}}, {"b.cc", {"x.h"}},
+            {"c.cc", {"c.cc", "x.h", "y.h"}}};
+
+        CHECK(select_covering_translation_units(tus, files) ==
+            tus_t{"a.cc", "c.cc"});
+    }
+
+    SUBCASE("Translation units with covered source files are always selected")
+    {
+        const tus_t tus{"a.cc", "b.cc", "c.cc"};
+
+        const std::map<std::string, std::vector<std::string>> files{
+            {"a.cc", {"a.cc", "x.h", "y.h"}}, {"b.cc", {"b.cc", "x.h"}},
+            {"c.cc", {"x.h", "y.h"}}};
+
+        CHECK(select_covering_translation_units(tus, files) ==
+            tus_t{"a.cc", "b.cc"});
+    }
+
+    SUBCASE("Translation units covering most files are selected first")
+    {
+        const tus_t tus{"a.cc", "b.cc", "c.cc"};
+
+        const std::map<std::string, std::vector<std::string>> files{
+            {"a.cc", {"x.h"}}, {"b.cc", {"y.h"}}, {"c.cc", {"x.h", "y.h"}}};
+
+        CHECK(select_covering_translation_units(tus, files) == tus_t{"c.cc"});
+    }
+
+    SUBCASE("Translation units with equal coverage are selected in order")
+    {
+        const tus_t tus{"a.cc", "b.cc", "c.cc"};
+
+        const std::map<std::string, std::vector<std::string>> files{
+            {"a.cc", {"x.h"}}, {"b.cc", {"x.h"}}, {"c.cc", {"x.h"}}};
+
+        CHECK(select_covering_translation_units(tus, files) == tus_t{"a.cc"});
+    }
+
+    SUBCASE("Translation units without covered files are skipped")
+    {
+        const tus_t tus{"a.cc", "b.cc"};
+
+        const std::map<std::string, std::vector<std::string>> files{
+            {"a.cc", {}}, {"b.cc", {"y.h"}}};
+
+        CHECK(select_covering_translation_units(tus, files) == tus_t{"b.cc"});
+    }
+
+    SUBCASE("Translation units which were not scanned are always selected")
+    {
+        const tus_t tus{"a.cc", "b.cc", "c.cc"};
+
+        const std::map<std::string, std::vector<std::string>> files{
+            {"a.cc", {"x.h"}}, {"c.cc", {"x.h"}}};
+
+        CHECK(select_covering_translation_units(tus, files) ==
+            tus_t{"a.cc", "b.cc"});
+    }
+}
@@ -17,10 +17,21 @@
  */
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 
+#include "util/flat_hash_map.h"
+#include "util/hash.h"
+#include "util/memory_budget.h"
+#include "util/regex_automaton.h"
+#include "util/trace.h"
 #include "util/util.h"
 #include <common/clang_utils.h>
 
+#include <clang/Tooling/Tooling.h>
+
+#include <algorithm>
 #include <filesystem>
+#include <fstream>
+#include <map>
+#include <regex>
 
 #include "doctest/doctest.h"
 
@@ -538,4 +549,360 @@ TEST_CASE("Test condense_whitespace")
 
     CHECK_EQ(condense_whitespace("  \t\n        "), " ");
     CHECK_EQ(condense_whitespace("A  \t\n        A"), "A A");
-}
\ No newline at end of file
+}
+
+TEST_CASE("Test interned_string")
+{
+    using clanguml::util::interned_string;
+
+    const interned_string empty;
+    CHECK(empty.empty());
+    CHECK(empty == interned_string{""});
+
+    const interned_string a1{"/a/b/c.h"};
+    const interned_string a2{std::string{"/a/b/"} + "c.h"};
+    const interned_string b{"/a/b/d.h"};
+
+    CHECK(a1 == a2);
+    CHECK(&a1.str() == &a2.str());
+    CHECK(a1 != b);
+    CHECK(a1.str() == "/a/b/c.h");
+
+    clanguml::common::model::source_location sl;
+    sl.set_file("/a/b/c.h");
+    sl.set_file_relative(b);
+    CHECK(&sl.file() == &a1.str());
+    CHECK(sl.file_relative() == "/a/b/d.h");
+    CHECK(sl.translation_unit().empty());
+}
+
+TEST_CASE("Test hash64")
+{
+    using clanguml::util::hash64;
+
+    // Reference XXH64 values
+    CHECK(hash64::of("") == 0xEF46DB3751D8E999ULL);
+    CHECK(hash64::of("a") == 0xD24EC4F1A98C6E5BULL);
+    CHECK(hash64::of("abc") == 0x44BC2CF5AD770999ULL);
+    CHECK(hash64::of("Nobody inspects the spammish repetition") ==
+        0xFBCEA83C8A378BF1ULL);
+    CHECK(hash64::of("abc", 2021) == 0x27AD5D06A328BC7CULL);
+
+    const std::string name{
+        "clanguml::common::model::diagram_element<std::vector<int>>"};
+    CHECK(hash64::of(name) == 0x0806BE6708F00045ULL);
+    CHECK(hash64::of(name, 2021) == 0x4FDD782F7460174DULL);
+
+    // Incremental hashing must give the same result for any split of input
+    for (auto i = 0U; i <= name.size(); i++) {
+        for (auto j = i; j <= name.size(); j++) {
+            hash64 h;
+            h.update(std::string_view{name}.substr(0, i))
+                .update(std::string_view{name}.substr(i, j - i))
+                .update(std::string_view{name}.substr(j));
+            REQUIRE(h.digest() == hash64::of(name));
+        }
+    }
+
+    // Path ids can be computed without rendering the path to string
+    using clanguml::common::to_id;
+    using clanguml::common::model::path;
+    using clanguml::common::model::path_type;
+
+    const path ns{"ns1::ns2::A"};
+    CHECK(to_id(ns) == to_id(ns.to_string()));
+    CHECK(to_id(path{}) == to_id(std::string{}));
+
+    const path dir{"src/common/model", path_type::kFilesystem};
+    CHECK(to_id(dir) == to_id(dir.to_string()));
+}
+
+TEST_CASE("Test flat_hash_map")
+{
+    using clanguml::util::flat_hash_map;
+
+    flat_hash_map<int64_t, std::string> m;
+    CHECK(m.empty());
+    CHECK(m.find(1) == m.end());
+    CHECK(m.erase(1) == 0);
+
+    CHECK(m.emplace(1, "one").second);
+    CHECK_FALSE(m.emplace(1, "uno").second);
+    m[2] = "two";
+    CHECK(m.size() == 2);
+    CHECK(m.at(1) == "one");
+    CHECK(m.find(2)->second == "two");
+    CHECK_THROWS_AS(m.at(3), std::out_of_range);
+
+    // Compare against std::map with interleaved insertions and removals,
+    // which exercises backward shift deletion in long probe sequences
+    flat_hash_map<int64_t, int64_t> fm;
+    std::map<int64_t, int64_t> sm;
+    uint64_t state{42};
+    for (auto i = 0; i < 20000; i++) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        const auto key = static_cast<int64_t>(state >> 52U);
+        if ((state >> 20U) % 3 == 0) {
+            REQUIRE(fm.erase(key) == sm.erase(key));
+        }
+        else {
+            fm[key] = i;
+            sm[key] = i;
+        }
+    }
+
+    REQUIRE(fm.size() == sm.size());
+    for (const auto &[k, v] : sm) {
+        REQUIRE(fm.contains(k));
+        REQUIRE(fm.at(k) == v);
+    }
+
+    std::size_t count{0};
+    for (const auto &[k, v] : fm) {
+        REQUIRE(sm.at(k) == v);
+        count++;
+    }
+    CHECK(count == sm.size());
+
+    // Clearing the map keeps the allocated table
+    const auto capacity = fm.capacity();
+    fm.clear();
+    CHECK(fm.empty());
+    CHECK(fm.capacity() == capacity);
+    CHECK(fm.begin() == fm.end());
+
+    auto moved = std::move(m);
+    CHECK(moved.size() == 2);
+    CHECK(m.empty());
+    CHECK(m.find(1) == m.end());
+}
+
+TEST_CASE("Test regex_automaton")
+{
+    using clanguml::util::regex_automaton;
+
+    const std::vector<std::string> patterns{"ns1::.*", "^ns1::(A|B)\\d+$",
+        "(a|ab)(c|bcd)(d*)", "[^a-z]+", "\\w+::\\w+", "a{2,3}b?", "(?:ab)+",
+        "[a\\]-]+", "\\x41+", "(foo|foobar)baz", ".*::detail::.*", "x|",
+        "a*?b"};
+
+    const std::vector<std::string> inputs{"", "ns1::A12", "ns1::C", "abcd",
+        "abcdd", "ABC", "foo::bar", "aa", "aaab", "abab", "a]-", "AA",
+        "foobarbaz", "foobaz", "ns::detail::impl", "ns::detail", "x", "a\nb",
+        "ns1::\n"};
+
+    // Results must be the same as of std::regex
+    for (const auto &pattern : patterns) {
+        const auto automaton = regex_automaton::compile({pattern});
+        REQUIRE(automaton);
+
+        const std::regex regex{pattern};
+        for (const auto &input : inputs) {
+            INFO(pattern, " ", input);
+            CHECK(automaton->match(input) == std::regex_match(input, regex));
+            CHECK(automaton->search(input) == std::regex_search(input, regex));
+        }
+    }
+
+    // Multiple patterns match if any of them matches
+    const auto automaton = regex_automaton::compile(patterns);
+    REQUIRE(automaton);
+    for (const auto &input : inputs) {
+        INFO(input);
+        CHECK(automaton->match(input) ==
+            std::any_of(patterns.begin(), patterns.end(),
+                [&input](const auto &p) {
+                    return std::regex_match(input, std::regex{p});
+                }));
+    }
+
+    CHECK_FALSE(regex_automaton::compile({})->match(""));
+
+    // Unsupported patterns
+    CHECK_FALSE(regex_automaton::compile({"(a)\\1"}));
+    CHECK_FALSE(regex_automaton::compile({"\\bfoo"}));
+    CHECK_FALSE(regex_automaton::compile({"a(?=b)"}));
+    CHECK_FALSE(regex_automaton::compile({"[[:alpha:]]"}));
+    CHECK_FALSE(regex_automaton::compile({"a{2000}"}));
+    CHECK_FALSE(regex_automaton::compile({"ns1::.*", "(a)\\1"}));
+
+    // Matching does not backtrack
+    const auto nested = regex_automaton::compile({"(a*)*b"});
+    CHECK_FALSE(nested->match(std::string(1000, 'a')));
+}
+
+TEST_CASE("Test memory_budget")
+{
+    using clanguml::util::memory_budget;
+
+    constexpr uint64_t kMiB{1024ULL * 1024ULL};
+
+    uint64_t rss{100 * kMiB};
+    memory_budget budget{[&rss] { return rss; }};
+
+    // All tasks are admitted without a limit
+    CHECK_FALSE(budget.enabled());
+    CHECK(budget.try_admit("a.cc").has_value());
+
+    budget.set_limit(2048 * kMiB);
+    CHECK(budget.enabled());
+
+    {
+        // The first task is always admitted, the second one is admitted
+        // only once the first one has allocated some of its memory
+        auto t1 = budget.try_admit("a.cc");
+        REQUIRE(t1.has_value());
+        rss += 200 * kMiB;
+        budget.sample();
+
+        // 300 current + (512 - 200) pending + 512 expected > 1024
+        budget.set_limit(1024 * kMiB);
+        CHECK_FALSE(budget.try_admit("b.cc").has_value());
+
+        budget.set_limit(2048 * kMiB);
+        auto t2 = budget.try_admit("b.cc");
+        CHECK(t2.has_value());
+
+        rss += 1000 * kMiB;
+        budget.sample();
+        t1->release();
+        rss -= 1000 * kMiB;
+    }
+
+    // Peak usage of completed tasks is remembered per key
+    CHECK(budget.estimate("a.cc") == 1200 * kMiB);
+    CHECK(budget.estimate("b.cc") == 1000 * kMiB);
+    CHECK(budget.estimate("c.cc") == 1050 * kMiB);
+
+    {
+        // Task which does not fit in the limit with other tasks has to wait
+        auto t1 = budget.try_admit("b.cc");
+        REQUIRE(t1.has_value());
+        CHECK_FALSE(budget.try_admit("a.cc").has_value());
+    }
+
+    // ...but it is admitted when no other task is running
+    CHECK(budget.try_admit("a.cc").has_value());
+
+#if defined(__linux__)
+    CHECK(memory_budget::resident_set_size() > 0);
+#endif
+}
+
+TEST_CASE("Test tracer")
+{
+    using clanguml::util::trace_span;
+    using clanguml::util::tracer;
+
+    auto &t = tracer::instance();
+
+    // Spans are not recorded unless the tracer is enabled
+    REQUIRE_FALSE(t.enabled());
+    {
+        const trace_span span{"diagram", "disabled"};
+    }
+    CHECK(t.to_json()["traceEvents"].empty());
+
+    const auto output_path =
+        std::filesystem::temp_directory_path() / "clanguml_test_trace.json";
+
+    // Disable the tracer at the end of the test, also if a check fails
+    struct tracer_reset {
+        ~tracer_reset() { tracer::instance().disable(); }
+    };
+    const tracer_reset reset;
+
+    t.enable(output_path.string());
+    REQUIRE(t.enabled());
+
+    {
+        const trace_span outer{"diagram", "outer", {{"diagram", "d1"}}};
+        const trace_span inner{"translation unit", "inner"};
+    }
+
+    const auto trace = t.to_json();
+    REQUIRE(trace["traceEvents"].size() == 2);
+
+    // Spans are recorded when they end
+    const auto &inner = trace["traceEvents"][0];
+    const auto &outer = trace["traceEvents"][1];
+    CHECK(inner["name"] == "inner");
+    CHECK(inner["cat"] == "translation unit");
+    CHECK(inner["ph"] == "X");
+    CHECK_FALSE(inner.contains("args"));
+    CHECK(outer["name"] == "outer");
+    CHECK(outer["args"]["diagram"] == "d1");
+    CHECK(outer["tid"] == inner["tid"]);
+    CHECK(outer["ts"] <= inner["ts"]);
+    CHECK(outer["dur"] >= inner["dur"]);
+
+    t.write();
+
+    std::ifstream ifs{output_path};
+    CHECK(nlohmann::json::parse(ifs) == trace);
+    ifs.close();
+
+    std::filesystem::remove(output_path);
+
+    t.disable();
+    CHECK_FALSE(t.enabled());
+    CHECK(t.to_json()["traceEvents"].empty());
+}
+
+TEST_CASE("Test printing_cache")
+{
+    using clanguml::common::printing_cache;
+    using clanguml::common::to_string;
+
+    auto ast = clang::tooling::buildASTFromCode(R"(
+namespace ns {
+struct A { };
+template <typename T, typename U> struct Pair { };
+using Alias = Pair<A, int>;
+typedef const Alias *AliasPtr;
+}
+ns::Alias a1;
+const ns::Alias &a2 = a1;
+ns::AliasPtr a3;
+ns::Pair<ns::A, ns::Alias> a4;
+int a5[2];
+)");
+    REQUIRE(ast);
+
+    auto &ctx = ast->getASTContext();
+
+    // Sugared types and their canonical types are both printed
+    std::vector<clang::QualType> types;
+    for (const auto *decl : ctx.getTranslationUnitDecl()->decls()) {
+        if (const auto *var = clang::dyn_cast<clang::VarDecl>(decl);
+            var != nullptr) {
+            types.push_back(var->getType());
+            types.push_back(var->getType().getCanonicalType());
+        }
+    }
+    REQUIRE(types.size() == 10);
+
+    auto print_all = [&types, &ctx]() {
+        std::vector<std::string> result;
+        for (const auto &type : types) {
+            result.push_back(to_string(type, ctx, false));
+            result.push_back(to_string(type, ctx, true));
+        }
+        return result;
+    };
+
+    const auto expected = print_all();
+
+    printing_cache cache;
+    {
+        const printing_cache::scope scope{cache, ctx};
+        REQUIRE(printing_cache::current(ctx) == &cache);
+
+        // The first pass fills the cache, the second one only reads it
+        CHECK(print_all() == expected);
+        CHECK(print_all() == expected);
+    }
+
+    CHECK(printing_cache::current(ctx) == nullptr);
+    CHECK(print_all() == expected);
+}